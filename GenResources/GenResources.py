@@ -1,16 +1,36 @@
 
 import logging as log
 import os, os.path
+import sys
+import hashlib
 import shutil
 import subprocess
+import gzip
+try:
+    import brotli
+except ImportError:
+    brotli = None
 
 # NOTE that if MINIFY_HTML is True then the Node package html-minifier needs to be installed globally
 # npm install html-minifier -g
 MINIFY_HTML = False
 
+# Compressed variants of resources - the web server sends the best one the browser accepts
+# NOTE brotli variants need the python brotli package (pip install brotli)
+GENERATE_GZIP = True
+GENERATE_BROTLI = True
+
+# Caching - browsers keep resources for this long (0 means they check with the server each
+# time which, with the ETag, costs only a 304 Not Modified response if unchanged)
+CACHE_MAX_AGE_SECS = 0
+
+# Usage: python GenResources.py [resFolder] [outputFile]
+resFolder = sys.argv[1] if len(sys.argv) > 1 else "./res"
+outFileName = sys.argv[2] if len(sys.argv) > 2 else "../src/GenResources.h"
+
 log.basicConfig(level=log.DEBUG)
 
-def writeFileContentsAsHex(filePath, outFile):
+def readFileContents(filePath):
     filename, file_extension = os.path.splitext(filePath)
     # print("File", filePath, "name", filename, "ext", file_extension)
     inFileName = filePath
@@ -31,26 +51,104 @@ def writeFileContentsAsHex(filePath, outFile):
         else:
             print("MINIFY FAILED returncode", rslt.returncode)
 
-    # Iterate through file in binary
-    chCount = 0
-    lineChIdx = 0
     with open(inFileName, "rb") as inFile:
-        byte = inFile.read(1)
-        while byte:
-            if chCount != 0:
-                outFile.write(",")
-            if lineChIdx == 0:
-                outFile.write("\n" + " " * lineHexIndentChars)
-            outFile.write("0x" + format(ord(byte), "02x"))
-            byte = inFile.read(1)
-            lineChIdx += 1
-            if lineChIdx >= lineHexBytesLen:
-                lineChIdx = 0
-            chCount += 1
+        fileData = inFile.read()
 
     if MINIFY_HTML and file_extension.upper()[:4] == ".HTM":
         print("Removing", inFileName)
         os.remove(inFileName)
+    return fileData
+
+def writeBytesAsHex(data, outFile):
+    lineChIdx = 0
+    for chCount, byte in enumerate(data):
+        if chCount != 0:
+            outFile.write(",")
+        if lineChIdx == 0:
+            outFile.write("\n" + " " * lineHexIndentChars)
+        outFile.write("0x" + format(byte, "02x"))
+        lineChIdx += 1
+        if lineChIdx >= lineHexBytesLen:
+            lineChIdx = 0
+
+# Compressed variants of the data in order of preference - a variant is only used if it is
+# smaller than the original
+def getEncodedVariants(data):
+    variants = []
+    if GENERATE_BROTLI and brotli is not None:
+        variants.append(("br", brotli.compress(data, quality=11)))
+    if GENERATE_GZIP:
+        # mtime is fixed so the output only changes when the file does
+        variants.append(("gzip", gzip.compress(data, compresslevel=9, mtime=0)))
+    return [variant for variant in variants if len(variant[1]) < len(data)]
+
+def getMimeType(fileExt):
+    mimeType = "text/plain"
+    if fileExt == ".ico":
+        mimeType = "image/ico"
+    elif fileExt == ".html":
+        mimeType = "text/html"
+    return mimeType
+
+# Precomputed response header (status line, Content-Type and Content-Length) - the web server
+# adds the CORS and connection headers and the blank line
+def writeResponseHeader(cIdent, mimeType, encoding, dataLen, outFile):
+    outFile.write("static const char " + cIdent + "_hdr[] = ")
+    outFile.write("\"HTTP/1.1 200 OK\\r\\n\"\n")
+    outFile.write(" " * lineNormalIndentChars + "\"Content-Type: " + mimeType + "\\r\\n\"\n")
+    if encoding:
+        outFile.write(" " * lineNormalIndentChars + "\"Content-Encoding: " + encoding + "\\r\\n\"\n")
+    outFile.write(" " * lineNormalIndentChars + "\"Content-Length: " + str(dataLen) + "\\r\\n\";\n\n")
+
+# ETag (a hash of the content so it differs for each encoding) and the caching headers which
+# are sent with both 200 and 304 responses
+def writeCacheHeaders(cIdent, hasVariants, data, outFile):
+    eTag = "\\\"" + hashlib.sha1(data).hexdigest()[:16] + "\\\""
+    cacheControl = "no-cache" if CACHE_MAX_AGE_SECS == 0 else "max-age=" + str(CACHE_MAX_AGE_SECS)
+    outFile.write("static const char " + cIdent + "_etag[] = \"" + eTag + "\";\n")
+    outFile.write("static const char " + cIdent + "_cache_hdr[] = ")
+    outFile.write("\"ETag: " + eTag + "\\r\\n\"\n")
+    if hasVariants:
+        outFile.write(" " * lineNormalIndentChars + "\"Vary: Accept-Encoding\\r\\n\"\n")
+    outFile.write(" " * lineNormalIndentChars + "\"Cache-Control: " + cacheControl + "\\r\\n\";\n\n")
+
+def writeResourceData(cIdent, mimeType, encoding, hasVariants, data, outFile):
+    # Write variable def
+    outFile.write("static const uint8_t " + cIdent + "[] {")
+    # Write contents as hex
+    writeBytesAsHex(data, outFile)
+    outFile.write("\n" + " " * lineHexIndentChars + "};\n\n")
+    # Write response and caching headers
+    writeResponseHeader(cIdent, mimeType, encoding, len(data), outFile)
+    writeCacheHeaders(cIdent, hasVariants, data, outFile)
+
+# Constructor arguments for headers (shared by resources and variants)
+def headerArgs(cIdent):
+    return (cIdent + "_hdr, sizeof(" + cIdent + "_hdr) - 1, " +
+            cIdent + "_cache_hdr, sizeof(" + cIdent + "_cache_hdr) - 1, " + cIdent + "_etag")
+
+# FNV-1a hash of the lowercased name starting from a seed - must match
+# RdWebServerResourceIndex::hashName
+def hashName(name, seed):
+    hashVal = 2166136261 ^ seed
+    for byte in name.lower().encode():
+        hashVal = ((hashVal ^ byte) * 16777619) & 0xffffffff
+    return hashVal
+
+# Find a seed for which each name hashes to a different slot (a perfect hash) - twice as many
+# slots as names keeps the search short
+def findPerfectHash(names):
+    numSlots = max(1, len(names) * 2)
+    for seed in range(1000000):
+        slots = [-1] * numSlots
+        for nameIdx, name in enumerate(names):
+            slotIdx = hashName(name, seed) % numSlots
+            if slots[slotIdx] >= 0:
+                break
+            slots[slotIdx] = nameIdx
+        else:
+            return seed, slots
+    raise Exception("No perfect hash found")
 
 resFileInfo = []
 lineNormalIndentChars = 4
@@ -58,12 +156,12 @@ lineHexBytesLen = 16
 lineHexIndentChars = 4
 extensionsToIgnore = []
 filenamesToIgnore = ["thumbs.db", ".DS_Store"]
-with open("../src/GenResources.h", "w") as outFile:
+with open(outFileName, "w") as outFile:
     outFile.write("// Auto-Generated file containing res folder binary contents\n")
     outFile.write("#include \"RdWebServerResources.h\"\n\n")
-    walkGen = os.walk("./res")
+    walkGen = os.walk(resFolder)
     for root,folders,fileNames in walkGen:
-        for fileName in fileNames:
+        for fileName in sorted(fileNames):
             filePath = os.path.join(root, fileName)
             # Get file parts to create variable name
             fileExtSplit = os.path.splitext(fileName)
@@ -75,17 +173,29 @@ with open("../src/GenResources.h", "w") as outFile:
                 continue
             cIdent = "reso_" + fileOnly + "_" + fileExt[1:]
             print(cIdent, fileName)
-            # Write variable def
-            outFile.write("static const uint8_t " + cIdent + "[] {")
-            # Write file contents as hex
-            writeFileContentsAsHex(filePath, outFile)
-            outFile.write("\n" + " " * lineHexIndentChars + "};\n\n")
+            mimeType = getMimeType(fileExt)
+            fileData = readFileContents(filePath)
+            variants = getEncodedVariants(fileData)
+            # Write file contents and header
+            writeResourceData(cIdent, mimeType, None, len(variants) > 0, fileData, outFile)
+            # Write the variants and a list of them
+            for encoding, encData in variants:
+                print(cIdent, encoding, len(fileData), "->", len(encData), "bytes")
+                writeResourceData(cIdent + "_" + encoding, mimeType, encoding, True, encData, outFile)
+            if len(variants) > 0:
+                outFile.write("static const RdWebServerResourceVariant " + cIdent + "_variants[] = {\n")
+                outFile.write(",\n".join(" " * lineNormalIndentChars + "RdWebServerResourceVariant(\"" + encoding + "\", " +
+                            cIdent + "_" + encoding + ", sizeof(" + cIdent + "_" + encoding + "), " +
+                            headerArgs(cIdent + "_" + encoding) + ")"
+                            for encoding, encData in variants))
+                outFile.write("\n" + " " * lineNormalIndentChars + "};\n\n")
             # Form the file info to be added to resources
             fileInfoRec = {
                 "fileName": fileName,
                 "filePath": filePath,
                 "fileExt": fileExt,
-                "fileCIdent": cIdent
+                "fileCIdent": cIdent,
+                "numVariants": len(variants)
             }
             resFileInfo.append(fileInfoRec)
 
@@ -94,11 +204,7 @@ with open("../src/GenResources.h", "w") as outFile:
     outFile.write("// Resource descriptions\n")
     outFile.write("static RdWebServerResourceDescr genResources[] = {\n")
     for fileInf in resFileInfo:
-        mimeType = "text/plain"
-        if fileInf["fileExt"] == ".ico":
-            mimeType = "image/ico"
-        elif fileInf["fileExt"] == ".html":
-            mimeType = "text/html"
+        mimeType = getMimeType(fileInf["fileExt"])
         if not isFirstLine:
             outFile.write(",\n")
         isFirstLine = False
@@ -106,8 +212,23 @@ with open("../src/GenResources.h", "w") as outFile:
         outFile.write("\"" + fileInf["fileName"] + "\", ")
         outFile.write("\"" + mimeType + "\", ")
         outFile.write(fileInf["fileCIdent"] + ", ")
-        outFile.write("sizeof(" + fileInf["fileCIdent"] + "))")
+        outFile.write("sizeof(" + fileInf["fileCIdent"] + "), ")
+        outFile.write(headerArgs(fileInf["fileCIdent"]) + ", ")
+        if fileInf["numVariants"] > 0:
+            outFile.write(fileInf["fileCIdent"] + "_variants, " + str(fileInf["numVariants"]))
+        else:
+            outFile.write("NULL, 0")
+        outFile.write(")")
     outFile.write("\n" + " " * lineNormalIndentChars + "};\n\n")
 
     # Write the sixe of the resource list
     outFile.write("static int genResourcesCount = sizeof(genResources) / sizeof(RdWebServerResourceDescr);\n\n");
+
+    # Perfect hash index of the resources
+    seed, slots = findPerfectHash([fileInf["fileName"] for fileInf in resFileInfo])
+    outFile.write("// Resource index (perfect hash of lowercased names)\n")
+    outFile.write("static const int16_t genResourcesIndexSlots[] = {\n")
+    outFile.write(" " * lineNormalIndentChars + ", ".join(str(slot) for slot in slots))
+    outFile.write("\n" + " " * lineNormalIndentChars + "};\n\n")
+    outFile.write("static const RdWebServerResourceIndex genResourcesIndex(" + str(seed) + "UL, " +
+                  str(len(slots)) + ", genResourcesIndexSlots);\n\n")
@@ -0,0 +1,89 @@
+// Posix_DocumentBenchmark
+// Rob Dobson 2017
+
+// Compares extracting N fields from a JSON object with the static RdJson methods (which
+// parse the JSON for every field), with an RdJsonDocument (parsed once) and with views from
+// the document (which aren't copied)
+// Build on a host from the lib/RdJson folder with:
+//   g++ -std=c++11 -O2 -DRDWEBSERVER_POSIX -Isrc -I../RdWebServer/src src/*.cpp
+//       ../RdWebServer/src/RdPosixWiring.cpp
+//       examples/Posix_DocumentBenchmark/Posix_DocumentBenchmark.cpp -o Posix_DocumentBenchmark
+// Run with:
+//   ./Posix_DocumentBenchmark [iterations]
+
+#include <time.h>
+#include "RdJsonDocument.h"
+
+static double nowUs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+int main(int argc, char *argv[])
+{
+    int iterations = (argc > 1) ? atoi(argv[1]) : 2000;
+    static const int fieldCounts[] = { 2, 4, 16, 64 };
+
+    printf("%8s %14s %14s %14s %8s\n", "fields", "RdJson us", "document us", "views us", "speedup");
+    for (unsigned int countIdx = 0; countIdx < sizeof(fieldCounts) / sizeof(fieldCounts[0]); countIdx++)
+    {
+        // Object with alternating string and number fields
+        int numFields = fieldCounts[countIdx];
+        String jsonStr = "{";
+        for (int i = 0; i < numFields; i++)
+        {
+            if (i % 2)
+                jsonStr += String::format("%s\"f%d\":%d", i ? "," : "", i, i * 1000);
+            else
+                jsonStr += String::format("%s\"f%d\":\"value %d\"", i ? "," : "", i, i);
+        }
+        jsonStr += "}";
+        char fieldNames[64][12];
+        for (int i = 0; i < numFields; i++)
+            snprintf(fieldNames[i], sizeof(fieldNames[i]), "f%d", i);
+
+        // Parse for every field
+        unsigned long checkStatic = 0;
+        double startUs = nowUs();
+        for (int iter = 0; iter < iterations; iter++)
+        {
+            for (int i = 0; i < numFields; i++)
+                checkStatic += RdJson::getString(fieldNames[i], "", jsonStr.c_str()).length();
+        }
+        double staticUs = (nowUs() - startUs) / iterations;
+
+        // Parse once - the document (and its arena) is reused as it would be by a server
+        RdJsonDocument doc;
+        unsigned long checkDoc = 0;
+        startUs = nowUs();
+        for (int iter = 0; iter < iterations; iter++)
+        {
+            doc.parse(jsonStr.c_str());
+            for (int i = 0; i < numFields; i++)
+                checkDoc += doc.getString(fieldNames[i], "").length();
+        }
+        double docUs = (nowUs() - startUs) / iterations;
+
+        // Views into the JSON
+        unsigned long checkView = 0;
+        startUs = nowUs();
+        for (int iter = 0; iter < iterations; iter++)
+        {
+            doc.parse(jsonStr.c_str());
+            for (int i = 0; i < numFields; i++)
+            {
+                const char* pStr = NULL;
+                int strLen = 0;
+                if (doc.getView(fieldNames[i], pStr, strLen))
+                    checkView += strLen;
+            }
+        }
+        double viewUs = (nowUs() - startUs) / iterations;
+
+        printf("%8d %14.2f %14.2f %14.2f %7.1fx%s\n", numFields, staticUs, docUs, viewUs, staticUs / viewUs,
+               (checkStatic == checkDoc) && (checkDoc == checkView) ? "" : " RESULTS DIFFER");
+    }
+    return 0;
+}
@@ -0,0 +1,99 @@
+// Posix_ParseBenchmark
+// Rob Dobson 2017
+
+// Times the jsmn parse of large documents - with parent links (the default) time per token
+// should stay the same as documents get bigger - build again with -DJSMNR_NO_PARENT_LINKS to
+// compare with scanning back over the tokens for each closing bracket and comma
+// Build on a host from the lib/RdJson folder with:
+//   g++ -std=c++11 -O2 -DRDWEBSERVER_POSIX -Isrc -I../RdWebServer/src src/*.cpp
+//       ../RdWebServer/src/RdPosixWiring.cpp
+//       examples/Posix_ParseBenchmark/Posix_ParseBenchmark.cpp -o Posix_ParseBenchmark
+// Run with:
+//   ./Posix_ParseBenchmark [maxElems]
+
+#include <time.h>
+#include <string>
+#include "jsmnParticleR.h"
+
+static double nowUs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+// Documents with numElems elements
+static std::string formWideObject(int numElems)
+{
+    std::string json = "{";
+    char elemStr[40];
+    for (int i = 0; i < numElems; i++)
+    {
+        snprintf(elemStr, sizeof(elemStr), "%s\"key%d\":%d", i ? "," : "", i, i);
+        json += elemStr;
+    }
+    return json + "}";
+}
+
+static std::string formArrayOfObjects(int numElems)
+{
+    std::string json = "[";
+    char elemStr[40];
+    for (int i = 0; i < numElems; i++)
+    {
+        snprintf(elemStr, sizeof(elemStr), "%s{\"id\":%d,\"on\":true}", i ? "," : "", i);
+        json += elemStr;
+    }
+    return json + "]";
+}
+
+static std::string formDeepArrays(int numElems)
+{
+    std::string json;
+    for (int i = 0; i < numElems; i++)
+        json += "[1,";
+    json += "0";
+    for (int i = 0; i < numElems; i++)
+        json += "]";
+    return json;
+}
+
+static void timeParse(const char *pName, const std::string& json)
+{
+    // Count the tokens then time parsing into an array of that size
+    JSMNR_parser parser;
+    JSMNR_init(&parser);
+    int numTokens = JSMNR_parse(&parser, json.c_str(), json.length(), NULL, 0);
+    jsmnrtok_t *pTokens = new jsmnrtok_t[numTokens];
+    int iterations = 0;
+    int rslt = 0;
+    double startUs = nowUs();
+    double elapsedUs = 0;
+    while ((iterations < 3) || (elapsedUs < 200000))
+    {
+        JSMNR_init(&parser);
+        rslt = JSMNR_parse(&parser, json.c_str(), json.length(), pTokens, numTokens);
+        iterations++;
+        elapsedUs = nowUs() - startUs;
+    }
+    delete[] pTokens;
+    printf("%-18s %8d tokens %12.1f us %8.1f ns/token%s\n", pName, numTokens, elapsedUs / iterations,
+           elapsedUs * 1000 / iterations / numTokens, rslt == numTokens ? "" : " PARSE FAILED");
+}
+
+int main(int argc, char *argv[])
+{
+    int maxElems = (argc > 1) ? atoi(argv[1]) : 16000;
+#ifdef JSMNR_PARENT_LINKS
+    printf("Parent links\n");
+#else
+    printf("No parent links\n");
+#endif
+    for (int numElems = 1000; numElems <= maxElems; numElems *= 4)
+    {
+        timeParse("wide object", formWideObject(numElems));
+        timeParse("array of objects", formArrayOfObjects(numElems));
+        timeParse("deep arrays", formDeepArrays(numElems));
+    }
+    return 0;
+}
@@ -0,0 +1,76 @@
+// Posix_PathBenchmark
+// Rob Dobson 2017
+
+// Times looking up a path (patterns/foo/steps[42]) in a parsed document as the values
+// before it get bigger - with next sibling links (the default) each value is skipped in a
+// single step - build again with -DJSMNR_NO_NEXT_SIBLING_LINKS to compare with walking them
+// Build on a host from the lib/RdJson folder with:
+//   g++ -std=c++11 -O2 -DRDWEBSERVER_POSIX -Isrc -I../RdWebServer/src src/*.cpp
+//       ../RdWebServer/src/RdPosixWiring.cpp
+//       examples/Posix_PathBenchmark/Posix_PathBenchmark.cpp -o Posix_PathBenchmark
+// Run with:
+//   ./Posix_PathBenchmark
+
+#include <time.h>
+#include <string>
+#include "RdJsonDocument.h"
+
+static double nowUs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+// Object of patterns (the last being foo) each with an array of steps
+static std::string formPatterns(int numPatterns, int stepsPerPattern)
+{
+    std::string json = "{\"patterns\":{";
+    char elemStr[60];
+    for (int patIdx = 0; patIdx < numPatterns; patIdx++)
+    {
+        if (patIdx + 1 < numPatterns)
+            snprintf(elemStr, sizeof(elemStr), "%s\"p%d\":{\"steps\":[", patIdx ? "," : "", patIdx);
+        else
+            snprintf(elemStr, sizeof(elemStr), "%s\"foo\":{\"steps\":[", patIdx ? "," : "");
+        json += elemStr;
+        for (int stepIdx = 0; stepIdx < stepsPerPattern; stepIdx++)
+        {
+            snprintf(elemStr, sizeof(elemStr), "%s{\"x\":%d,\"y\":%d}", stepIdx ? "," : "", stepIdx, patIdx);
+            json += elemStr;
+        }
+        json += "]}";
+    }
+    return json + "}}";
+}
+
+int main(int argc, char *argv[])
+{
+#ifdef JSMNR_NEXT_SIBLING_LINKS
+    printf("Next sibling links\n");
+#else
+    printf("No next sibling links\n");
+#endif
+    for (int numPatterns = 4; numPatterns <= 256; numPatterns *= 4)
+    {
+        std::string json = formPatterns(numPatterns, 100);
+        RdJsonDocument doc(1000000);
+        doc.parse(json.c_str());
+
+        int startPos = 0, strLen = 0, objSize = 0;
+        jsmnrtype_t objType = JSMNR_UNDEFINED;
+        bool found = false;
+        int iterations = 0;
+        double startUs = nowUs();
+        double elapsedUs = 0;
+        while ((iterations < 10) || (elapsedUs < 200000))
+        {
+            found = doc.getElement("patterns/foo/steps[42]", startPos, strLen, objType, objSize);
+            iterations++;
+            elapsedUs = nowUs() - startUs;
+        }
+        printf("%4d patterns %8d tokens %10.2f us per lookup %s\n", numPatterns, doc.getNumTokens(),
+               elapsedUs / iterations, found ? std::string(json, startPos, strLen).c_str() : "NOT FOUND");
+    }
+    return 0;
+}
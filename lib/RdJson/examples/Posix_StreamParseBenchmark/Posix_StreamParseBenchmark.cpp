@@ -0,0 +1,101 @@
+// Posix_StreamParseBenchmark
+// Rob Dobson 2017
+
+// Parses a large patterns/sequences config (as posted to a web server) in parts of the size
+// a request body is received in with RdJsonStreamParser - and as a whole with an
+// RdJsonDocument - and compares the memory each needs and the time taken
+// Build on a host from the lib/RdJson folder with:
+//   g++ -std=c++11 -O2 -DRDWEBSERVER_POSIX -Isrc -I../RdWebServer/src src/*.cpp
+//       ../RdWebServer/src/RdPosixWiring.cpp
+//       examples/Posix_StreamParseBenchmark/Posix_StreamParseBenchmark.cpp -o Posix_StreamParseBenchmark
+// Run with:
+//   ./Posix_StreamParseBenchmark [numPatterns] [partLen]
+
+#include <time.h>
+#include <string>
+#include "RdJsonDocument.h"
+#include "RdJsonStreamParser.h"
+
+static double nowUs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+// Config with patterns of 40 steps and sequences of 20 patterns
+static std::string formConfig(int numPatterns)
+{
+    std::string json = "{\"maxCfgLen\":2000,\"name\":\"Sand Table\",\"patterns\":{";
+    char elemStr[80];
+    for (int patIdx = 0; patIdx < numPatterns; patIdx++)
+    {
+        snprintf(elemStr, sizeof(elemStr), "%s\"pat%d\":{\"setup\":\"angle=0;rad=%d\",\"steps\":[",
+                 patIdx ? "," : "", patIdx, patIdx);
+        json += elemStr;
+        for (int stepIdx = 0; stepIdx < 40; stepIdx++)
+        {
+            snprintf(elemStr, sizeof(elemStr), "%s{\"x\":%d,\"y\":%d.5}", stepIdx ? "," : "", stepIdx, -stepIdx);
+            json += elemStr;
+        }
+        json += "]}";
+    }
+    json += "},\"sequences\":{";
+    for (int seqIdx = 0; seqIdx < numPatterns / 10; seqIdx++)
+    {
+        snprintf(elemStr, sizeof(elemStr), "%s\"seq%d\":{\"list\":[", seqIdx ? "," : "", seqIdx);
+        json += elemStr;
+        for (int i = 0; i < 20; i++)
+        {
+            snprintf(elemStr, sizeof(elemStr), "%s\"pat%d\"", i ? "," : "", (seqIdx + i) % numPatterns);
+            json += elemStr;
+        }
+        json += "]}";
+    }
+    return json + "},\"startup\":\"\"}";
+}
+
+int main(int argc, char *argv[])
+{
+    int numPatterns = (argc > 1) ? atoi(argv[1]) : 2000;
+    int partLen = (argc > 2) ? atoi(argv[2]) : 500;
+    std::string json = formConfig(numPatterns);
+
+    // Streamed in parts - the values of each pattern's steps are summed as they arrive
+    RdJsonStreamParser parser;
+    unsigned long numValues = 0;
+    double stepsSum = 0;
+    parser.setCallback([&](RdJsonStreamParser::Event event, const char* pPath, jsmnrtype_t type,
+                           const char* pValue, int valueLen) {
+        if (event == RdJsonStreamParser::EVENT_VALUE)
+        {
+            numValues++;
+            if ((type == JSMNR_PRIMITIVE) && (strncmp(pPath, "patterns/", 9) == 0))
+                stepsSum += strtod(pValue, NULL);
+        }
+        return true;
+    });
+    double startUs = nowUs();
+    bool streamOk = true;
+    for (size_t pos = 0; streamOk && (pos < json.length()); pos += partLen)
+    {
+        int len = (json.length() - pos < (size_t)partLen) ? json.length() - pos : partLen;
+        streamOk = parser.feed(json.c_str() + pos, len);
+    }
+    streamOk = streamOk && parser.finish();
+    double streamUs = nowUs() - startUs;
+
+    // Whole document
+    RdJsonDocument doc(10000000);
+    startUs = nowUs();
+    bool docOk = doc.parse(json.c_str());
+    double docUs = nowUs() - startUs;
+
+    printf("Config %u bytes, %lu values, steps sum %.1f\n", (unsigned)json.length(), numValues, stepsSum);
+    printf("%-10s %10s %14s %12s\n", "", "ok", "memory bytes", "MB/s");
+    printf("%-10s %10d %14u %12.1f\n", "stream", streamOk, (unsigned)(sizeof(parser) + partLen),
+           json.length() / streamUs);
+    printf("%-10s %10d %14u %12.1f\n", "document", docOk,
+           (unsigned)(json.length() + 1 + doc.getNumTokens() * sizeof(jsmnrtok_t)), json.length() / docUs);
+    return 0;
+}
@@ -16,9 +16,9 @@ static int RdJson::recreateJson(const char* js, jsmnrtok_t* t,
         return 0;
     }
     if (t->type == JSMNR_PRIMITIVE) {
-        Log.trace("#Found primitive size %d, start %d, end %d",
+        RDJSON_LOG_TRACE("#Found primitive size %d, start %d, end %d",
             t->size, t->start, t->end);
-        Log.trace("%.*s", t->end - t->start, js + t->start);
+        RDJSON_LOG_TRACE("%.*s", t->end - t->start, js + t->start);
         char* pStr = safeStringDup(js + t->start,
             t->end - t->start);
         outStr.concat(pStr);
@@ -26,9 +26,9 @@ static int RdJson::recreateJson(const char* js, jsmnrtok_t* t,
         return 1;
     }
     else if (t->type == JSMNR_STRING) {
-        Log.trace("#Found string size %d, start %d, end %d",
+        RDJSON_LOG_TRACE("#Found string size %d, start %d, end %d",
             t->size, t->start, t->end);
-        Log.trace("'%.*s'", t->end - t->start, js + t->start);
+        RDJSON_LOG_TRACE("'%.*s'", t->end - t->start, js + t->start);
         char* pStr = safeStringDup(js + t->start,
             t->end - t->start);
         outStr.concat("\"");
@@ -38,19 +38,19 @@ static int RdJson::recreateJson(const char* js, jsmnrtok_t* t,
         return 1;
     }
     else if (t->type == JSMNR_OBJECT) {
-        Log.trace("#Found object size %d, start %d, end %d",
+        RDJSON_LOG_TRACE("#Found object size %d, start %d, end %d",
             t->size, t->start, t->end);
         j = 0;
         outStr.concat("{");
         for (i = 0; i < t->size; i++) {
             for (k = 0; k < indent; k++) {
-                Log.trace("  ");
+                RDJSON_LOG_TRACE("  ");
             }
             j += recreateJson(js, t + 1 + j, count - j, indent + 1, outStr);
             outStr.concat(":");
-            Log.trace(": ");
+            RDJSON_LOG_TRACE(": ");
             j += recreateJson(js, t + 1 + j, count - j, indent + 1, outStr);
-            Log.trace("");
+            RDJSON_LOG_TRACE("");
             if (i != t->size - 1) {
                 outStr.concat(",");
             }
@@ -59,21 +59,21 @@ static int RdJson::recreateJson(const char* js, jsmnrtok_t* t,
         return j + 1;
     }
     else if (t->type == JSMNR_ARRAY) {
-        Log.trace("#Found array size %d, start %d, end %d",
+        RDJSON_LOG_TRACE("#Found array size %d, start %d, end %d",
             t->size, t->start, t->end);
         j = 0;
         outStr.concat("[");
-        Log.trace("");
+        RDJSON_LOG_TRACE("");
         for (i = 0; i < t->size; i++) {
             for (k = 0; k < indent - 1; k++) {
-                Log.trace("  ");
+                RDJSON_LOG_TRACE("  ");
             }
-            Log.trace("   - ");
+            RDJSON_LOG_TRACE("   - ");
             j += recreateJson(js, t + 1 + j, count - j, indent + 1, outStr);
             if (i != t->size - 1) {
                 outStr.concat(",");
             }
-            Log.trace("");
+            RDJSON_LOG_TRACE("");
         }
         outStr.concat("]");
         return j + 1;
@@ -88,7 +88,7 @@ static bool RdJson::doPrint(const char* jsonStr)
     int tokenCountRslt = JSMNR_parse(&parser, jsonStr, strlen(jsonStr),
         NULL, 1000);
     if (tokenCountRslt < 0) {
-        Log.info("JSON parse result: %d", tokenCountRslt);
+        RDJSON_LOG_INFO("JSON parse result: %d", tokenCountRslt);
         return false;
     }
     jsmnrtok_t* pTokens = new jsmnrtok_t[tokenCountRslt];
@@ -96,17 +96,17 @@ static bool RdJson::doPrint(const char* jsonStr)
     tokenCountRslt = JSMNR_parse(&parser, jsonStr, strlen(jsonStr),
         pTokens, tokenCountRslt);
     if (tokenCountRslt < 0) {
-        Log.info("JSON parse result: %d", tokenCountRslt);
+        RDJSON_LOG_INFO("JSON parse result: %d", tokenCountRslt);
         delete pTokens;
         return false;
     }
     // Top level item must be an object
     if (tokenCountRslt < 1 || pTokens[0].type != JSMNR_OBJECT) {
-        Log.error("JSON must have top level object");
+        RDJSON_LOG_ERROR("JSON must have top level object");
         delete pTokens;
         return false;
     }
-    Log.trace("Dumping");
+    RDJSON_LOG_TRACE("Dumping");
     recreateJson(jsonStr, pTokens, parser.toknext, 0);
     delete pTokens;
     return true;
@@ -6,7 +6,6 @@
 // / is a separator of nodes
 
 #pragma once
-#include "Particle.h"
 #include "jsmnParticleR.h"
 
 // Define this to enable reformatting of JSON
@@ -61,7 +60,14 @@ public:
         if (!isValid)
             return defaultValue;
 
-        // Extract string
+        return getElementString(pSourceStr, startPos, strLen, objType, objSize);
+    }
+
+    // Extract the string for an element found in the JSON
+    static String getElementString(const char* pSourceStr,
+        int startPos, int strLen,
+        jsmnrtype_t objType, int& objSize)
+    {
         String outStr;
         char* pStr = safeStringDup(pSourceStr + startPos, strLen,
                     !(objType == JSMNR_STRING || objType == JSMNR_PRIMITIVE));
@@ -176,7 +182,7 @@ public:
     {
         // Check for null source string
         if (jsonStr == NULL) {
-            Log.error("RdJson: Source JSON is NULL");
+            RDJSON_LOG_ERROR("RdJson: Source JSON is NULL");
             return NULL;
         }
 
@@ -186,7 +192,7 @@ public:
         int tokenCountRslt = JSMNR_parse(&parser, jsonStr, strlen(jsonStr),
             NULL, maxTokens);
         if (tokenCountRslt < 0) {
-            Log.trace("RdJson: parseJson result %d maxTokens %d jsonLen %d", tokenCountRslt, maxTokens, strlen(jsonStr));
+            RDJSON_LOG_TRACE("RdJson: parseJson result %d maxTokens %d jsonLen %d", tokenCountRslt, maxTokens, (int)strlen(jsonStr));
             JSMNR_logLongStr("RdJson: jsonStr", jsonStr);
             return NULL;
         }
@@ -201,8 +207,8 @@ public:
         tokenCountRslt = JSMNR_parse(&parser, jsonStr, strlen(jsonStr),
             pTokens, tokenCountRslt);
         if (tokenCountRslt < 0) {
-            Log.info("parseJson result: %d", tokenCountRslt);
-            Log.trace("jsonStr %s numTok %d maxTok %d", jsonStr, numTokens, maxTokens);
+            RDJSON_LOG_INFO("parseJson result: %d", tokenCountRslt);
+            RDJSON_LOG_TRACE("jsonStr %s numTok %d maxTok %d", jsonStr, numTokens, maxTokens);
             delete[] pTokens;
             return NULL;
         }
@@ -226,7 +232,93 @@ public:
         strToUnEsc.replace("\\n", "\n");
     }
 
+    // Unescape a JSON string (e.g. the text between the quotes found with
+    // RdJsonDocument::getView) into a buffer - returns the length (the buffer is null
+    // terminated) or -1 if the buffer is too small or an escape is invalid
+    static int unescapeToBuf(const char* pSrc, int srcLen, char* pDest, int destSize)
+    {
+        int destPos = 0;
+        for (int srcPos = 0; srcPos < srcLen; srcPos++) {
+            char ch = pSrc[srcPos];
+            if (ch == '\\') {
+                if (++srcPos >= srcLen)
+                    return -1;
+                switch (pSrc[srcPos]) {
+                case '"': ch = '"'; break;
+                case '\\': ch = '\\'; break;
+                case '/': ch = '/'; break;
+                case 'b': ch = '\b'; break;
+                case 'f': ch = '\f'; break;
+                case 'n': ch = '\n'; break;
+                case 'r': ch = '\r'; break;
+                case 't': ch = '\t'; break;
+                case 'u': {
+                    // Code point written as UTF-8 - a surrogate pair is combined
+                    long codePoint = getHexEscape(pSrc, srcLen, srcPos + 1);
+                    if (codePoint < 0)
+                        return -1;
+                    srcPos += 4;
+                    if ((codePoint >= 0xd800) && (codePoint < 0xdc00) && (srcPos + 2 < srcLen) &&
+                            (pSrc[srcPos + 1] == '\\') && (pSrc[srcPos + 2] == 'u')) {
+                        long lowSurrogate = getHexEscape(pSrc, srcLen, srcPos + 3);
+                        if ((lowSurrogate >= 0xdc00) && (lowSurrogate < 0xe000)) {
+                            codePoint = 0x10000 + ((codePoint - 0xd800) << 10) + (lowSurrogate - 0xdc00);
+                            srcPos += 6;
+                        }
+                    }
+                    int utf8Len = (codePoint < 0x80) ? 1 : (codePoint < 0x800) ? 2 : (codePoint < 0x10000) ? 3 : 4;
+                    if (destPos + utf8Len >= destSize)
+                        return -1;
+                    if (utf8Len == 1) {
+                        pDest[destPos++] = (char)codePoint;
+                    }
+                    else {
+                        static const uint8_t firstByteMarks[] = { 0, 0, 0xc0, 0xe0, 0xf0 };
+                        for (int i = utf8Len - 1; i > 0; i--) {
+                            pDest[destPos + i] = (char)(0x80 | (codePoint & 0x3f));
+                            codePoint >>= 6;
+                        }
+                        pDest[destPos] = (char)(firstByteMarks[utf8Len] | codePoint);
+                        destPos += utf8Len;
+                    }
+                    continue;
+                }
+                default:
+                    return -1;
+                }
+            }
+            if (destPos + 1 >= destSize)
+                return -1;
+            pDest[destPos++] = ch;
+        }
+        if (destSize <= 0)
+            return -1;
+        pDest[destPos] = 0;
+        return destPos;
+    }
+
 private:
+    // Value of the 4 hex digits at pos or -1 if invalid
+    static long getHexEscape(const char* pSrc, int srcLen, int pos)
+    {
+        if (pos + 4 > srcLen)
+            return -1;
+        long val = 0;
+        for (int i = 0; i < 4; i++) {
+            char ch = pSrc[pos + i];
+            int digit = (ch >= '0' && ch <= '9') ? ch - '0' :
+                        (ch >= 'a' && ch <= 'f') ? ch - 'a' + 10 :
+                        (ch >= 'A' && ch <= 'F') ? ch - 'A' + 10 : -1;
+            if (digit < 0)
+                return -1;
+            val = (val << 4) | digit;
+        }
+        return val;
+    }
+
+    // Documents search their own tokens
+    friend class RdJsonDocument;
+
     static bool getTokenByDataPath(const char* jsonStr, const char* dataPath,
         jsmnrtok_t* pTokens, int numTokens,
         int& startTokenIdx, int& endTokenIdx)
@@ -235,7 +327,7 @@ private:
         int keyIdx = findKeyInJson(jsonStr, pTokens, numTokens,
             dataPath, endTokenIdx);
         if (keyIdx < 0) {
-            //Log.info("getTokenByDataPath not found %s", dataPath);
+            //RDJSON_LOG_INFO("getTokenByDataPath not found %s", dataPath);
             return false;
         }
 
@@ -248,7 +340,7 @@ private:
         unsigned int numTokens, int curTokenIdx,
         int count, bool atObjectKey = true)
     {
-        // Log.trace("findObjectEnd idx %d, count %d, start %s", curTokenIdx, count,
+        // RDJSON_LOG_TRACE("findObjectEnd idx %d, count %d, start %s", curTokenIdx, count,
         //                 jsonOriginal + tokens[curTokenIdx].start);
         // Primitives have a size of 0 but we still need to skip over them ...
         unsigned int tokIdx = curTokenIdx;
@@ -257,14 +349,25 @@ private:
             if (pTok->type == JSMNR_ARRAY)
                 return tokIdx + 1;
         }
+#ifdef JSMNR_NEXT_SIBLING_LINKS
+        // Each token has the index of the token after its subtree (for a key this includes
+        // its value) so skipping an object is a single step
+        for (int objIdx = 0; objIdx < count; objIdx++) {
+            tokIdx = tokens[tokIdx].next;
+            if (tokIdx >= numTokens) {
+                break;
+            }
+        }
+        return tokIdx;
+#else
         for (int objIdx = 0; objIdx < count; objIdx++) {
             jsmnrtok_t* pTok = tokens + tokIdx;
             if (pTok->type == JSMNR_PRIMITIVE) {
-                // Log.trace("findObjectEnd PRIMITIVE");
+                // RDJSON_LOG_TRACE("findObjectEnd PRIMITIVE");
                 tokIdx += 1;
             }
             else if (pTok->type == JSMNR_STRING) {
-                // Log.trace("findObjectEnd STRING");
+                // RDJSON_LOG_TRACE("findObjectEnd STRING");
                 if (atObjectKey) {
                     tokIdx = findObjectEnd(jsonOriginal, tokens, numTokens, tokIdx + 1, 1, false);
                 }
@@ -273,25 +376,26 @@ private:
                 }
             }
             else if (pTok->type == JSMNR_OBJECT) {
-                // Log.trace("findObjectEnd OBJECT");
+                // RDJSON_LOG_TRACE("findObjectEnd OBJECT");
                 tokIdx = findObjectEnd(jsonOriginal, tokens, numTokens, tokIdx + 1, pTok->size, true);
             }
             else if (pTok->type == JSMNR_ARRAY) {
-                // Log.trace("findObjectEnd ARRAY");
+                // RDJSON_LOG_TRACE("findObjectEnd ARRAY");
                 tokIdx = findObjectEnd(jsonOriginal, tokens, numTokens, tokIdx + 1, pTok->size, false);
             }
             else {
-                Log.trace("findObjectEnd UNKNOWN!!!!!!! %d", pTok->type);
+                RDJSON_LOG_TRACE("findObjectEnd UNKNOWN!!!!!!! %d", pTok->type);
                 tokIdx += 1;
             }
             if (tokIdx >= numTokens) {
                 break;
             }
         }
-        // Log.trace("findObjectEnd returning %d, start %s, end %s", tokIdx,
+        // RDJSON_LOG_TRACE("findObjectEnd returning %d, start %s, end %s", tokIdx,
         //                 jsonOriginal + tokens[tokIdx].start,
         //             jsonOriginal + tokens[tokIdx].end);
         return tokIdx;
+#endif
     }
 
     static int findKeyInJson(const char* jsonOriginal, jsmnrtok_t tokens[],
@@ -324,7 +428,7 @@ private:
                 safeStringCopy(srchKey, pDataPathPos, slashPos - pDataPathPos);
                 pDataPathPos = slashPos + 1;
             }
-            // Log.trace("SlashPos %ld, %ld, srchKey <%s>", slashPos, slashPos-pDataPathPos, srchKey);
+            // RDJSON_LOG_TRACE("SlashPos %ld, %ld, srchKey <%s>", slashPos, slashPos-pDataPathPos, srchKey);
 
             // See if search key contains an array reference
             bool arrayElementReqd = false;
@@ -341,23 +445,24 @@ private:
                 *sqBracketPos = 0;
             }
 
-            // Log.trace("findKeyInJson srchKey %s arrayIdx %ld", srchKey, reqdArrayIdx);
+            // RDJSON_LOG_TRACE("findKeyInJson srchKey %s arrayIdx %ld", srchKey, reqdArrayIdx);
 
             // Iterate over tokens to find key of the right type
             // If we are already looking at the node level then search for requested type
             // Otherwise search for and object that will contain the next level key
             jsmnrtype_t keyTypeToFind = atNodeLevel ? keyType : JSMNR_STRING;
+            int srchKeyLen = strlen(srchKey);
             for (int tokIdx = curTokenIdx; tokIdx <= maxTokenIdx;) {
                 // See if the key matches - this can either be a string match on an object key or
                 // just an array element match (with an empty key)
                 jsmnrtok_t* pTok = tokens + tokIdx;
                 bool keyMatchFound = false;
-                // Log.trace("Token type %d", pTok->type);
-                if ((pTok->type == JSMNR_STRING) && ((int)strlen(srchKey) == pTok->end - pTok->start) && (strncmp(jsonOriginal + pTok->start, srchKey, pTok->end - pTok->start) == 0)) {
+                // RDJSON_LOG_TRACE("Token type %d", pTok->type);
+                if ((pTok->type == JSMNR_STRING) && (srchKeyLen == pTok->end - pTok->start) && (strncmp(jsonOriginal + pTok->start, srchKey, pTok->end - pTok->start) == 0)) {
                     keyMatchFound = true;
                     tokIdx += 1;
                 }
-                else if (((pTok->type == JSMNR_ARRAY) || (pTok->type == JSMNR_OBJECT)) && ((int)strlen(srchKey) == 0)) {
+                else if (((pTok->type == JSMNR_ARRAY) || (pTok->type == JSMNR_OBJECT)) && (srchKeyLen == 0)) {
                     keyMatchFound = true;
                 }
 
@@ -368,7 +473,7 @@ private:
                     if (arrayElementReqd) {
                         if (tokens[tokIdx].type == JSMNR_ARRAY) {
                             int newTokIdx = findObjectEnd(jsonOriginal, tokens, numTokens, tokIdx + 1, reqdArrayIdx, false);
-//                            Log.trace("TokIdxArray inIdx %d, reqdArrayIdx %d, outTokIdx %d", tokIdx, reqdArrayIdx, newTokIdx);
+//                            RDJSON_LOG_TRACE("TokIdxArray inIdx %d, reqdArrayIdx %d, outTokIdx %d", tokIdx, reqdArrayIdx, newTokIdx);
                             tokIdx = newTokIdx;
                         }
                         else {
@@ -380,23 +485,23 @@ private:
                     // atNodeLevel indicates that we are now at the level of the JSON tree that the user requested
                     // - so we should be extracting the value referenced now
                     if (atNodeLevel) {
-                        // Log.trace("findObjectEnd we have got it %d", tokIdx);
+                        // RDJSON_LOG_TRACE("findObjectEnd we have got it %d", tokIdx);
                         if ((keyTypeToFind == JSMNR_UNDEFINED) || (tokens[tokIdx].type == keyTypeToFind)) {
                             endTokenIdx = findObjectEnd(jsonOriginal, tokens, numTokens, tokIdx, 1, false);
                             //int testTokenIdx = findObjectEnd(jsonOriginal, tokens, numTokens, tokIdx+1, 1);
-                            //Log.trace("TokIdxDiff max %d, test %d, diff %d", endTokenIdx, testTokenIdx, testTokenIdx-endTokenIdx);
+                            //RDJSON_LOG_TRACE("TokIdxDiff max %d, test %d, diff %d", endTokenIdx, testTokenIdx, testTokenIdx-endTokenIdx);
                             return tokIdx;
                         }
                         return -1;
                     }
                     else {
                         // Check for an object
-                        // Log.trace("findObjectEnd inside");
+                        // RDJSON_LOG_TRACE("findObjectEnd inside");
                         if (tokens[tokIdx].type == JSMNR_OBJECT) {
                             // Continue next level of search in this object
                             maxTokenIdx = findObjectEnd(jsonOriginal, tokens, numTokens, tokIdx, 1);
                             //int testTokenIdx = findObjectEnd(jsonOriginal, tokens, numTokens, tokIdx+1, 1);
-                            //Log.trace("TokIdxDiff2 max %d, test %d, diff %d", maxTokenIdx, testTokenIdx, testTokenIdx- maxTokenIdx);
+                            //RDJSON_LOG_TRACE("TokIdxDiff2 max %d, test %d, diff %d", maxTokenIdx, testTokenIdx, testTokenIdx- maxTokenIdx);
                             curTokenIdx = tokIdx + 1;
                             break;
                         }
@@ -459,12 +564,16 @@ public:
     {
         char* pD = pDest;
         const char* pS = pSrc;
-        size_t srcStrlen = strlen(pS);
         size_t stringLen = 0;
         bool insideDoubleQuotes = false;
         bool insideSingleQuotes = false;
-        for (size_t i = 0; i < srcStrlen + 1; i++) {
+        // Stops at maxx so the rest of the source isn't scanned
+        while (true) {
             char ch = *pS++;
+            if (ch == 0) {
+                *pD = 0;
+                break;
+            }
             if ((ch == '\'') && !insideDoubleQuotes)
                 insideSingleQuotes = !insideSingleQuotes;
             else if ((ch == '\"') && !insideSingleQuotes)
@@ -491,12 +600,16 @@ public:
             return pDest;
         char* pD = pDest;
         const char* pS = pSrc;
-        size_t srcStrlen = strlen(pS);
         size_t stringLen = 0;
         bool insideDoubleQuotes = false;
         bool insideSingleQuotes = false;
-        for (size_t i = 0; i < srcStrlen + 1; i++) {
+        // Stops at maxx so the rest of the source isn't scanned
+        while (true) {
             char ch = *pS++;
+            if (ch == 0) {
+                *pD = 0;
+                break;
+            }
             if ((ch == '\'') && !insideDoubleQuotes)
                 insideSingleQuotes = !insideSingleQuotes;
             else if ((ch == '\"') && !insideSingleQuotes)
@@ -510,7 +623,7 @@ public:
                 break;
             }
         }
-        //        Log.trace("safeStringDup <%s> %d %d %d %d %d %d %d <%s>", pSrc, maxx, toAlloc, srcStrlen, stringLen, insideDoubleQuotes, insideSingleQuotes, skipJSONWhitespace, pDest);
+        //        RDJSON_LOG_TRACE("safeStringDup <%s> %d %d %d %d %d %d <%s>", pSrc, maxx, toAlloc, stringLen, insideDoubleQuotes, insideSingleQuotes, skipJSONWhitespace, pDest);
         return pDest;
     }
 
@@ -0,0 +1,247 @@
+// RdJsonDocument
+// Rob Dobson 2017
+
+// A JSON document parsed once into a token arena which can then be queried any number of
+// times (using the same dataPath syntax as RdJson) without parsing again. The arena is
+// either supplied by the caller (in which case nothing is allocated and documents with more
+// tokens than it holds fail to parse) or owned by the document - an owned arena grows when
+// needed and is kept for the next parse so a long-lived document doesn't allocate once it
+// has seen its largest input. The source string must remain valid while it is queried
+
+#pragma once
+#include "RdJson.h"
+
+class RdJsonDocument {
+public:
+    // Size of an owned arena when first allocated
+    static const int DEFAULT_ARENA_TOKENS = 32;
+
+    // Document with an owned arena
+    RdJsonDocument(int maxTokens = 10000)
+    {
+        _pTokens = NULL;
+        _arenaSize = 0;
+        _ownsArena = true;
+        _maxTokens = maxTokens;
+        clear();
+    }
+
+    // Document using a caller supplied arena
+    RdJsonDocument(jsmnrtok_t* pArena, int arenaSize)
+    {
+        _pTokens = pArena;
+        _arenaSize = arenaSize;
+        _ownsArena = false;
+        _maxTokens = arenaSize;
+        clear();
+    }
+
+    ~RdJsonDocument()
+    {
+        if (_ownsArena)
+            delete[] _pTokens;
+    }
+
+    // Parse JSON - jsonLen < 0 for a null terminated string
+    bool parse(const char* pJsonStr, int jsonLen = -1)
+    {
+        clear();
+        if (pJsonStr == NULL) {
+            RDJSON_LOG_ERROR("RdJsonDocument: Source JSON is NULL");
+            return false;
+        }
+        if (jsonLen < 0)
+            jsonLen = strlen(pJsonStr);
+
+        // Parse into the arena - an owned arena which is too small is grown (to the size
+        // found by counting the tokens) and the parse repeated
+        JSMNR_parser parser;
+        int tokenCountRslt = JSMNR_ERROR_NOMEM;
+        if (_pTokens != NULL) {
+            JSMNR_init(&parser);
+            tokenCountRslt = JSMNR_parse(&parser, pJsonStr, jsonLen, _pTokens, _arenaSize);
+        }
+        if ((tokenCountRslt == JSMNR_ERROR_NOMEM) && _ownsArena) {
+            JSMNR_init(&parser);
+            int reqdTokens = JSMNR_parse(&parser, pJsonStr, jsonLen, NULL, _maxTokens);
+            if (reqdTokens < 0) {
+                RDJSON_LOG_TRACE("RdJsonDocument: count result %d jsonLen %d", reqdTokens, jsonLen);
+                return false;
+            }
+            if (!growArena(reqdTokens))
+                return false;
+            JSMNR_init(&parser);
+            tokenCountRslt = JSMNR_parse(&parser, pJsonStr, jsonLen, _pTokens, _arenaSize);
+        }
+        if (tokenCountRslt <= 0) {
+            RDJSON_LOG_TRACE("RdJsonDocument: parse result %d arena %d jsonLen %d", tokenCountRslt, _arenaSize, jsonLen);
+            return false;
+        }
+        _pJsonStr = pJsonStr;
+        _numTokens = tokenCountRslt;
+        return true;
+    }
+
+    void clear()
+    {
+        _pJsonStr = NULL;
+        _numTokens = 0;
+    }
+
+    bool isValid() const
+    {
+        return _numTokens > 0;
+    }
+
+    int getNumTokens() const
+    {
+        return _numTokens;
+    }
+
+    const char* getJsonStr() const
+    {
+        return _pJsonStr;
+    }
+
+    // Get location of element in the document
+    bool getElement(const char* dataPath,
+        int& startPos, int& strLen,
+        jsmnrtype_t& objType, int& objSize) const
+    {
+        if (!isValid())
+            return false;
+        int startTokenIdx, endTokenIdx;
+        if (!RdJson::getTokenByDataPath(_pJsonStr, dataPath,
+                _pTokens, _numTokens, startTokenIdx, endTokenIdx))
+            return false;
+        const jsmnrtok_t& tok = _pTokens[startTokenIdx];
+        objType = tok.type;
+        objSize = tok.size;
+        startPos = tok.start;
+        strLen = tok.end - startPos;
+        return true;
+    }
+
+    // View of an element in the JSON text without copying it - for a string this is the text
+    // between the quotes (escapes are left as they are - see getUnescaped)
+    bool getView(const char* dataPath,
+        const char*& pStr, int& strLen, jsmnrtype_t& objType) const
+    {
+        int startPos = 0, objSize = 0;
+        if (!getElement(dataPath, startPos, strLen, objType, objSize))
+            return false;
+        pStr = _pJsonStr + startPos;
+        return true;
+    }
+
+    bool getView(const char* dataPath, const char*& pStr, int& strLen) const
+    {
+        jsmnrtype_t objType = JSMNR_UNDEFINED;
+        return getView(dataPath, pStr, strLen, objType);
+    }
+
+    // Unescape a string element into a buffer - returns the length or -1 if not found or
+    // it doesn't fit
+    int getUnescaped(const char* dataPath, char* pBuf, int bufSize) const
+    {
+        const char* pStr = NULL;
+        int strLen = 0;
+        if (!getView(dataPath, pStr, strLen))
+            return -1;
+        return RdJson::unescapeToBuf(pStr, strLen, pBuf, bufSize);
+    }
+
+    String getString(const char* dataPath,
+        const char* defaultValue, bool& isValid,
+        jsmnrtype_t& objType, int& objSize) const
+    {
+        int startPos = 0, strLen = 0;
+        isValid = getElement(dataPath, startPos, strLen, objType, objSize);
+        if (!isValid)
+            return defaultValue;
+        return RdJson::getElementString(_pJsonStr, startPos, strLen, objType, objSize);
+    }
+
+    String getString(const char* dataPath, const char* defaultValue) const
+    {
+        bool isValid = false;
+        jsmnrtype_t objType = JSMNR_UNDEFINED;
+        int objSize = 0;
+        return getString(dataPath, defaultValue, isValid, objType, objSize);
+    }
+
+    double getDouble(const char* dataPath, double defaultValue, bool& isValid) const
+    {
+        int startPos = 0, strLen = 0;
+        jsmnrtype_t objType = JSMNR_UNDEFINED;
+        int objSize = 0;
+        isValid = getElement(dataPath, startPos, strLen, objType, objSize);
+        if (!isValid)
+            return defaultValue;
+        return strtod(_pJsonStr + startPos, NULL);
+    }
+
+    double getDouble(const char* dataPath, double defaultValue) const
+    {
+        bool isValid = false;
+        return getDouble(dataPath, defaultValue, isValid);
+    }
+
+    long getLong(const char* dataPath, long defaultValue, bool& isValid) const
+    {
+        int startPos = 0, strLen = 0;
+        jsmnrtype_t objType = JSMNR_UNDEFINED;
+        int objSize = 0;
+        isValid = getElement(dataPath, startPos, strLen, objType, objSize);
+        if (!isValid)
+            return defaultValue;
+        return strtol(_pJsonStr + startPos, NULL, 10);
+    }
+
+    long getLong(const char* dataPath, long defaultValue) const
+    {
+        bool isValid = false;
+        return getLong(dataPath, defaultValue, isValid);
+    }
+
+    // Type of the root element (and its size if an array or object)
+    jsmnrtype_t getType(int& arrayLen) const
+    {
+        if (!isValid())
+            return JSMNR_UNDEFINED;
+        arrayLen = _pTokens[0].size;
+        return _pTokens[0].type;
+    }
+
+private:
+    // Not copyable as the arena may be owned
+    RdJsonDocument(const RdJsonDocument&);
+    RdJsonDocument& operator=(const RdJsonDocument&);
+
+    bool growArena(int reqdTokens)
+    {
+        if (reqdTokens > _maxTokens) {
+            RDJSON_LOG_INFO("RdJsonDocument: %d tokens exceeds max %d", reqdTokens, _maxTokens);
+            return false;
+        }
+        int newSize = (_arenaSize > 0) ? _arenaSize : DEFAULT_ARENA_TOKENS;
+        while (newSize < reqdTokens)
+            newSize *= 2;
+        if (newSize > _maxTokens)
+            newSize = _maxTokens;
+        delete[] _pTokens;
+        _pTokens = new jsmnrtok_t[newSize];
+        _arenaSize = newSize;
+        return true;
+    }
+
+    // Token arena
+    jsmnrtok_t* _pTokens;
+    int _arenaSize;
+    bool _ownsArena;
+    int _maxTokens;
+
+    // Parsed document
+    const char* _pJsonStr;
+    int _numTokens;
+};
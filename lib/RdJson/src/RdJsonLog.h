@@ -0,0 +1,39 @@
+// RdJson logging
+// Rob Dobson 2017
+
+// Calls below RDJSON_LOG_LEVEL (set when building e.g. -DRDJSON_LOG_LEVEL=RDJSON_LOG_LEVEL_INFO)
+// compile to nothing so their arguments aren't evaluated - trace arguments are also only
+// evaluated when trace is enabled at run time - values are those of Particle's LOG_LEVEL_xxx
+
+#pragma once
+
+// Host builds use the subset of the wiring API from RdWebServer
+#ifdef RDWEBSERVER_POSIX
+#include "RdPosixWiring.h"
+#else
+#include "application.h"
+#endif
+
+#define RDJSON_LOG_LEVEL_TRACE 1
+#define RDJSON_LOG_LEVEL_INFO  30
+#define RDJSON_LOG_LEVEL_ERROR 50
+#define RDJSON_LOG_LEVEL_NONE  70
+#ifndef RDJSON_LOG_LEVEL
+#define RDJSON_LOG_LEVEL RDJSON_LOG_LEVEL_TRACE
+#endif
+
+#if RDJSON_LOG_LEVEL <= RDJSON_LOG_LEVEL_TRACE
+#define RDJSON_LOG_TRACE(...) do { if (Log.isTraceEnabled()) { Log.trace(__VA_ARGS__); } } while (0)
+#else
+#define RDJSON_LOG_TRACE(...) do { } while (0)
+#endif
+#if RDJSON_LOG_LEVEL <= RDJSON_LOG_LEVEL_INFO
+#define RDJSON_LOG_INFO(...) Log.info(__VA_ARGS__)
+#else
+#define RDJSON_LOG_INFO(...) do { } while (0)
+#endif
+#if RDJSON_LOG_LEVEL <= RDJSON_LOG_LEVEL_ERROR
+#define RDJSON_LOG_ERROR(...) Log.error(__VA_ARGS__)
+#else
+#define RDJSON_LOG_ERROR(...) do { } while (0)
+#endif
@@ -0,0 +1,258 @@
+// RdJsonStreamParser
+// Rob Dobson 2017
+
+#include "RdJsonStreamParser.h"
+#include "RdJson.h"
+
+RdJsonStreamParser::RdJsonStreamParser()
+{
+    _callback = NULL;
+    reset();
+}
+
+void RdJsonStreamParser::reset()
+{
+    _state = STATE_VALUE;
+    _error = JSMNR_SUCCESS;
+    _pos = 0;
+    _depth = 0;
+    _pathLen = 0;
+    _path[0] = 0;
+    _valueLen = 0;
+    _value[0] = 0;
+    _stringIsKey = false;
+    _escapePending = false;
+}
+
+bool RdJsonStreamParser::feed(const char* pData, int dataLen)
+{
+    if (_state == STATE_ERROR)
+        return false;
+    for (int i = 0; i < dataLen; i++) {
+        if (!handleChar(pData[i]))
+            return false;
+        _pos++;
+    }
+    return true;
+}
+
+bool RdJsonStreamParser::finish()
+{
+    // A primitive at the root is only ended by the end of the document
+    if ((_state == STATE_PRIMITIVE) && (_depth == 0)) {
+        if (!endPrimitive())
+            return false;
+    }
+    if (_state == STATE_DONE)
+        return true;
+    if (_state != STATE_ERROR)
+        setError(JSMNR_ERROR_PART);
+    return false;
+}
+
+bool RdJsonStreamParser::handleChar(char ch)
+{
+    // Strings and primitives
+    if (_state == STATE_STRING) {
+        if (_escapePending) {
+            _escapePending = false;
+        }
+        else if (ch == '\\') {
+            _escapePending = true;
+        }
+        else if (ch == '\"') {
+            return endString();
+        }
+        else if ((uint8_t)ch < 32) {
+            return setError(JSMNR_ERROR_INVAL);
+        }
+        return appendValueChar(ch);
+    }
+    if (_state == STATE_PRIMITIVE) {
+        switch (ch) {
+        case '\t': case '\r': case '\n': case ' ':
+        case ',': case ']': case '}': case ':':
+            // The character after the primitive is handled once it has ended
+            if (!endPrimitive())
+                return false;
+            return handleChar(ch);
+        }
+        if ((ch < 32) || (ch >= 127))
+            return setError(JSMNR_ERROR_INVAL);
+        return appendValueChar(ch);
+    }
+
+    // Whitespace between tokens
+    if ((ch == '\t') || (ch == '\r') || (ch == '\n') || (ch == ' '))
+        return true;
+
+    switch (_state) {
+    case STATE_VALUE_OR_END:
+        if (ch == ']')
+            return endContainer(true);
+        return startValue(ch);
+    case STATE_VALUE:
+        return startValue(ch);
+    case STATE_KEY_OR_END:
+        if (ch == '}')
+            return endContainer(false);
+        // Fall through
+    case STATE_KEY:
+        if (ch != '\"')
+            return setError(JSMNR_ERROR_INVAL);
+        _stringIsKey = true;
+        _valueLen = 0;
+        _state = STATE_STRING;
+        return true;
+    case STATE_COLON:
+        if (ch != ':')
+            return setError(JSMNR_ERROR_INVAL);
+        _state = STATE_VALUE;
+        return true;
+    case STATE_COMMA_OR_END:
+        if (ch == ',') {
+            _state = _levels[_depth - 1]._isArray ? STATE_VALUE : STATE_KEY;
+            return true;
+        }
+        if ((ch == ']') || (ch == '}'))
+            return endContainer(ch == ']');
+        return setError(JSMNR_ERROR_INVAL);
+    default:
+        // Anything after the document (or after an error)
+        return setError(JSMNR_ERROR_INVAL);
+    }
+}
+
+bool RdJsonStreamParser::startValue(char ch)
+{
+    // Elements of arrays are numbered in the path
+    if ((_depth > 0) && _levels[_depth - 1]._isArray) {
+        char idxStr[16];
+        int idxLen = snprintf(idxStr, sizeof(idxStr), "[%d]", _levels[_depth - 1]._elemIdx);
+        if (!appendToPath(idxStr, idxLen))
+            return false;
+    }
+
+    switch (ch) {
+    case '{':
+    case '[': {
+        bool isArray = (ch == '[');
+        if (_depth >= MAX_DEPTH)
+            return setError(JSMNR_ERROR_NOMEM);
+        if (_callback && !_callback(EVENT_START, _path, isArray ? JSMNR_ARRAY : JSMNR_OBJECT, "", 0)) {
+            _state = STATE_ERROR;
+            return false;
+        }
+        Level& level = _levels[_depth++];
+        level._isArray = isArray;
+        level._elemIdx = 0;
+        level._pathLen = _pathLen;
+        _state = isArray ? STATE_VALUE_OR_END : STATE_KEY_OR_END;
+        return true;
+    }
+    case '\"':
+        _stringIsKey = false;
+        _valueLen = 0;
+        _state = STATE_STRING;
+        return true;
+    case '}': case ']': case ',': case ':':
+        return setError(JSMNR_ERROR_INVAL);
+    default:
+        if ((ch < 32) || (ch >= 127))
+            return setError(JSMNR_ERROR_INVAL);
+        _valueLen = 0;
+        _state = STATE_PRIMITIVE;
+        return appendValueChar(ch);
+    }
+}
+
+// A value (or a whole container) has ended - back to the path of the container it is in
+bool RdJsonStreamParser::endValue()
+{
+    if (_depth == 0) {
+        _pathLen = 0;
+        _path[0] = 0;
+        _state = STATE_DONE;
+        return true;
+    }
+    Level& level = _levels[_depth - 1];
+    _pathLen = level._pathLen;
+    _path[_pathLen] = 0;
+    if (level._isArray)
+        level._elemIdx++;
+    _state = STATE_COMMA_OR_END;
+    return true;
+}
+
+bool RdJsonStreamParser::endContainer(bool isArray)
+{
+    if ((_depth == 0) || (_levels[_depth - 1]._isArray != isArray))
+        return setError(JSMNR_ERROR_INVAL);
+    _depth--;
+    _pathLen = _levels[_depth]._pathLen;
+    _path[_pathLen] = 0;
+    if (_callback && !_callback(EVENT_END, _path, isArray ? JSMNR_ARRAY : JSMNR_OBJECT, "", 0)) {
+        _state = STATE_ERROR;
+        return false;
+    }
+    return endValue();
+}
+
+bool RdJsonStreamParser::endString()
+{
+    // Unescaping never makes the string longer so it is done in place
+    int strLen = RdJson::unescapeToBuf(_value, _valueLen, _value, MAX_VALUE_LEN + 1);
+    if (strLen < 0)
+        return setError(JSMNR_ERROR_INVAL);
+
+    // Keys are added to the path of the object
+    if (_stringIsKey) {
+        if ((_pathLen > 0) && !appendToPath("/", 1))
+            return false;
+        if (!appendToPath(_value, strLen))
+            return false;
+        _state = STATE_COLON;
+        return true;
+    }
+    if (_callback && !_callback(EVENT_VALUE, _path, JSMNR_STRING, _value, strLen)) {
+        _state = STATE_ERROR;
+        return false;
+    }
+    return endValue();
+}
+
+bool RdJsonStreamParser::endPrimitive()
+{
+    _value[_valueLen] = 0;
+    if (_callback && !_callback(EVENT_VALUE, _path, JSMNR_PRIMITIVE, _value, _valueLen)) {
+        _state = STATE_ERROR;
+        return false;
+    }
+    return endValue();
+}
+
+bool RdJsonStreamParser::appendValueChar(char ch)
+{
+    if (_valueLen >= MAX_VALUE_LEN)
+        return setError(JSMNR_ERROR_NOMEM);
+    _value[_valueLen++] = ch;
+    return true;
+}
+
+bool RdJsonStreamParser::appendToPath(const char* pStr, int strLen)
+{
+    if (_pathLen + strLen > MAX_PATH_LEN)
+        return setError(JSMNR_ERROR_NOMEM);
+    memcpy(_path + _pathLen, pStr, strLen);
+    _pathLen += strLen;
+    _path[_pathLen] = 0;
+    return true;
+}
+
+bool RdJsonStreamParser::setError(jsmnrerr_t error)
+{
+    RDJSON_LOG_TRACE("RdJsonStreamParser: error %d at pos %lu", error, _pos);
+    _error = error;
+    _state = STATE_ERROR;
+    return false;
+}
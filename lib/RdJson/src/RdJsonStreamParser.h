@@ -0,0 +1,113 @@
+// RdJsonStreamParser
+// Rob Dobson 2017
+
+// Parses JSON as it arrives (e.g. the body of a request as each part is received) without
+// holding the document in memory. A callback is made for each value with its path in the
+// dataPath syntax used by RdJson (e.g. patterns/foo/steps[42]/x) and for the start and end
+// of each object and array. Only the current path and value are held - so values and paths
+// longer than MAX_VALUE_LEN and MAX_PATH_LEN (and nesting deeper than MAX_DEPTH) are errors
+
+#pragma once
+#include <functional>
+#include "jsmnParticleR.h"
+
+class RdJsonStreamParser {
+public:
+    static const int MAX_DEPTH = 16;
+    static const int MAX_PATH_LEN = 128;
+    static const int MAX_VALUE_LEN = 256;
+
+    // Kinds of callback
+    typedef enum {
+        EVENT_VALUE,
+        EVENT_START,
+        EVENT_END
+    } Event;
+
+    // Callback - type is JSMNR_STRING (the value is unescaped) or JSMNR_PRIMITIVE for values
+    // and JSMNR_OBJECT or JSMNR_ARRAY for starts and ends (the value is empty) - the path and
+    // value are null terminated and only valid during the callback - returns false to stop
+    // parsing
+    typedef std::function<bool(Event event, const char* pPath, jsmnrtype_t type,
+        const char* pValue, int valueLen)> CallbackType;
+
+    RdJsonStreamParser();
+
+    void setCallback(CallbackType callback)
+    {
+        _callback = callback;
+    }
+
+    // Start a new document
+    void reset();
+
+    // Parse the next part of the document - returns false on error (or if the callback
+    // stopped parsing) after which the rest of the document is ignored
+    bool feed(const char* pData, int dataLen);
+
+    // Call at the end of the document - returns true if a whole document was parsed
+    bool finish();
+
+    // JSMNR_SUCCESS or the reason parsing failed (JSMNR_ERROR_INVAL for invalid JSON,
+    // JSMNR_ERROR_NOMEM if a limit was exceeded, JSMNR_ERROR_PART for an incomplete document)
+    jsmnrerr_t getError() const
+    {
+        return _error;
+    }
+
+    // Position of the next character in the document
+    unsigned long getPos() const
+    {
+        return _pos;
+    }
+
+private:
+    typedef enum {
+        STATE_VALUE,            // value expected
+        STATE_VALUE_OR_END,     // value or end of array expected (start of array)
+        STATE_KEY,              // key expected
+        STATE_KEY_OR_END,       // key or end of object expected (start of object)
+        STATE_COLON,            // colon after key expected
+        STATE_COMMA_OR_END,     // comma or end of the container expected after a value
+        STATE_STRING,           // in a string (a key or a value)
+        STATE_PRIMITIVE,        // in a primitive
+        STATE_DONE,             // whole document parsed
+        STATE_ERROR
+    } State;
+
+    // Containers which are open - the path length is that of the container's path
+    struct Level {
+        bool _isArray;
+        int _elemIdx;
+        int _pathLen;
+    };
+
+    bool handleChar(char ch);
+    bool startValue(char ch);
+    bool endValue();
+    bool endContainer(bool isArray);
+    bool endString();
+    bool endPrimitive();
+    bool appendValueChar(char ch);
+    bool appendToPath(const char* pStr, int strLen);
+    bool setError(jsmnrerr_t error);
+
+    CallbackType _callback;
+    State _state;
+    jsmnrerr_t _error;
+    unsigned long _pos;
+
+    // Open containers
+    Level _levels[MAX_DEPTH];
+    int _depth;
+
+    // Path of the current value
+    char _path[MAX_PATH_LEN + 1];
+    int _pathLen;
+
+    // Current string or primitive
+    char _value[MAX_VALUE_LEN + 1];
+    int _valueLen;
+    bool _stringIsKey;
+    bool _escapePending;
+};
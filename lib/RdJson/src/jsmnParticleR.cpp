@@ -18,10 +18,24 @@ static jsmnrtok_t *JSMNR_alloc_token(JSMNR_parser *parser,
 	tok->size = 0;
 #ifdef JSMNR_PARENT_LINKS
 	tok->parent = -1;
+#endif
+#ifdef JSMNR_NEXT_SIBLING_LINKS
+	tok->next = parser->toknext;
 #endif
 	return tok;
 }
 
+#ifdef JSMNR_NEXT_SIBLING_LINKS
+/**
+ * A value has ended - if it belongs to an object key the key's subtree ends with it.
+ */
+static void JSMNR_end_value(JSMNR_parser *parser, jsmnrtok_t *tokens, int parentIdx) {
+	if (parentIdx != -1 && tokens[parentIdx].type == JSMNR_STRING) {
+		tokens[parentIdx].next = parser->toknext;
+	}
+}
+#endif
+
 /**
  * Fills token type and boundaries.
  */
@@ -54,7 +68,7 @@ static int JSMNR_parse_primitive(JSMNR_parser *parser, const char *js,
 				goto found;
 		}
 		if (js[parser->pos] < 32 || js[parser->pos] >= 127) {
-            Log.trace("JSMNR_ERROR_INVAL ch bounds %d pos %d", js[parser->pos], parser->pos);
+            RDJSON_LOG_TRACE("JSMNR_ERROR_INVAL ch bounds %d pos %d", js[parser->pos], parser->pos);
             parser->pos = start;
 			return JSMNR_ERROR_INVAL;
 		}
@@ -131,7 +145,7 @@ static int JSMNR_parse_string(JSMNR_parser *parser, const char *js,
 						if(!((js[parser->pos] >= 48 && js[parser->pos] <= 57) || // 0-9
 									(js[parser->pos] >= 65 && js[parser->pos] <= 70) || // A-F
 									(js[parser->pos] >= 97 && js[parser->pos] <= 102))) { // a-f
-                            Log.trace("JSMNR_ERROR_INVAL hex bounds %d pos %d", js[parser->pos], parser->pos);
+                            RDJSON_LOG_TRACE("JSMNR_ERROR_INVAL hex bounds %d pos %d", js[parser->pos], parser->pos);
 							parser->pos = start;
 							return JSMNR_ERROR_INVAL;
 						}
@@ -141,7 +155,7 @@ static int JSMNR_parse_string(JSMNR_parser *parser, const char *js,
 					break;
 				// Unexpected symbol
 				default:
-                    Log.trace("JSMNR_ERROR_INVAL Unexpected %d pos %d", js[parser->pos], parser->pos);
+                    RDJSON_LOG_TRACE("JSMNR_ERROR_INVAL Unexpected %d pos %d", js[parser->pos], parser->pos);
 					parser->pos = start;
 					return JSMNR_ERROR_INVAL;
 			}
@@ -193,10 +207,11 @@ int JSMNR_parse(JSMNR_parser *parser, const char *js, size_t len,
 					break;
 				type = (c == '}' ? JSMNR_OBJECT : JSMNR_ARRAY);
 #ifdef JSMNR_PARENT_LINKS
-				if (parser->toknext < 1) {
+				/* Start at the open container (or the key in it whose value has just ended) */
+				if (parser->toksuper == -1) {
 					return JSMNR_ERROR_INVAL;
 				}
-				token = &tokens[parser->toknext - 1];
+				token = &tokens[parser->toksuper];
 				for (;;) {
 					if (token->start != -1 && token->end == -1) {
 						if (token->type != type) {
@@ -204,6 +219,10 @@ int JSMNR_parse(JSMNR_parser *parser, const char *js, size_t len,
 						}
 						token->end = parser->pos + 1;
 						parser->toksuper = token->parent;
+#ifdef JSMNR_NEXT_SIBLING_LINKS
+						token->next = parser->toknext;
+						JSMNR_end_value(parser, tokens, token->parent);
+#endif
 						break;
 					}
 					if (token->parent == -1) {
@@ -219,7 +238,7 @@ int JSMNR_parse(JSMNR_parser *parser, const char *js, size_t len,
 					token = &tokens[i];
 					if (token->start != -1 && token->end == -1) {
 						if (token->type != type) {
-                            Log.info("JSMNR_ERROR_INVAL %d type %d %d", token->start, token->type, type);
+                            RDJSON_LOG_INFO("JSMNR_ERROR_INVAL %d type %d %d", token->start, token->type, type);
 							return JSMNR_ERROR_INVAL;
 						}
 						parser->toksuper = -1;
@@ -230,7 +249,7 @@ int JSMNR_parse(JSMNR_parser *parser, const char *js, size_t len,
 				/* Error if unmatched closing bracket */
 				if (i == -1)
                 {
-                    Log.info("JSMNR_ERROR_INVAL unmatchedbrace pos %d ch %d toknext %d type %d", parser->pos, js[parser->pos], parser->toknext, type);
+                    RDJSON_LOG_INFO("JSMNR_ERROR_INVAL unmatchedbrace pos %d ch %d toknext %d type %d", parser->pos, js[parser->pos], parser->toknext, type);
                     JSMNR_logLongStr("JSMN: parse input", js, true);
                     return JSMNR_ERROR_INVAL;
                 }
@@ -247,8 +266,12 @@ int JSMNR_parse(JSMNR_parser *parser, const char *js, size_t len,
 				r = JSMNR_parse_string(parser, js, len, tokens, num_tokens);
 				if (r < 0) return r;
 				count++;
-				if (parser->toksuper != -1 && tokens != NULL)
+				if (parser->toksuper != -1 && tokens != NULL) {
 					tokens[parser->toksuper].size++;
+#ifdef JSMNR_NEXT_SIBLING_LINKS
+					JSMNR_end_value(parser, tokens, parser->toksuper);
+#endif
+				}
 				break;
 			case '\t' : case '\r' : case '\n' : case ' ':
 				break;
@@ -293,8 +316,12 @@ int JSMNR_parse(JSMNR_parser *parser, const char *js, size_t len,
 				r = JSMNR_parse_primitive(parser, js, len, tokens, num_tokens);
 				if (r < 0) return r;
 				count++;
-				if (parser->toksuper != -1 && tokens != NULL)
+				if (parser->toksuper != -1 && tokens != NULL) {
 					tokens[parser->toksuper].size++;
+#ifdef JSMNR_NEXT_SIBLING_LINKS
+					JSMNR_end_value(parser, tokens, parser->toksuper);
+#endif
+				}
 				break;
 
 #ifdef JSMNR_STRICT
@@ -330,19 +357,21 @@ void JSMNR_init(JSMNR_parser *parser) {
 // Helper function to log long strings
 void JSMNR_logLongStr(const char* headerMsg, const char* toLog, bool infoLevel)
 {
+    // Nothing to do if the level isn't enabled
+    if (infoLevel ? (RDJSON_LOG_LEVEL > RDJSON_LOG_LEVEL_INFO) :
+                    ((RDJSON_LOG_LEVEL > RDJSON_LOG_LEVEL_TRACE) || !Log.isTraceEnabled()))
+        return;
     if (infoLevel)
-        Log.info(headerMsg);
+        RDJSON_LOG_INFO("%s", headerMsg);
     else
-        Log.trace(headerMsg);
+        RDJSON_LOG_TRACE("%s", headerMsg);
     const int linLen = 80;
-    for (unsigned int i = 0; i < strlen(toLog); i+=linLen)
+    int toLogLen = strlen(toLog);
+    for (int i = 0; i < toLogLen; i += linLen)
     {
-        char pBuf[linLen+1];
-        strncpy(pBuf, toLog+i, linLen);
-        pBuf[linLen] = 0;
         if (infoLevel)
-            Log.info(pBuf);
+            RDJSON_LOG_INFO("%.*s", linLen, toLog + i);
         else
-            Log.trace(pBuf);
+            RDJSON_LOG_TRACE("%.*s", linLen, toLog + i);
     }
 }
@@ -1,6 +1,24 @@
 #pragma once
 
-#include "application.h"
+#include "RdJsonLog.h"
+
+/**
+ * Parent links make closing brackets and commas O(1) (rather than a scan back over all
+ * the tokens so far - quadratic for wide or long documents) at the cost of an int per token.
+ * Define JSMNR_NO_PARENT_LINKS to save the memory.
+ */
+#ifndef JSMNR_NO_PARENT_LINKS
+#define JSMNR_PARENT_LINKS
+#endif
+
+/**
+ * Next sibling links (which need parent links) give the index of the token after each
+ * token's subtree (for an object key this includes its value) so lookups can skip values in
+ * a single step. Define JSMNR_NO_NEXT_SIBLING_LINKS to save the memory.
+ */
+#if defined(JSMNR_PARENT_LINKS) && !defined(JSMNR_NO_NEXT_SIBLING_LINKS)
+#define JSMNR_NEXT_SIBLING_LINKS
+#endif
 
 /**
  * JSON type identifier. Basic types are:
@@ -33,6 +51,7 @@ typedef enum {
  * @param		type	type (object, array, string etc.)
  * @param		start	start position in JSON data string
  * @param		end		end position in JSON data string
+ * @param		next	index of the token after this token's subtree
  */
 typedef struct jsmnrtok_t {
 	jsmnrtype_t type;
@@ -42,6 +61,9 @@ typedef struct jsmnrtok_t {
 #ifdef JSMNR_PARENT_LINKS
 	int parent;
 #endif
+#ifdef JSMNR_NEXT_SIBLING_LINKS
+	int next;
+#endif
 } jsmnrtok_t;
 
 /**
@@ -76,6 +76,85 @@ static const uint8_t reso_favicon_ico[] {
     0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00
     };
 
+static const char reso_favicon_ico_hdr[] = "HTTP/1.1 200 OK\r\n"
+    "Content-Type: image/ico\r\n"
+    "Content-Length: 1150\r\n";
+
+static const char reso_favicon_ico_etag[] = "\"6db2635fdee596fc\"";
+static const char reso_favicon_ico_cache_hdr[] = "ETag: \"6db2635fdee596fc\"\r\n"
+    "Vary: Accept-Encoding\r\n"
+    "Cache-Control: no-cache\r\n";
+
+static const uint8_t reso_favicon_ico_gzip[] {
+    0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xa5,0x93,0xdb,0x53,0x52,0x51,
+    0x14,0xc6,0x4f,0x33,0x3d,0x37,0x3d,0xf5,0xdc,0x63,0xff,0x42,0xcd,0xf4,0x50,0x63,
+    0x6a,0x6a,0x80,0x8a,0x1a,0x89,0x22,0x72,0x11,0xce,0x01,0x51,0x51,0x34,0xbc,0x64,
+    0x66,0x66,0x22,0xa5,0x10,0x17,0x01,0x01,0xc3,0x4b,0x59,0x8a,0x80,0x37,0x24,0x35,
+    0x35,0x73,0xfc,0xab,0xbe,0xbe,0xb3,0x9b,0xfe,0x82,0x36,0xb3,0x19,0xd8,0xe7,0xac,
+    0xb5,0xbe,0xf5,0xfb,0xd6,0x96,0xa4,0x1b,0xfc,0xdc,0xbe,0x2d,0xf1,0xfb,0xae,0xe4,
+    0xb8,0x29,0x49,0x77,0x24,0x49,0xba,0xc7,0xcd,0x23,0x9e,0xfc,0x3d,0x17,0x8b,0xcf,
+    0x2e,0x6e,0xfd,0xdd,0xff,0x56,0x9d,0x12,0x41,0x95,0x25,0x88,0x6a,0x6b,0x10,0x1d,
+    0x6f,0xbe,0xc1,0x1e,0x2a,0xc3,0x34,0x9b,0x47,0xc7,0xcc,0x16,0xea,0x94,0x30,0xee,
+    0x37,0xfb,0xd1,0x3c,0x9c,0x85,0x39,0x50,0x42,0xcb,0x58,0x0e,0x0d,0x9e,0x28,0x1e,
+    0x34,0xfb,0x50,0x6f,0x9b,0x85,0x2d,0x58,0x82,0x79,0xae,0x88,0xce,0x99,0x6d,0x3c,
+    0x55,0xa2,0xd0,0x0d,0xa6,0xa1,0x1f,0x59,0x81,0xde,0xb7,0x0c,0x6b,0x60,0x07,0xf6,
+    0xc5,0x03,0x3c,0xeb,0x5b,0x42,0x5d,0x6f,0x0c,0xda,0x81,0x25,0x18,0x27,0x57,0xe1,
+    0x5c,0xdc,0x83,0xce,0x1b,0xc7,0x83,0x16,0xbf,0x38,0x6b,0xf3,0xaf,0xc0,0xfe,0x61,
+    0x17,0xce,0x4f,0x15,0x98,0xdf,0x17,0xd0,0xf9,0x76,0x0b,0xd5,0x8e,0x05,0x54,0x51,
+    0x8f,0x65,0xbe,0x04,0x39,0x7c,0x08,0x67,0xe8,0x00,0x9a,0xfe,0x25,0xdc,0xd7,0xbf,
+    0x44,0xd3,0x50,0x12,0x9d,0xef,0xb6,0xc5,0x3b,0x0d,0x9e,0x18,0x9e,0xba,0xa2,0xd0,
+    0x78,0x97,0xd1,0x36,0xbe,0x8e,0x46,0x6f,0x0a,0x96,0xb9,0x3c,0x9c,0x91,0x0a,0xb4,
+    0x43,0x69,0x3c,0xb1,0x05,0xf1,0xd8,0x34,0x03,0xc3,0x68,0x06,0x4a,0xa4,0x8c,0x67,
+    0x03,0xaa,0x96,0x28,0x4c,0x8c,0xb7,0xcc,0x17,0xd0,0xe2,0xcf,0xc2,0x93,0x3c,0x63,
+    0x6f,0xbb,0x68,0x67,0xef,0x5a,0xe6,0xa9,0x76,0x84,0xd8,0x53,0x01,0x0e,0xd6,0xb4,
+    0xcc,0x17,0xa1,0x1b,0x4a,0xe1,0x91,0xe9,0x1d,0x8c,0xd3,0x9b,0xb0,0x2f,0xec,0xc3,
+    0xf0,0x6a,0x1d,0x4f,0x2c,0x01,0x68,0x3c,0x61,0xf4,0x2c,0xec,0xa1,0x6b,0xb6,0xc0,
+    0x7c,0x79,0x58,0xa9,0xb5,0x2f,0x75,0x46,0x76,0x3b,0xcc,0x93,0x42,0xad,0x1c,0x46,
+    0x1b,0x79,0xc9,0xd1,0x1f,0x78,0x3e,0xb1,0xc1,0xff,0x21,0xe8,0x58,0xdf,0xc1,0x1c,
+    0x6a,0xae,0x87,0xc6,0x69,0xf2,0x5c,0xc5,0x8b,0xa9,0x6f,0xd0,0xfb,0x57,0xa1,0x19,
+    0xcc,0xa0,0x8b,0xfd,0x3b,0xc3,0x07,0x70,0xc7,0x2a,0xb0,0x90,0xad,0xc6,0x9b,0xe6,
+    0xf3,0x4d,0x51,0x47,0xdd,0x75,0xee,0x08,0x79,0xc6,0x61,0xf9,0x48,0x86,0xc3,0x19,
+    0x34,0xf0,0xb7,0x1c,0x2e,0xa3,0x77,0xe9,0x04,0xae,0xd8,0x09,0x9a,0x46,0x72,0xa8,
+    0xb2,0x2f,0x92,0x4b,0x82,0x79,0x8e,0xd8,0x43,0x19,0xad,0x63,0x6b,0xa8,0x25,0x23,
+    0x23,0xb9,0x76,0xcf,0xef,0xa2,0x9e,0x31,0x7a,0x7f,0x86,0xbc,0xcb,0xec,0xf9,0x0b,
+    0x6a,0x94,0x18,0x5a,0x46,0xd7,0x21,0x93,0x7f,0x6f,0xfc,0x44,0xb0,0x53,0xdf,0x6d,
+    0xf2,0xa5,0xd1,0x31,0xf5,0x05,0xae,0x68,0x19,0x5d,0x81,0x02,0xf4,0xa3,0x39,0x38,
+    0xa8,0x4d,0xdd,0x35,0xca,0x22,0xb4,0x83,0x09,0xf4,0xd0,0x9b,0xfe,0xe5,0x33,0x31,
+    0x03,0x0d,0x9e,0x24,0xcf,0xb2,0xb0,0x2d,0x1c,0xc2,0x45,0x3d,0xa2,0xae,0x1c,0x61,
+    0x8d,0x4d,0xb8,0xe2,0xc7,0x62,0x76,0x6a,0x39,0x6b,0xa6,0xf7,0x79,0x98,0xc9,0xb5,
+    0x71,0x38,0x2d,0x34,0x28,0xd1,0x13,0xf8,0x3e,0xff,0x46,0x7f,0xea,0x9c,0x7a,0x8f,
+    0x04,0x0b,0xc3,0xeb,0xaf,0x70,0x33,0x47,0x77,0xa0,0x88,0x7a,0x7a,0xdc,0xca,0x19,
+    0x91,0x3f,0x1d,0x52,0xd7,0x77,0xe1,0x7d,0x5f,0xf2,0x14,0x8d,0xf4,0x45,0xd3,0x1f,
+    0x63,0x4f,0x7b,0xac,0xb5,0x41,0xa6,0x79,0x6a,0x39,0xa7,0xcf,0x15,0xb4,0x4f,0x6f,
+    0x51,0x53,0x09,0x03,0xd4,0x66,0x0d,0xb2,0x96,0x2f,0x4b,0x2f,0x77,0xc9,0xb4,0x28,
+    0x7c,0x69,0x9f,0x5c,0x13,0x8c,0xb5,0xde,0xa4,0xa8,0xed,0x61,0x3e,0x77,0xe2,0x54,
+    0x78,0xe1,0x0c,0x57,0xe0,0xcb,0x5d,0x09,0x1f,0x5b,0xc7,0x37,0xe0,0x26,0x13,0x33,
+    0x75,0xb4,0x4d,0xac,0xc2,0x93,0x38,0x16,0xbe,0xe8,0x46,0xb2,0xb0,0xd2,0x03,0x03,
+    0x7b,0x33,0x4e,0x6f,0xd3,0xb7,0x22,0xbc,0x99,0x5f,0xf4,0xe0,0x58,0x30,0xee,0xe0,
+    0x7d,0x50,0xb9,0xf4,0x90,0xbf,0x3a,0x47,0x6a,0x9c,0xea,0xb5,0x1a,0x23,0x47,0x8e,
+    0xa8,0x7d,0x19,0xf6,0x60,0x01,0xde,0xf4,0x19,0x46,0xd6,0xae,0x19,0x7b,0x29,0xee,
+    0x57,0x6f,0xe2,0x27,0x06,0x57,0x2e,0xc9,0xbb,0x24,0x62,0x15,0xce,0x4e,0xb3,0x3f,
+    0x27,0x38,0xf7,0x84,0x0e,0xa9,0x61,0x8d,0x31,0x3f,0xd1,0xcd,0x19,0x57,0xbd,0x37,
+    0xf3,0x8e,0x29,0xb1,0x53,0x0c,0x7f,0xbe,0x82,0x7f,0xfd,0x1a,0xb6,0x8f,0x07,0xac,
+    0xb1,0x8f,0x81,0xf4,0x05,0x0c,0xec,0x45,0x26,0x0b,0x95,0x7d,0xd7,0xdc,0x0e,0x7c,
+    0x2b,0x17,0x82,0xdf,0x73,0xb2,0x55,0xb9,0x3b,0xc9,0xd3,0x15,0xaf,0x40,0xfa,0xcf,
+    0xf5,0x07,0xe4,0x97,0x33,0x1e,0x7e,0x04,0x00,0x00
+    };
+
+static const char reso_favicon_ico_gzip_hdr[] = "HTTP/1.1 200 OK\r\n"
+    "Content-Type: image/ico\r\n"
+    "Content-Encoding: gzip\r\n"
+    "Content-Length: 842\r\n";
+
+static const char reso_favicon_ico_gzip_etag[] = "\"d8ceabebd57f0be4\"";
+static const char reso_favicon_ico_gzip_cache_hdr[] = "ETag: \"d8ceabebd57f0be4\"\r\n"
+    "Vary: Accept-Encoding\r\n"
+    "Cache-Control: no-cache\r\n";
+
+static const RdWebServerResourceVariant reso_favicon_ico_variants[] = {
+    RdWebServerResourceVariant("gzip", reso_favicon_ico_gzip, sizeof(reso_favicon_ico_gzip), reso_favicon_ico_gzip_hdr, sizeof(reso_favicon_ico_gzip_hdr) - 1, reso_favicon_ico_gzip_cache_hdr, sizeof(reso_favicon_ico_gzip_cache_hdr) - 1, reso_favicon_ico_gzip_etag)
+    };
+
 static const uint8_t reso_index_html[] {
     0x3c,0x21,0x44,0x4f,0x43,0x54,0x59,0x50,0x45,0x20,0x68,0x74,0x6d,0x6c,0x3e,0x0d,
     0x0a,0x3c,0x68,0x74,0x6d,0x6c,0x3e,0x0d,0x0a,0x09,0x3c,0x68,0x65,0x61,0x64,0x3e,
@@ -1697,10 +1776,450 @@ static const uint8_t reso_index_html[] {
     0x2f,0x68,0x74,0x6d,0x6c,0x3e,0x0d,0x0a
     };
 
+static const char reso_index_html_hdr[] = "HTTP/1.1 200 OK\r\n"
+    "Content-Type: text/html\r\n"
+    "Content-Length: 25880\r\n";
+
+static const char reso_index_html_etag[] = "\"11d9dfdf3e44fc3c\"";
+static const char reso_index_html_cache_hdr[] = "ETag: \"11d9dfdf3e44fc3c\"\r\n"
+    "Vary: Accept-Encoding\r\n"
+    "Cache-Control: no-cache\r\n";
+
+static const uint8_t reso_index_html_gzip[] {
+    0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xed,0x5d,0xe9,0x93,0xdb,0xc6,
+    0x95,0xff,0xac,0xad,0xda,0xff,0xa1,0x0d,0x55,0xc2,0xa1,0x44,0x62,0x70,0x1f,0x9c,
+    0x23,0x25,0x8f,0x64,0x5b,0x29,0xc9,0x52,0x49,0xca,0x6e,0x52,0x91,0x3f,0x60,0xc8,
+    0xe6,0x0c,0x2c,0x12,0xa0,0x01,0x70,0x0e,0x2b,0xca,0xdf,0xbe,0xbf,0xd7,0x8d,0xc6,
+    0x45,0x90,0xc3,0x91,0x8f,0xd8,0xc9,0xce,0x78,0x0c,0xa0,0xf1,0xfa,0xdd,0xef,0xf5,
+    0xeb,0x46,0x03,0x3a,0xfe,0xe2,0xe9,0xab,0xb3,0x77,0x7f,0x7b,0xfd,0x8c,0x5d,0x16,
+    0xcb,0xc5,0xe9,0x7f,0xff,0xd7,0x71,0x79,0x7c,0x70,0x7c,0xc9,0xa3,0x99,0x38,0x29,
+    0xe2,0x62,0xc1,0x4f,0xdf,0x46,0xc9,0x8c,0xbd,0x8b,0xce,0x17,0xfc,0xf8,0x50,0xb6,
+    0xd0,0xbd,0x25,0x2f,0x22,0x96,0x44,0x4b,0x7e,0xa2,0x5d,0xc5,0xfc,0x7a,0x95,0x66,
+    0x85,0xc6,0xa6,0x69,0x52,0xf0,0xa4,0x38,0xd1,0xae,0xe3,0x59,0x71,0x79,0x32,0xe3,
+    0x57,0xf1,0x94,0x8f,0xc5,0xc5,0x88,0xc5,0x49,0x5c,0xc4,0xd1,0x62,0x9c,0x4f,0xa3,
+    0x05,0x3f,0x31,0x35,0xa0,0x61,0xf8,0x39,0xce,0xa7,0x59,0xbc,0x2a,0x58,0x71,0xbb,
+    0x02,0xae,0x82,0xdf,0x14,0x87,0xdf,0x47,0x57,0x91,0x6c,0x25,0xa0,0x07,0x0f,0xae,
+    0xa2,0x8c,0x15,0xff,0x13,0x2d,0x46,0xec,0x66,0xc4,0x6e,0x47,0x2c,0x2f,0xd2,0xd5,
+    0x91,0xba,0xb1,0x48,0x2f,0xd2,0xff,0x25,0x0a,0xec,0x84,0x39,0x86,0x31,0x12,0x0d,
+    0xdf,0xf0,0xf8,0xe2,0xb2,0x90,0x2d,0x2d,0xc8,0xb3,0x28,0x01,0x6e,0x05,0x6f,0x2a,
+    0x78,0xd9,0x5c,0xf5,0x32,0xbb,0xbd,0x20,0x54,0xc6,0xff,0x8a,0x3b,0x5d,0x1c,0x87,
+    0xcc,0x1a,0x35,0x40,0xfe,0xd6,0x02,0x29,0xf1,0x01,0x86,0xb0,0x91,0xb0,0x84,0x30,
+    0x2f,0xa2,0xac,0x78,0x13,0xcd,0xe2,0x75,0x4e,0xa4,0x82,0x9a,0x54,0x7a,0xc5,0xb3,
+    0x37,0x69,0x11,0x15,0x71,0x9a,0x7c,0x15,0x4d,0x8b,0x34,0x3b,0x31,0x75,0xc3,0x3e,
+    0x92,0x8a,0x12,0x20,0x39,0xbf,0x58,0x82,0x52,0xfe,0x1a,0x90,0xfc,0x0a,0xfd,0x2d,
+    0xc1,0x6a,0x75,0x7f,0x99,0xce,0xd6,0x0b,0x89,0x20,0xe3,0x3f,0xbc,0x5c,0x2f,0x0a,
+    0x01,0xd3,0xa4,0xcf,0x93,0x59,0x4d,0xbd,0x75,0x27,0x5d,0x17,0x79,0xc1,0x57,0x15,
+    0xee,0xb1,0x69,0x37,0x6f,0xd7,0xb8,0x9f,0x46,0xcb,0x55,0x9c,0x5c,0x48,0x1e,0x01,
+    0x68,0xe8,0x5e,0x3f,0x13,0x4f,0x96,0x2b,0x45,0x85,0x84,0x9c,0xaf,0x93,0x29,0x35,
+    0xb3,0x18,0x9e,0xf2,0x35,0x4f,0x0e,0xa6,0x42,0x4f,0xcf,0x9f,0x0e,0xe9,0xee,0x47,
+    0xfa,0x5f,0x0d,0x43,0x7a,0x7c,0xcb,0x8b,0xf5,0xea,0x60,0xc8,0x3e,0x4a,0xec,0xcd,
+    0x1f,0x72,0x08,0x22,0x7d,0xb4,0x79,0x8b,0xfc,0xe3,0x64,0x1e,0x2d,0x72,0xde,0xb9,
+    0xf9,0x69,0x93,0xc2,0x8b,0x34,0x2d,0x09,0xe0,0x8e,0xe0,0x3e,0x23,0xed,0x44,0x09,
+    0xa9,0x47,0xd0,0x78,0xc4,0x2c,0xfc,0xbd,0x8c,0x8a,0x4b,0xfd,0xf5,0x73,0x9c,0x6d,
+    0x5a,0x09,0x16,0x6e,0xdb,0xe5,0xa8,0xc6,0x36,0x5d,0x67,0x2f,0xa1,0x0e,0x20,0x13,
+    0x18,0xf2,0x38,0x39,0x28,0xb1,0xf6,0x98,0xaa,0x4d,0xaa,0x8b,0x75,0xd8,0x46,0x5b,
+    0x19,0xb1,0xe9,0x50,0x8f,0x3b,0x46,0x7c,0x24,0x65,0xd8,0xc1,0x60,0x26,0x3a,0xbe,
+    0xce,0x52,0xb2,0xd4,0x41,0x85,0x77,0x2c,0xb8,0x58,0x82,0xdd,0x06,0xfa,0x51,0xe5,
+    0x3b,0xc3,0xe1,0xa1,0x00,0x88,0xce,0xf3,0x26,0xc0,0xb8,0x06,0x68,0x90,0x80,0xa4,
+    0xe4,0x31,0xa4,0x2c,0xa2,0x61,0xb2,0x71,0x83,0xea,0xb0,0xa5,0x8a,0x96,0x67,0xb5,
+    0x51,0xc0,0x97,0xc8,0xe0,0xb5,0xe4,0x8f,0x2b,0xe5,0x3e,0xea,0xb8,0xdc,0x23,0x49,
+    0xa4,0x41,0x57,0xb1,0x73,0x03,0x0c,0x0a,0xd7,0xa3,0xda,0x24,0xca,0xe6,0xc4,0xcc,
+    0x66,0x88,0x57,0x29,0xa6,0x44,0x72,0xbb,0x89,0x64,0x9a,0xe6,0x5b,0x90,0x54,0x49,
+    0xa0,0xce,0x4b,0x25,0x1a,0x61,0x99,0xc7,0x08,0x8f,0xf2,0x9a,0xdc,0xb6,0x65,0x03,
+    0x76,0x2a,0x91,0x2f,0xa3,0x9b,0x96,0x15,0x58,0xc3,0x0c,0xec,0x1f,0xff,0x68,0xf6,
+    0x38,0x66,0xbd,0x76,0x6b,0xf6,0x90,0xd4,0x3e,0xc9,0x88,0x94,0xce,0x04,0xaa,0xb3,
+    0x74,0xba,0x26,0x07,0xd1,0x2f,0x78,0xf1,0x6c,0xc1,0xe9,0xf4,0xcb,0xdb,0xe7,0xb3,
+    0x3a,0x42,0x8f,0x6a,0xf0,0x82,0xb4,0x38,0x25,0xc8,0x33,0x4a,0xf8,0x37,0xc5,0x81,
+    0x66,0xcd,0xb4,0x12,0x02,0x77,0xf5,0x73,0x7e,0x11,0x27,0xaf,0xc1,0xc8,0x41,0xa3,
+    0x71,0x11,0x27,0x5c,0x25,0x5e,0x4b,0x36,0x37,0x42,0xbc,0x89,0x3e,0x2b,0xe3,0x1a,
+    0x0d,0xd7,0x97,0xf1,0x82,0x1f,0x7c,0x41,0xaa,0x11,0x39,0xa2,0x4c,0x12,0x0f,0xea,
+    0xd0,0x2d,0x95,0x17,0xcf,0xa1,0x06,0xea,0x89,0xae,0x12,0x52,0x52,0x5d,0x22,0x5c,
+    0xdf,0xa5,0x07,0x8d,0x2c,0xfe,0xf8,0xa6,0x95,0xb1,0x1f,0xdf,0x2a,0x14,0x1c,0x09,
+    0xa3,0xd1,0x93,0xf8,0xdd,0xb3,0xa7,0x22,0x7e,0x4a,0x23,0x87,0x51,0xd1,0x3f,0xcf,
+    0x78,0xf4,0xa1,0x04,0xc1,0xed,0xc7,0x8f,0x2b,0xd5,0x97,0x24,0xf2,0x22,0x4b,0x3f,
+    0xf0,0xb7,0xc5,0xed,0x82,0x43,0xe4,0xc1,0x43,0x6e,0xd0,0xef,0xe0,0xa8,0x03,0x20,
+    0x84,0xa4,0xb6,0x4f,0xad,0x24,0x7a,0x9e,0xce,0x6e,0x9f,0xe7,0x2f,0xd2,0x68,0xc6,
+    0x67,0x07,0x75,0x06,0xa5,0x44,0x77,0x1d,0x27,0xb3,0xf4,0x1a,0xdd,0xdf,0x22,0x4f,
+    0x01,0xb7,0xe4,0xe1,0xa3,0x92,0x6e,0x9d,0xbd,0x8e,0x2e,0xf8,0x84,0x0d,0x06,0xb2,
+    0xe5,0x53,0xa9,0xec,0xb2,0x17,0x06,0x7c,0x31,0xde,0x97,0x9d,0xcb,0xe4,0x48,0x78,
+    0x35,0xb8,0xe2,0xd9,0xfc,0xe2,0x05,0x4f,0xb4,0x09,0x0d,0x3d,0xc6,0x68,0x33,0xfb,
+    0x6a,0x54,0x15,0xe0,0xb6,0x56,0x17,0x0e,0x5a,0x1f,0xd8,0x2a,0x2a,0x0a,0x9e,0x25,
+    0xb9,0x36,0xd9,0xbc,0xf9,0x91,0xe4,0xed,0x36,0x7e,0xea,0xc3,0x92,0xf3,0x1f,0xd6,
+    0x3c,0x99,0xf2,0x9f,0x8a,0x86,0x82,0x65,0xbd,0x22,0xb6,0x35,0x69,0x24,0xa9,0x92,
+    0xc3,0x43,0x04,0xd4,0x07,0xce,0x22,0xd4,0x36,0xab,0x5b,0x96,0xa7,0xac,0xb8,0x8c,
+    0x0a,0x06,0x83,0x17,0x97,0x9c,0x41,0x1b,0x6c,0xc1,0x93,0x0b,0xf8,0x74,0x9c,0x33,
+    0x7e,0x33,0xe5,0x1c,0xb6,0x60,0xd7,0x9c,0x21,0x6c,0x18,0x46,0xa0,0x05,0x3b,0x8f,
+    0xa6,0x1f,0x9a,0xca,0x5d,0x65,0xfc,0xea,0x6d,0x57,0xc1,0xbd,0x8a,0x97,0x0c,0xac,
+    0x57,0x33,0x9c,0x3f,0x8d,0xf3,0xd5,0x22,0xba,0x2d,0xbd,0xfd,0x53,0x2d,0x40,0xe5,
+    0x0c,0x28,0xaa,0x16,0x4f,0xbe,0x47,0xa2,0x58,0x67,0xa8,0x93,0xd2,0x0f,0x67,0xb8,
+    0x26,0xda,0x23,0xb0,0x11,0x2f,0xd4,0xd5,0xb0,0xee,0xd9,0x19,0x52,0x29,0xf2,0x6e,
+    0x96,0x8b,0xcb,0xa2,0xa0,0x1c,0x94,0xf0,0x6b,0xf6,0xd7,0x97,0x2f,0xbe,0xc1,0xd5,
+    0x1b,0x52,0x70,0x5e,0x08,0xd2,0xcd,0x0e,0x25,0xb0,0x9e,0x26,0xf0,0xf2,0xd9,0x6d,
+    0x4e,0x2c,0x4f,0x2f,0xa3,0xe4,0x82,0x04,0x52,0x6c,0x1d,0x0c,0xdb,0x9d,0x7a,0xc6,
+    0x71,0x8a,0x1d,0x85,0x4b,0x60,0x2a,0x95,0x82,0xda,0xad,0x77,0xdc,0xef,0xf6,0x21,
+    0xc2,0x34,0x0c,0x8a,0x52,0x68,0x6b,0x0f,0xfa,0xa9,0x95,0xd2,0x20,0x98,0xaf,0xd2,
+    0x24,0xe7,0xef,0x90,0xc4,0x86,0x47,0xfd,0x5d,0x3f,0xf5,0x37,0x53,0xb6,0xd8,0x45,
+    0x8d,0x78,0x3c,0x68,0xea,0x9e,0x7d,0x01,0x1e,0xd7,0xc9,0x8c,0xcf,0x91,0x58,0x66,
+    0x43,0xf6,0xc7,0x3f,0xb2,0x03,0x2a,0x7a,0xd3,0x39,0xdb,0x00,0x1b,0x54,0x70,0x83,
+    0xe1,0x70,0x3b,0x0d,0xe1,0x01,0x8d,0xbe,0x4a,0xae,0x7b,0x88,0xd2,0x69,0xfa,0x74,
+    0xd4,0x0d,0x99,0xca,0xce,0x2b,0xd4,0x6b,0xda,0xd7,0xcf,0xde,0x69,0x23,0x26,0x7c,
+    0xac,0xc8,0xd6,0x7c,0x9b,0x53,0xe4,0x18,0x6f,0x5a,0x1e,0xd3,0xe7,0xb2,0x11,0xdc,
+    0xb5,0xe2,0xbc,0xdf,0x33,0xfb,0xba,0xad,0xd2,0xbc,0xf8,0x73,0x0e,0xdf,0x12,0x5c,
+    0x7c,0x8f,0xb3,0xb7,0x45,0xf6,0x2e,0x7d,0x9d,0xe6,0xff,0xef,0xf7,0xdb,0x3d,0xb1,
+    0xd6,0xcc,0x0e,0x3f,0xec,0x00,0x75,0xbc,0xf0,0xc1,0xff,0x07,0xd6,0x4f,0x0b,0xac,
+    0xed,0x61,0xf5,0xfa,0xd5,0xdb,0x32,0xae,0xb6,0x47,0x54,0x51,0x7a,0xe4,0x37,0x70,
+    0x16,0x9e,0x1d,0x68,0x67,0x72,0xb2,0x3d,0x7e,0x07,0x51,0xd1,0x57,0x8b,0x56,0xab,
+    0x45,0x3c,0x15,0x35,0xf0,0x21,0x45,0x85,0xb6,0x33,0x38,0x9b,0x71,0xd3,0x09,0xd4,
+    0x46,0x89,0x51,0x8d,0x48,0xcf,0x93,0x79,0x5a,0x29,0x83,0xfa,0xbe,0x81,0x81,0x1b,
+    0xb3,0x36,0x6a,0x7a,0x1a,0x15,0x11,0x62,0xe0,0xcf,0x6f,0x5f,0x7d,0xab,0xaf,0xa2,
+    0x2c,0xe7,0x35,0xe0,0xaf,0x39,0x98,0x36,0xe8,0x8b,0x53,0xd4,0x50,0x98,0x51,0xc4,
+    0xf3,0xdb,0x83,0xde,0x61,0x56,0x15,0xc4,0xdb,0x8a,0x1f,0x25,0x59,0x47,0x99,0x17,
+    0x3c,0xa1,0x1a,0xaa,0x34,0x46,0x89,0xa3,0x6c,0xfc,0x12,0x85,0x99,0x6a,0x52,0x33,
+    0x5d,0xad,0x9e,0x11,0x68,0xd5,0x28,0xde,0xd4,0x34,0x8c,0xf2,0xb6,0xa9,0xed,0x4e,
+    0x45,0x57,0xda,0x4b,0xc9,0x77,0x97,0x50,0x47,0xaa,0x1f,0x45,0x4b,0xd9,0x57,0x2f,
+    0xb5,0x7b,0xda,0x5f,0x6f,0xe8,0x55,0x6d,0xd7,0xac,0xb4,0x09,0x07,0xec,0xf6,0x16,
+    0xec,0x09,0xf5,0x0b,0x53,0x91,0xde,0xe3,0x14,0xd9,0x67,0x8c,0xb8,0x93,0xc9,0x6f,
+    0x86,0x73,0x91,0x0b,0x59,0x94,0x03,0x06,0x16,0xc4,0x7f,0x45,0x9a,0xa2,0x60,0x4e,
+    0x2e,0x64,0x95,0x19,0x2d,0x78,0x86,0xa9,0xc2,0x3b,0x20,0xc8,0xd2,0xf3,0xb4,0x60,
+    0x4b,0xbe,0x4c,0xb3,0x5b,0x02,0x9c,0xaf,0x17,0xc8,0xe5,0xab,0x05,0x8f,0x10,0xfb,
+    0x79,0x8c,0x89,0x15,0x44,0x63,0x98,0x59,0x67,0x9c,0x0a,0x78,0x96,0x82,0x6a,0xc6,
+    0x54,0xc5,0xc8,0xce,0xf9,0x3c,0xcd,0x40,0x69,0x36,0x83,0x12,0x44,0xd2,0x4e,0x13,
+    0x54,0x80,0xc3,0x8a,0xe3,0xbb,0xb4,0xb5,0xe9,0x38,0xc3,0x46,0x69,0x5e,0xf7,0x56,
+    0x9a,0xcb,0x38,0xca,0xaf,0x29,0x3f,0xd0,0xde,0x27,0x14,0x6a,0xef,0x71,0x18,0x2a,
+    0x0d,0xc3,0xc0,0x79,0xba,0xe0,0x3a,0x0c,0x2c,0x03,0xf9,0xf9,0xb7,0x5f,0x33,0x0d,
+    0xb3,0xd3,0xb2,0x73,0x37,0x0c,0xab,0xf1,0x4b,0x3b,0xa4,0x53,0x04,0x76,0x01,0xe6,
+    0x72,0xad,0x1a,0xcb,0x46,0x02,0xe4,0x6d,0xd9,0xfe,0xaa,0x31,0xa4,0x35,0xdb,0xbf,
+    0x6a,0x0e,0x6f,0x3d,0x0e,0xb5,0xce,0x79,0xf6,0x44,0x0e,0x46,0x71,0xc1,0x97,0x94,
+    0x25,0x04,0xee,0xe9,0x72,0x26,0x8e,0x51,0x76,0x21,0xaf,0xd7,0x59,0xad,0x80,0xca,
+    0xdd,0xd2,0xf3,0xef,0x45,0xeb,0x5b,0x2e,0xb1,0x6d,0xa9,0x51,0x75,0x65,0x92,0x96,
+    0xbf,0x35,0xe8,0x61,0x7c,0x3a,0x11,0x45,0x7a,0xad,0xaf,0xfb,0xa0,0xaf,0xaa,0x7b,
+    0xe0,0x3f,0x3c,0xec,0xd1,0xf7,0x5f,0x2a,0x29,0xc5,0x02,0xa2,0xd0,0x7b,0x93,0xfc,
+    0x63,0xb4,0x40,0x62,0xd1,0x2e,0x25,0x17,0x4d,0x10,0x5e,0x34,0x49,0x25,0xb4,0xa3,
+    0xa5,0x04,0x13,0x8c,0xcf,0xf8,0x82,0x17,0x5c,0xeb,0x06,0x84,0x00,0x4b,0x93,0x79,
+    0x9c,0x2d,0x0f,0x06,0x4f,0xe0,0x89,0xb7,0xe9,0x9a,0xe5,0xeb,0xf2,0xe4,0x3a,0x4a,
+    0x0a,0xb8,0x3e,0x93,0x9d,0xff,0x24,0xc7,0x4e,0xd9,0xb1,0x46,0x51,0xc6,0xd5,0x1b,
+    0xe9,0xdf,0xf3,0x2c,0x5d,0x0a,0x57,0x2d,0x67,0x68,0x44,0x40,0xf2,0xc6,0xe2,0xa4,
+    0xab,0x2d,0x35,0xbd,0x24,0x14,0x92,0x46,0x17,0xe2,0xef,0xb2,0xef,0x77,0xe5,0xdc,
+    0xf3,0x41,0x7b,0x3a,0xa8,0x97,0xf3,0x3f,0x68,0x5d,0xd3,0x14,0x48,0x4f,0xfe,0x51,
+    0xb7,0xfa,0xa6,0x20,0x2a,0x54,0x3e,0x29,0xcd,0x89,0x51,0xbb,0xab,0xbe,0x3c,0xba,
+    0x82,0xf2,0xd8,0xc7,0xa6,0xe9,0x21,0xf4,0xd7,0xbc,0x40,0xdd,0xb5,0xc0,0x60,0x26,
+    0x05,0x47,0x30,0x2f,0xfb,0x0b,0xa4,0x0d,0x4f,0x82,0xbf,0x69,0x5b,0x8b,0x1d,0xaa,
+    0xe5,0x00,0x40,0xf3,0xcf,0x1d,0x2b,0x1a,0x83,0x12,0x64,0x30,0xd4,0x05,0x13,0x3a,
+    0x92,0xc3,0xf2,0x60,0xdb,0xc8,0x5e,0xe3,0x2b,0xcf,0xaa,0x5c,0x30,0xd0,0x06,0xa3,
+    0xc1,0xe0,0x33,0xfa,0xbd,0x7f,0xbf,0xab,0x63,0x29,0x44,0x4e,0xcb,0x22,0x77,0x48,
+    0x21,0x60,0x94,0x18,0xbb,0xd1,0x2d,0xd2,0xf4,0x2e,0x6c,0x04,0x72,0x07,0x32,0xd8,
+    0xee,0xec,0x92,0x63,0x10,0x10,0xa2,0x21,0x6f,0x03,0x38,0x9e,0x6d,0xaf,0x55,0x95,
+    0xe8,0x52,0xc3,0xf5,0xf8,0xb3,0x47,0xbd,0x5a,0xe9,0x0f,0x56,0x97,0xde,0x5c,0x62,
+    0x91,0x2b,0x5e,0x5f,0x54,0x00,0x88,0x8f,0xdd,0xa9,0x69,0x38,0xdc,0x49,0xad,0x1d,
+    0x88,0xfc,0x26,0xce,0x29,0xbd,0x8a,0x24,0x42,0xb8,0xa7,0x34,0x22,0x09,0x42,0x97,
+    0x18,0xd8,0xca,0xb1,0x6e,0x37,0xb6,0x76,0xf0,0xde,0xc1,0xdc,0x6e,0x54,0x8d,0x10,
+    0xdf,0x8d,0xa7,0x11,0xf1,0x77,0x08,0xfa,0x16,0x31,0x29,0x86,0xcc,0x38,0xa1,0xb8,
+    0x13,0xf5,0xe2,0xee,0x4e,0x77,0x50,0x2e,0x0d,0xf1,0x1d,0x2d,0x14,0x09,0x8f,0x9c,
+    0x54,0xfe,0x4b,0xcb,0x65,0xa9,0xbc,0xa6,0x93,0x4f,0x47,0xfb,0x11,0xea,0x4f,0x53,
+    0xbb,0x7a,0xf6,0x67,0xaf,0x5d,0x3d,0x36,0x93,0xda,0x36,0xc8,0x4f,0x9f,0x5b,0xf2,
+    0xdf,0x35,0x99,0x91,0xcf,0x73,0x7e,0xb8,0x2b,0x5d,0x95,0x20,0xfb,0xa5,0xab,0x1a,
+    0x5f,0x79,0xb6,0x67,0xba,0xda,0xd1,0xef,0xee,0x74,0x85,0x2e,0xd3,0x74,0xb9,0x84,
+    0xfe,0xf3,0x3b,0x04,0x51,0x60,0x3f,0x73,0x9e,0x51,0x3c,0x7f,0x46,0x9e,0xa9,0x04,
+    0xdf,0x96,0x67,0x14,0xc0,0xd6,0x50,0xae,0x6a,0x94,0xdf,0x64,0xa2,0xa9,0xb9,0xfb,
+    0x89,0x99,0xa6,0x42,0xf4,0xeb,0xa7,0x9a,0x9a,0x74,0x69,0x0c,0x91,0x6b,0x94,0x2f,
+    0x4d,0x9a,0xfe,0xf7,0x1f,0x96,0x62,0x76,0x97,0x5f,0x98,0x37,0x4f,0xf9,0xa2,0x55,
+    0xbd,0xee,0x51,0x0a,0xf6,0x96,0x7b,0xbb,0x09,0x61,0x22,0xd6,0x5b,0x23,0xf7,0x97,
+    0x6f,0xe5,0x93,0xe2,0x9d,0xcc,0x00,0xf0,0xd9,0x2c,0x2e,0x4a,0x9e,0x14,0xe1,0x56,
+    0xf5,0xbc,0xbd,0x33,0xfc,0xa1,0xd1,0xb9,0x87,0xca,0x73,0x8a,0xb9,0xbd,0x44,0x7e,
+    0xb0,0x29,0x2f,0xd3,0x38,0x21,0xff,0xcd,0xca,0xdb,0x0f,0x5b,0x8a,0x2c,0x63,0xb7,
+    0x06,0xbc,0x97,0xe4,0x20,0x95,0xad,0x93,0x27,0x84,0x34,0x6b,0x2b,0xe0,0x41,0x99,
+    0x86,0xaa,0x1c,0xba,0x39,0xea,0xec,0x84,0xaa,0xc7,0x98,0x92,0x2f,0xf5,0x8c,0xbb,
+    0x22,0x57,0x3f,0xed,0x6f,0xe8,0xfb,0x3e,0xc9,0xaf,0xa1,0xc9,0x1e,0xc4,0x7b,0xe6,
+    0x3c,0xbd,0x96,0xbf,0xe6,0x04,0xb9,0x4d,0x0c,0x41,0xf7,0xe6,0x63,0x8f,0x6c,0xd7,
+    0xa4,0xf8,0xb3,0xc9,0x7f,0x7f,0x61,0xcb,0xe7,0xee,0x2d,0xa5,0xfd,0x89,0x19,0x6c,
+    0xa2,0x1e,0x5e,0x6f,0x4c,0xcc,0x1b,0x7d,0x81,0xae,0x3b,0xd7,0xae,0x67,0xd1,0x1b,
+    0xa6,0x68,0x3c,0xc0,0xdd,0xca,0xeb,0xdf,0xab,0xe7,0x75,0xdf,0xf5,0xf8,0xf4,0xd6,
+    0xc8,0xd9,0x81,0xa3,0x4a,0x05,0xdb,0xe7,0xc1,0xdb,0x43,0xa5,0xbd,0xf0,0xd2,0xbf,
+    0x78,0xd3,0x59,0xce,0x6b,0x2f,0x1a,0xa1,0x07,0x9f,0x31,0xb5,0x12,0xc4,0xd2,0x0f,
+    0x5a,0xbd,0x24,0xb1,0xe5,0x01,0xe0,0x16,0x82,0xcd,0x55,0xa1,0xbb,0x48,0xd6,0x04,
+    0xbf,0x7a,0xf2,0xfc,0xc5,0xb3,0xa7,0xf7,0x22,0x7a,0xc1,0x93,0x2f,0xd7,0x45,0x91,
+    0x26,0x07,0xd3,0x45,0x3c,0xfd,0xf0,0x55,0x32,0x62,0x1f,0xf8,0xad,0xd8,0xa4,0xb5,
+    0x88,0xce,0x39,0x0e,0xd3,0x3c,0x3f,0x5b,0x44,0x79,0xbe,0xb9,0xc4,0xd4,0xbb,0x92,
+    0xf3,0x35,0x4f,0xd8,0x97,0x7f,0x79,0xf7,0xee,0xd5,0xb7,0xb4,0x0c,0x2e,0x56,0x67,
+    0xe8,0x28,0x16,0x70,0x24,0x05,0xb9,0x88,0x53,0x9e,0x53,0xbb,0x20,0x24,0x5a,0xc5,
+    0x59,0x63,0x0f,0x41,0x2a,0xd3,0x8c,0xb2,0xaa,0xea,0x74,0xa2,0xba,0xd7,0x0b,0x7a,
+    0xff,0x04,0xd7,0xff,0xd4,0x14,0xf3,0x25,0x0a,0xd1,0xfd,0x31,0xfa,0x1f,0xe7,0xab,
+    0x08,0xa5,0x19,0x89,0x71,0x32,0x10,0xe4,0x4b,0xa1,0x88,0xfe,0x80,0xa5,0x89,0xc0,
+    0x57,0xde,0xaa,0x39,0x1b,0x9c,0x96,0x84,0xc9,0xc5,0x25,0x97,0x94,0x3c,0x9f,0x75,
+    0xc7,0x8d,0x8a,0xd0,0xe0,0x38,0xbf,0xba,0xa0,0x05,0xfa,0x24,0x3f,0xd1,0x68,0x91,
+    0x7e,0x72,0x78,0x78,0x7d,0x7d,0xad,0x5f,0xdb,0x7a,0x9a,0x5d,0x1c,0xd2,0x93,0xf6,
+    0x43,0x40,0x68,0xec,0x8a,0x67,0x39,0xd4,0x7f,0xa2,0x99,0xba,0xa9,0x31,0xb9,0xcd,
+    0x4e,0xb3,0xdc,0xd5,0x8d,0xc6,0x2e,0xc5,0xde,0x12,0x75,0x45,0x9b,0xf2,0xbe,0x4c,
+    0x6f,0x4e,0x34,0x03,0x61,0xea,0xda,0xe2,0x4f,0x3b,0x2d,0xb7,0x16,0x34,0xe8,0x5e,
+    0x9c,0x1e,0x63,0xec,0xb9,0x64,0xb3,0x13,0xed,0xa5,0x6d,0x05,0x7a,0x10,0xd8,0xa3,
+    0x20,0xd4,0x4d,0xcb,0x5d,0x98,0x86,0xaf,0xbb,0xe1,0x48,0x1c,0x82,0x70,0x31,0xb6,
+    0x7c,0x4b,0xb7,0x9d,0x91,0x3c,0xbc,0x70,0x3d,0xdd,0x33,0x9c,0x91,0xed,0x99,0xba,
+    0xe3,0xb9,0x2f,0xda,0x7d,0x7f,0x64,0x2f,0x5d,0x33,0xd0,0x4d,0xd3,0x1e,0x79,0xb6,
+    0x6e,0xfa,0xfe,0x62,0xec,0xf8,0x7a,0x18,0x98,0xe5,0x81,0x8c,0x3f,0x06,0x80,0xeb,
+    0xd8,0xea,0xe0,0x04,0xba,0xe7,0x56,0x57,0x9e,0xaf,0x5b,0xa0,0x6d,0xa0,0x9f,0xab,
+    0x87,0x9e,0x39,0x92,0x87,0x16,0x4f,0xe1,0xc2,0xb5,0x75,0xcf,0x34,0xc7,0xf2,0x00,
+    0x9c,0x67,0xae,0x6d,0xe9,0x4e,0xe8,0xe2,0xbe,0xa1,0xfb,0xae,0x3d,0x52,0xd7,0x3e,
+    0xc0,0xd1,0xad,0xcd,0x13,0x98,0x34,0x74,0xc0,0x98,0x96,0xee,0x85,0x60,0x47,0x0f,
+    0xdd,0x60,0x04,0x29,0x4c,0x6b,0x04,0x62,0x61,0x30,0x32,0x3d,0xdd,0x37,0x70,0x70,
+    0xd0,0x66,0xd2,0xc1,0xf5,0xa0,0x15,0x33,0xd4,0x83,0xd0,0x1c,0x5b,0xa1,0x6e,0x78,
+    0x21,0x7b,0x61,0xf9,0xba,0xe3,0xdb,0x23,0x3b,0x34,0xc0,0x91,0xff,0xa2,0xc6,0xf8,
+    0xa3,0xc6,0x72,0xda,0xd9,0x71,0xa2,0xcd,0xe3,0xc5,0x62,0xc2,0xb2,0x8b,0xf3,0x03,
+    0xcb,0x32,0x46,0xcc,0xb2,0x2c,0xfc,0xcf,0x0c,0x86,0x47,0xda,0xe9,0xf1,0x21,0x69,
+    0x1f,0x87,0x8b,0x1e,0xdb,0x90,0xc9,0x55,0x73,0x67,0x4c,0xae,0x9d,0xea,0x49,0xa7,
+    0xf6,0xfa,0x35,0x7c,0xca,0xf4,0x0d,0xe6,0x19,0xf4,0xe0,0x91,0x99,0xee,0x4e,0xb7,
+    0x6a,0x6a,0x20,0x49,0x13,0x7e,0x24,0x77,0xb4,0x4c,0xca,0xad,0x2e,0xe5,0xa5,0xdc,
+    0x22,0x3a,0xb1,0x2c,0x75,0x4d,0x7b,0x6f,0xa6,0xd1,0x6a,0x92,0xa5,0xeb,0x64,0x76,
+    0xa4,0x0d,0x3a,0xe8,0xe1,0xac,0x4b,0x66,0xb9,0xc6,0xc8,0x85,0x77,0x8f,0xc0,0x02,
+    0x5b,0x32,0xdf,0x1d,0x8d,0x7d,0x97,0x8d,0x71,0x35,0x32,0x34,0x76,0x78,0x3a,0xb8,
+    0x43,0x9d,0x94,0x85,0xfa,0x14,0xfa,0xb4,0x5a,0xf3,0x15,0x10,0x65,0xbe,0xfa,0xb9,
+    0xf4,0x6a,0x1b,0x4d,0xbd,0xca,0xab,0x56,0xac,0x3a,0xa6,0x43,0x7f,0x52,0xa9,0x5d,
+    0xca,0x8d,0x68,0x5d,0x32,0x0a,0x02,0xdb,0xb1,0x1d,0x78,0xa8,0x69,0xc3,0x09,0x7d,
+    0x87,0x2c,0xa2,0x7b,0xf8,0x19,0x59,0x86,0x89,0x38,0xb2,0x02,0x8f,0xbd,0x6c,0xc0,
+    0xd9,0xa6,0xab,0x3b,0x6e,0xe0,0x30,0xdb,0xa0,0x68,0xf5,0x6c,0x44,0x8a,0x69,0xe8,
+    0x81,0x13,0xb8,0x81,0xb6,0x69,0x2b,0x3a,0x1b,0x67,0xeb,0x05,0x9f,0xf0,0x2b,0x9e,
+    0xa4,0xb3,0x59,0x65,0xbd,0xd9,0x74,0xc6,0x67,0x1d,0xeb,0xb9,0xa1,0x1e,0xf6,0xdb,
+    0xaf,0xd1,0xf8,0x7d,0x1a,0x27,0x93,0x25,0xea,0xe4,0x4c,0xb5,0xa6,0xab,0x68,0x1a,
+    0x17,0xb7,0x13,0x53,0x35,0x88,0xbb,0x8b,0x18,0x87,0x89,0xa3,0xda,0x66,0x51,0x7e,
+    0x19,0x65,0x59,0x74,0x2b,0x18,0xd3,0x0e,0xab,0x80,0xe9,0x2a,0xa8,0xb2,0xb1,0xb8,
+    0xb1,0x25,0x68,0x60,0xe4,0x37,0x5b,0xea,0xd8,0x5f,0x23,0x78,0x10,0x35,0xf0,0x58,
+    0xd3,0xba,0x33,0x78,0xa4,0x9b,0x1b,0xc6,0x88,0x02,0x6d,0xca,0xc6,0x8e,0x6e,0xbb,
+    0x81,0x1f,0x8c,0x90,0xaa,0x4c,0xc7,0x0f,0x1d,0x36,0x86,0x39,0x43,0xc3,0x84,0xe7,
+    0xdb,0xba,0x1f,0xba,0x68,0x08,0x74,0x0b,0xc6,0x04,0x44,0xa8,0xdb,0x86,0x19,0x22,
+    0x1e,0x2c,0xdd,0x0c,0xbd,0xc0,0x42,0x13,0xa5,0xed,0x30,0xb0,0xa9,0xc9,0xf3,0x4c,
+    0xc3,0x46,0x13,0x12,0xa7,0x63,0x18,0x3e,0x1b,0x87,0xba,0x15,0x98,0x81,0x33,0x1a,
+    0x5b,0x2e,0x30,0x21,0x41,0x03,0x63,0x60,0xdb,0xa6,0x87,0xa0,0xd2,0x0d,0x3b,0x08,
+    0x3d,0x86,0x13,0x33,0xf0,0x0d,0x57,0x60,0x72,0x03,0xc3,0xb1,0xa8,0xc9,0x71,0x6d,
+    0xe4,0x46,0x81,0xdc,0x74,0x6c,0x40,0x19,0xba,0xe5,0x79,0x86,0x37,0x92,0x47,0xc9,
+    0x00,0xc6,0x1e,0xe4,0x60,0x1c,0x0d,0x8b,0xa4,0x30,0x43,0xdb,0xb6,0x11,0xb6,0xba,
+    0x45,0x94,0x16,0x44,0xcb,0x37,0x28,0xf9,0x8a,0x4c,0x2b,0xb0,0x58,0xc8,0xdf,0xa6,
+    0x6d,0x11,0x16,0xdf,0xd8,0x6c,0xf0,0x09,0xad,0xe3,0x3b,0x21,0x48,0x97,0x27,0xb5,
+    0x82,0xd0,0x56,0x9e,0x10,0x94,0x1f,0x18,0x1e,0xe4,0x0a,0x75,0xdf,0x07,0xa7,0xcc,
+    0xa6,0x3b,0x08,0x90,0xb1,0x89,0x00,0xb1,0x6c,0xcf,0x66,0x26,0x09,0xea,0xf8,0x23,
+    0x70,0xee,0x5a,0x96,0x1f,0x30,0x84,0x86,0x61,0x63,0xd0,0x40,0x43,0xe0,0x43,0x53,
+    0x8c,0xa2,0x26,0x08,0x43,0x01,0xe2,0x07,0x9e,0x15,0xc2,0x78,0xba,0x69,0x84,0xc4,
+    0x8d,0x89,0x20,0x0a,0xc4,0xb5,0x1b,0x5a,0x0e,0x35,0xb8,0x8e,0xe7,0x53,0x43,0x10,
+    0x5a,0x18,0x6a,0xc0,0x81,0x15,0x52,0xc8,0x19,0xba,0x63,0x38,0x82,0x30,0x38,0xb0,
+    0x0d,0xa2,0xeb,0xf9,0xe8,0x8d,0x06,0xd0,0x41,0x00,0x9a,0x0c,0x7d,0xd0,0x3b,0x44,
+    0x1f,0x18,0x38,0xb0,0x61,0xe0,0x05,0xda,0x0c,0x3f,0xa4,0xdc,0x86,0xa1,0xcb,0xb7,
+    0xec,0x80,0xd8,0x33,0xa1,0xa3,0x50,0x58,0xcf,0x34,0x41,0x03,0x92,0x7b,0x18,0x74,
+    0x2d,0x57,0x88,0x19,0x84,0x88,0x74,0xe6,0xc3,0x8a,0x26,0x59,0x0f,0x40,0x10,0x3b,
+    0x04,0x04,0xd0,0x78,0x96,0x68,0x08,0x31,0xb4,0x52,0xa6,0xc4,0x00,0x66,0x58,0x42,
+    0x2a,0xcf,0x75,0xad,0x00,0x2d,0x18,0x75,0x3d,0xd8,0x91,0x14,0x68,0x98,0x8e,0x09,
+    0xbd,0x93,0x23,0x79,0x20,0xdb,0x68,0xc2,0x10,0x67,0x38,0x81,0x3f,0x32,0x84,0x27,
+    0x39,0x24,0x25,0x39,0x8b,0x61,0x06,0xe4,0x90,0x30,0x6e,0x88,0x32,0x40,0x77,0x4d,
+    0xd3,0xb5,0x08,0xc2,0xc5,0xa8,0x3b,0x72,0x74,0x2f,0x30,0x6d,0x9b,0x00,0x5c,0xd3,
+    0xb7,0x3d,0x00,0xc0,0xf6,0x16,0xb0,0x79,0x18,0x36,0x81,0x78,0x14,0x02,0x90,0x3c,
+    0x18,0x4a,0xb0,0x4c,0xd3,0x1f,0xc1,0x3c,0x46,0x18,0x08,0x1f,0x87,0x11,0x02,0x61,
+    0x79,0x12,0x84,0x3a,0x38,0x8e,0x45,0x8a,0x45,0xbd,0xe1,0xfa,0xc4,0x8f,0x6b,0xdb,
+    0xf0,0x38,0xf2,0x34,0xcb,0x82,0xbd,0x28,0x07,0x06,0xe4,0xdf,0x2e,0xf9,0xa0,0xef,
+    0x31,0xa0,0x70,0x7c,0x8f,0x02,0xc7,0xd5,0x0d,0xc7,0x0d,0x03,0xb8,0x01,0xfc,0x96,
+    0x02,0x85,0xf4,0x12,0x3a,0x0e,0xf4,0x13,0xe2,0x28,0x7d,0x3b,0x34,0x42,0x9f,0x34,
+    0x68,0x60,0xbc,0x17,0x2d,0x70,0x7b,0x04,0x09,0x2c,0xe9,0xbb,0x56,0x28,0xfc,0x22,
+    0x0c,0x4d,0x97,0xd9,0xe0,0xd1,0xf5,0x0c,0x1f,0xd2,0x05,0x86,0xe5,0xc0,0xb9,0x20,
+    0x1d,0x20,0x82,0x11,0xb0,0x59,0x16,0x6c,0x05,0x75,0x78,0x26,0x12,0x2f,0xdc,0xd0,
+    0x46,0xe4,0x79,0xd0,0x9c,0x8b,0x62,0x86,0x4a,0x26,0x00,0x30,0x07,0x22,0x05,0x96,
+    0x4b,0xba,0xf5,0xfc,0x40,0x46,0x2b,0x5c,0xcf,0xb7,0x88,0x2f,0x90,0x0c,0x84,0x95,
+    0x2c,0x48,0x65,0x0a,0x37,0xf1,0x60,0xdb,0x90,0x51,0xf8,0x86,0xd4,0x0b,0xd2,0xc0,
+    0x15,0x2c,0x1b,0x64,0x02,0x2b,0x24,0xce,0x50,0x93,0xd9,0xa1,0x45,0x0e,0xeb,0x7b,
+    0x06,0xa9,0x84,0xb4,0x0b,0xed,0xa0,0xdc,0xc0,0x1d,0x07,0x7e,0x64,0xe8,0x88,0x34,
+    0x0f,0xd2,0xd9,0x88,0x23,0x0b,0x66,0xb0,0x1d,0x8a,0x4a,0x44,0xa0,0x09,0x9e,0x90,
+    0x69,0xa0,0x5d,0x33,0x10,0x76,0x81,0x8c,0xe0,0xc4,0x42,0x8e,0x30,0x70,0x93,0x82,
+    0x3d,0xb0,0x03,0xc7,0x85,0x30,0x96,0xe3,0x98,0x3e,0x25,0x1b,0x28,0x11,0x91,0x03,
+    0x08,0xb8,0xa8,0x47,0x71,0xec,0x98,0x21,0xc4,0x45,0xa8,0xfb,0xa8,0x02,0x29,0xb4,
+    0x42,0xcf,0x21,0x5b,0x42,0x19,0x28,0x96,0x90,0x4a,0x3c,0xf8,0x29,0xd4,0x83,0x10,
+    0x74,0x3c,0x86,0x18,0x44,0x1e,0x73,0xa1,0x10,0xa4,0x8f,0xd0,0x35,0x3c,0x38,0xb7,
+    0x41,0xfe,0x04,0x59,0xa1,0x07,0x84,0x79,0x40,0x47,0xf0,0x49,0x0d,0xae,0xed,0x41,
+    0x34,0xa4,0x0f,0xc3,0xa5,0xaa,0x0c,0x71,0xe4,0x20,0x06,0x59,0x48,0x8c,0xda,0xa4,
+    0x63,0xa4,0x54,0x1b,0x10,0xe4,0xe0,0x9e,0xe3,0x80,0x0b,0xc3,0x40,0x9a,0x02,0x0e,
+    0xd7,0x80,0xc7,0x12,0x0e,0x28,0x1f,0xd1,0x3a,0x16,0x96,0x84,0xf5,0x41,0x3e,0x34,
+    0x2d,0xe2,0x1b,0x16,0xf7,0x88,0x4f,0xb0,0x43,0x92,0x99,0x54,0x3e,0x92,0xa1,0x4d,
+    0xd7,0x47,0xb8,0x2f,0x44,0x62,0x0d,0x5c,0x5f,0x84,0xaf,0xef,0x9b,0x20,0x8b,0x50,
+    0x03,0x76,0xdb,0xa7,0x98,0x73,0x42,0xe4,0x24,0xd5,0x12,0xa8,0x16,0x8b,0x94,0x88,
+    0x00,0x25,0x42,0x26,0x31,0xe7,0x7b,0xaa,0xc5,0xa9,0x5b,0x90,0x42,0x29,0x3b,0x52,
+    0xe8,0x21,0x15,0x87,0x22,0x98,0x31,0x32,0xc3,0xf3,0x60,0x45,0xa4,0x94,0x80,0x82,
+    0xd9,0xf3,0xc9,0xab,0xa8,0x36,0x76,0x29,0x63,0xc1,0x13,0x0c,0x2a,0xb6,0x6d,0x07,
+    0x84,0x6c,0x64,0x00,0x0b,0xb5,0xab,0x8f,0xb2,0x12,0x15,0xab,0x81,0x48,0x86,0x6b,
+    0x42,0xd3,0x30,0x09,0xa1,0x75,0x50,0x74,0x22,0x43,0x21,0x65,0x7b,0xa8,0x6c,0x11,
+    0xcf,0x1e,0x62,0x55,0x38,0x56,0x68,0xc3,0x8f,0x46,0xd4,0x97,0xca,0x67,0x91,0x98,
+    0x2d,0xdb,0x24,0x73,0x5a,0x16,0x65,0xf7,0x40,0x14,0x0b,0xf6,0x88,0x6a,0xe8,0x20,
+    0x64,0x28,0x68,0x37,0xc6,0xaa,0x56,0x85,0x3b,0xc0,0xdc,0xe7,0x40,0x4d,0xf6,0xd8,
+    0x9f,0xd8,0xe0,0xa1,0x1f,0x7c,0xf9,0xd5,0x99,0x39,0x60,0x93,0x7a,0x73,0xf3,0x10,
+    0x40,0x83,0xcf,0xab,0x7c,0x3b,0x2b,0x6e,0x0a,0x5c,0x0c,0xeb,0x4d,0xd8,0x7a,0xfa,
+    0x76,0x48,0xf3,0x37,0x31,0x19,0xdb,0x32,0xeb,0xac,0xa6,0xb1,0x6c,0x7c,0x2a,0x66,
+    0x92,0x59,0x91,0xb4,0x76,0x04,0x64,0xbc,0x58,0x67,0x89,0xa0,0xd5,0x3f,0x0b,0xa6,
+    0x4d,0xb7,0xe5,0x4c,0x58,0x6c,0x48,0xc4,0x44,0x72,0x63,0x0a,0xdc,0x9e,0x88,0x97,
+    0x28,0xeb,0x19,0xb4,0x56,0x6d,0xde,0x7d,0xaf,0x35,0xe6,0xbd,0xef,0xb5,0x51,0x73,
+    0x8b,0xe4,0x50,0xeb,0x47,0x4e,0x3b,0x1d,0xa1,0x9c,0x2d,0x93,0xf4,0xe6,0x26,0xa5,
+    0x7a,0xbb,0x96,0x78,0x6a,0x73,0x8f,0x5d,0xc8,0x04,0x7f,0x29,0xb0,0x3c,0x8d,0xaf,
+    0x76,0x3c,0xe3,0xd1,0x56,0x15,0x39,0x6d,0xd8,0xee,0x5a,0xce,0xc8,0x8f,0x67,0x40,
+    0x50,0x4e,0xa8,0x09,0x78,0x2c,0xd1,0x8a,0xbd,0x45,0xd4,0xb1,0x9a,0x3a,0xab,0x3e,
+    0x8f,0xb7,0x77,0x1a,0xd3,0x9e,0xaa,0xbe,0x0e,0x83,0x63,0xf9,0xda,0x02,0x8b,0x51,
+    0x42,0x35,0x36,0x5e,0x95,0x38,0x04,0x97,0xa2,0x73,0x45,0xb6,0x2a,0xdd,0xc8,0x87,
+    0xbb,0x6f,0x80,0xc0,0x61,0xeb,0x6a,0xae,0x0d,0x50,0xbe,0xdd,0x41,0x10,0xa7,0xaf,
+    0xd2,0x55,0x7e,0x7c,0x28,0x29,0x2b,0xe7,0x6d,0x31,0x75,0x08,0x31,0x7a,0x6e,0x6c,
+    0x15,0x8f,0x5e,0xad,0xe8,0x13,0xaf,0xb3,0x70,0x47,0x4f,0x44,0xf6,0xa7,0xb6,0x79,
+    0x43,0x18,0x55,0x8f,0x93,0x84,0x67,0xdf,0xbc,0x7b,0xf9,0x02,0x56,0x2a,0xc1,0xb7,
+    0x2c,0xfb,0xa4,0xb3,0x5b,0x52,0x59,0x9c,0x5c,0x94,0xdb,0x4d,0x9a,0x9e,0x45,0x8f,
+    0xee,0xd2,0x04,0x55,0xfb,0x82,0xe5,0xf2,0xee,0xc6,0xa2,0x4c,0x53,0x5c,0x7a,0x87,
+    0x61,0x7c,0x81,0x69,0xc2,0x4a,0x98,0xe2,0xeb,0x2c,0x9a,0x99,0x52,0x64,0x51,0xc0,
+    0xa7,0x7d,0x2a,0xaa,0xfb,0x94,0x8a,0x1a,0x9c,0x96,0x24,0xa5,0x68,0x5a,0x77,0x11,
+    0xa7,0xdb,0xb7,0x7a,0x0a,0xb9,0x3f,0xe8,0x98,0x96,0xf6,0x01,0x0f,0x4b,0xb7,0x63,
+    0x5e,0x3b,0xe4,0x37,0x7c,0x8a,0x5c,0xb6,0xce,0xc5,0x2e,0x4c,0xfa,0x7b,0x5d,0x5e,
+    0x74,0x50,0x9c,0x8b,0x1e,0x22,0x01,0x6a,0xf7,0xe4,0xf4,0x2e,0xf2,0x19,0xcf,0x11,
+    0x8f,0x8a,0xfe,0x1b,0x75,0xf5,0xab,0x32,0x20,0x26,0x53,0x35,0x07,0xe5,0xe5,0x5e,
+    0x2c,0xdc,0x61,0xeb,0x45,0x9c,0x17,0x0d,0x06,0xb4,0xe3,0x88,0x5d,0x66,0x7c,0x7e,
+    0x32,0xa8,0x5f,0x14,0x9d,0x5c,0xa5,0xf1,0xec,0xc0,0x18,0x36,0xd6,0xe4,0xaa,0x7d,
+    0x76,0xef,0xdb,0x1b,0xed,0x90,0x56,0xfb,0x53,0xdd,0x70,0x70,0x4a,0xdb,0xf7,0x8e,
+    0x0f,0xa3,0x92,0x4c,0xbf,0x8a,0xee,0x6e,0xbd,0x73,0xcc,0x78,0x5d,0xee,0x9d,0x90,
+    0x1b,0x45,0x5b,0xc1,0xa3,0x6e,0x6d,0x44,0x0f,0x29,0x61,0xbf,0x00,0xb2,0x2a,0xbf,
+    0x56,0x7d,0xf6,0x88,0x20,0x45,0x77,0xff,0x9e,0x91,0xe0,0x2f,0xef,0x23,0xd6,0x18,
+    0xda,0x1a,0xdb,0x10,0xdf,0xd3,0x53,0x2e,0x68,0xff,0x3d,0x3d,0x2f,0x14,0xc7,0xf7,
+    0xda,0x50,0x79,0x0c,0x2d,0x63,0x29,0x6f,0x91,0xf8,0x4b,0x57,0x69,0x0d,0x6f,0x6d,
+    0xbe,0x9a,0x3a,0xdf,0xef,0x46,0x9f,0x67,0x55,0x02,0xbc,0x3a,0xff,0x1e,0x3a,0xd7,
+    0x31,0xc6,0xe6,0x07,0x77,0xec,0xda,0xd1,0xe7,0x69,0xf6,0x2c,0x9a,0x5e,0x1e,0x54,
+    0x1b,0xfe,0x69,0x64,0x46,0x1f,0x7e,0x53,0xbd,0x4b,0x7a,0x27,0x61,0xb1,0x20,0x22,
+    0xa9,0xd7,0x4f,0x74,0xf7,0xe9,0x57,0x86,0xc2,0xd1,0x06,0x9d,0x6e,0x68,0x96,0xfc,
+    0x1e,0x6a,0x8f,0x45,0xe1,0xa0,0xa9,0x0a,0xa2,0x47,0xcd,0xc3,0xa3,0x1e,0xae,0x9b,
+    0x7a,0xdc,0x83,0xaf,0xae,0x47,0xdc,0xc7,0x25,0xe8,0x99,0xaa,0x38,0x11,0x0b,0xf2,
+    0xd2,0x31,0x24,0xd3,0x62,0xd5,0x7c,0x0f,0xd7,0xd8,0x97,0xf5,0xea,0x8e,0x54,0xf7,
+    0xa7,0xee,0x83,0xf9,0xed,0xc0,0xbb,0x21,0x5a,0xc5,0x5d,0x09,0xd2,0x1f,0xfe,0x6f,
+    0xd5,0x93,0x36,0x19,0xff,0xac,0x0a,0xfe,0xea,0xc6,0x4f,0x88,0x7e,0xfb,0x73,0xa2,
+    0xbf,0x22,0xfc,0x8b,0x86,0x7f,0xce,0x7f,0xf8,0x5d,0x87,0x7f,0xfd,0x38,0xf5,0x77,
+    0x12,0xff,0x8a,0xe1,0x7f,0x59,0x02,0x20,0xd7,0xfd,0xcb,0x93,0xd2,0x71,0x7b,0x7d,
+    0xa1,0x7e,0x4e,0xdc,0x8c,0xfe,0x11,0x0d,0xc0,0x07,0x07,0x5b,0x9f,0x50,0x03,0xaa,
+    0xf9,0x78,0x7a,0xa8,0x1e,0x46,0x8b,0xba,0x62,0xb8,0x33,0xfd,0x08,0x76,0x54,0x6e,
+    0x69,0x2c,0x03,0xf7,0x29,0x85,0xc9,0xc3,0x38,0xa7,0x35,0xea,0xe4,0x02,0xce,0xb8,
+    0x37,0x47,0xfb,0x67,0x40,0xa5,0x89,0xdf,0x7f,0x06,0x6c,0x42,0x6c,0xe4,0xc1,0xfe,
+    0x17,0x8c,0xa0,0x94,0x6f,0xd2,0x25,0xaf,0xdf,0x9a,0xf9,0x69,0x73,0xd4,0x55,0x89,
+    0x67,0x8f,0x59,0x2a,0x81,0x69,0xea,0xc5,0x6a,0x4a,0xbe,0xd4,0x20,0x66,0x3e,0x71,
+    0xf9,0xc2,0x4a,0x3b,0xef,0x6e,0x99,0xf9,0xf4,0x25,0xbf,0x76,0x79,0xd7,0x07,0xd1,
+    0x19,0x01,0x14,0x17,0x0d,0xf6,0x5b,0xf3,0xb1,0x5a,0x8b,0xe5,0x78,0xd2,0xd5,0x21,
+    0x79,0x08,0xe9,0x50,0x3a,0x55,0xde,0x7e,0xe3,0xa3,0xdc,0x78,0xd1,0x7a,0x05,0x72,
+    0xdf,0x61,0xe5,0x73,0x06,0x93,0x5f,0x74,0x0c,0xe9,0x79,0xc1,0x43,0x04,0x8d,0xdc,
+    0xbb,0xd8,0x8d,0x1f,0xf5,0x92,0x8b,0x7a,0xa8,0xf7,0xb3,0x0d,0x31,0xbf,0xb8,0x3c,
+    0xf4,0xea,0xc4,0x56,0x69,0x68,0x63,0xe5,0xef,0x48,0x16,0xb9,0x0f,0x71,0xab,0x34,
+    0x67,0x72,0x9b,0xe2,0x2f,0x32,0xfc,0xef,0x4a,0x43,0x3d,0xb3,0x32,0x8a,0xa3,0xba,
+    0x28,0xdb,0xd8,0xe7,0xbc,0x6f,0x36,0xea,0x79,0x01,0xe3,0x5b,0xb9,0xbb,0xba,0x7f,
+    0x63,0x5e,0x7f,0x17,0xca,0x21,0xb4,0x03,0x89,0x36,0xbb,0x32,0xb9,0xb3,0x9e,0x06,
+    0x70,0xb1,0xa5,0x5e,0xd3,0xba,0x3b,0x5d,0xcb,0xf7,0x2d,0xbe,0xdd,0xef,0x9d,0x88,
+    0x6a,0x11,0xb5,0x4d,0xe7,0xee,0xad,0xfe,0x84,0xff,0xbb,0x5e,0x7e,0xff,0x05,0x99,
+    0xb7,0xcd,0x06,0x30,0x95,0xaf,0x82,0x49,0xe7,0xc9,0xb7,0x8e,0x59,0x3d,0x19,0x53,
+    0x6c,0xd5,0x1c,0x29,0x4b,0xf5,0x22,0xff,0x2a,0xe6,0x8b,0x59,0xbe,0xe9,0x6f,0xb4,
+    0xb7,0xb9,0x15,0x40,0xd4,0xd0,0x9f,0x06,0xe7,0x02,0x05,0x2f,0xda,0xe0,0x65,0xe3,
+    0x7e,0x99,0x93,0x90,0x37,0x2a,0xc7,0xfd,0xc0,0x69,0xc5,0x78,0x70,0x4a,0x92,0x6d,
+    0x0f,0x1b,0x5a,0x6d,0x8c,0x32,0x1e,0xd1,0xa2,0x69,0xf5,0x8e,0x14,0xcb,0xd2,0x6b,
+    0xa0,0x32,0x07,0x9b,0x48,0x05,0xdb,0x72,0x45,0x46,0xf9,0x9d,0x58,0x34,0x51,0x78,
+    0xf6,0x9e,0x36,0xfd,0x62,0xf2,0x8a,0x4f,0xcb,0x30,0x7e,0xb3,0xca,0x78,0x4e,0x0f,
+    0xe9,0xf3,0xfd,0x85,0x97,0xaf,0x56,0x6d,0x13,0x9a,0x4d,0xd3,0x05,0x9a,0x5d,0xa3,
+    0xd2,0x8f,0x51,0x29,0x42,0x45,0x93,0x2e,0xdf,0xe0,0xfa,0x8d,0xa9,0x84,0xbe,0x99,
+    0xf3,0x79,0x1a,0x11,0xaf,0x87,0xfd,0x24,0x85,0x88,0x77,0xd0,0x3e,0x47,0x1f,0xdb,
+    0x21,0x54,0xe8,0xdc,0x05,0x06,0x4e,0xf7,0xd7,0xfd,0xdd,0x55,0x58,0x6b,0x10,0xa1,
+    0x12,0xba,0x33,0xbb,0xff,0x85,0x86,0x11,0xcc,0x14,0xee,0x3b,0x8c,0xa8,0x09,0x4a,
+    0x35,0x8e,0xd4,0x6f,0x4d,0x60,0xb8,0xee,0x1b,0x43,0x14,0x91,0xfb,0x6c,0x2a,0xee,
+    0x50,0xd9,0x63,0x5f,0xf3,0xbf,0xed,0x30,0x42,0xaf,0x3a,0x8f,0x94,0xa5,0xfe,0xe3,
+    0x87,0x11,0xf5,0xee,0xda,0x7e,0xc3,0x88,0x72,0xbd,0xdf,0x58,0xce,0x3c,0x53,0xef,
+    0xb6,0xa5,0x59,0xb5,0x3c,0xbf,0xbf,0xfc,0xd5,0xc3,0xa6,0x7b,0xe7,0xce,0x66,0x54,
+    0xe9,0xd5,0x0b,0x76,0xff,0x7e,0x09,0x74,0xf3,0x81,0x75,0x67,0x29,0x40,0xa5,0xa6,
+    0xfe,0x37,0x60,0xca,0xf7,0xf5,0x68,0xef,0xe6,0xa0,0x7c,0x8d,0x66,0x50,0xbe,0x40,
+    0xd0,0x2d,0xea,0x8f,0xda,0xfb,0x01,0xef,0xc6,0x57,0xbe,0x59,0xd3,0xc0,0xd7,0xca,
+    0xee,0x47,0xed,0xad,0x09,0xe5,0x77,0x41,0xda,0x0b,0x1a,0x7d,0x9f,0x66,0x68,0xef,
+    0xae,0xaf,0x97,0x3c,0xaa,0x7d,0x00,0xda,0x21,0x32,0x5e,0xe3,0xcb,0x10,0xbd,0xdf,
+    0x61,0x69,0x7d,0x0c,0xec,0xf8,0x50,0x3e,0x08,0xab,0xbe,0xaa,0x4a,0x1b,0x33,0xe8,
+    0xeb,0xa9,0xe4,0x6e,0x62,0xc6,0x4f,0x2f,0xaa,0x24,0xc5,0x78,0x1e,0x2d,0xe3,0xc5,
+    0xed,0x84,0xd1,0x47,0xec,0xd6,0xd9,0x2d,0xfb,0x3a,0x2d,0x2e,0xe3,0xa9,0x20,0x91,
+    0x8f,0x31,0x9b,0x8b,0xe7,0xf2,0x9b,0x9f,0x14,0x2b,0x63,0xf9,0xd0,0x7b,0xc2,0x4c,
+    0xdd,0x11,0xc3,0x8b,0x42,0x92,0xc7,0x3f,0x72,0xb4,0x3a,0xab,0x42,0x36,0x12,0x3b,
+    0x17,0x62,0xb3,0xe7,0x18,0xde,0x9c,0x66,0x13,0xc6,0x1e,0x3e,0xb3,0xcf,0x9e,0x3e,
+    0xf1,0xe4,0xfd,0xb2,0xf1,0xe1,0xd4,0xa0,0x5f,0xc1,0xf7,0x12,0xf3,0xbf,0x38,0x99,
+    0xc8,0x57,0x5a,0x48,0x3f,0x7a,0xe3,0xd1,0xb7,0xe4,0x77,0x25,0x3f,0xf0,0x31,0x2e,
+    0xe8,0x1d,0x62,0xcb,0x58,0xdd,0x1c,0xb5,0x9a,0xcf,0x53,0xa4,0xe7,0x65,0xf3,0xce,
+    0x5d,0x6c,0xc8,0x8d,0xaa,0xf4,0x91,0xbe,0x3f,0x6c,0x0a,0xa3,0xbb,0x4a,0x44,0xc5,
+    0xed,0xdc,0xa0,0x5f,0xd9,0x46,0x11,0x37,0x8e,0x16,0xf1,0x05,0x58,0x9e,0x42,0x75,
+    0x3c,0xeb,0xe3,0x5b,0x3c,0xb2,0x97,0xeb,0x2b,0x52,0x3e,0xc1,0xbb,0x59,0x32,0xf8,
+    0xa0,0x69,0x80,0xb3,0x74,0xb5,0xe2,0x19,0x3c,0xa0,0xe0,0x23,0xd6,0xb8,0x28,0x0d,
+    0xc2,0x5e,0x90,0xe6,0xbb,0x66,0xd9,0xa0,0x27,0x36,0x31,0x88,0xcf,0xdc,0x35,0xee,
+    0x51,0xa3,0xe0,0xe1,0x3c,0xcd,0x00,0x34,0x61,0x62,0x37,0xaf,0x02,0x69,0x3d,0x90,
+    0x15,0x60,0xa5,0x5a,0x02,0xa9,0x15,0xc5,0xf9,0x82,0xcf,0x8b,0x49,0xb4,0x2e,0xd2,
+    0x66,0x63,0x26,0xfc,0xa1,0x6a,0xed,0xb5,0xd0,0x83,0x8e,0x81,0x6a,0xfb,0xcc,0xa4,
+    0xcb,0x4f,0xd8,0x7c,0xc1,0xcb,0xa6,0xef,0xd7,0x79,0x11,0xcf,0x89,0x21,0xf1,0x35,
+    0xa3,0x09,0x2d,0xb5,0xf2,0xf1,0x39,0x2f,0xae,0x39,0x4f,0x94,0x27,0xe6,0x30,0x12,
+    0xf9,0xf3,0x98,0xbe,0xf1,0xb1,0x4b,0x1c,0xb1,0x34,0xfe,0xb1,0xff,0x96,0x1c,0xcd,
+    0x3f,0x56,0x76,0x50,0x66,0xb7,0xa4,0xd9,0x1f,0x54,0x56,0x8f,0xe6,0x53,0xde,0xc1,
+    0x2f,0xd6,0x24,0x1a,0xa5,0x5c,0xed,0x68,0x13,0x36,0xbe,0xe6,0xe7,0x1f,0x62,0xb9,
+    0x9a,0x1f,0x65,0x00,0x45,0x7d,0x01,0x49,0x0e,0xa0,0x93,0x11,0x7b,0x78,0x1e,0x46,
+    0x41,0x10,0x30,0xe3,0x0f,0x38,0x9f,0x86,0xe7,0x5e,0x48,0xdb,0xb7,0x56,0x37,0x23,
+    0xe5,0x98,0xc2,0x19,0x87,0x3d,0xd4,0x1a,0x91,0xd0,0xb2,0xc8,0xa6,0x9a,0xdb,0xca,
+    0x57,0x62,0x78,0x8e,0x6b,0xd9,0x53,0xd1,0x24,0x7c,0xb7,0xc8,0xe0,0x49,0x94,0xc7,
+    0x27,0xc8,0x3f,0x70,0x36,0x7a,0xdf,0xf8,0x68,0x43,0x19,0x86,0x54,0x46,0x97,0x97,
+    0x72,0x39,0xfc,0x63,0x3b,0x3c,0x2a,0x45,0xd1,0x17,0x25,0x73,0xb4,0xad,0xd2,0xb8,
+    0x15,0x19,0x1b,0x18,0xc6,0xf4,0x39,0x24,0x19,0x1f,0x87,0x8f,0x56,0x69,0x1e,0x53,
+    0x3e,0x9c,0xb0,0x8c,0xd3,0xb7,0x5b,0xaf,0xf8,0xd1,0xa3,0x43,0x79,0x4b,0x48,0x3a,
+    0x76,0x48,0x26,0xd5,0x44,0x52,0xba,0xd5,0xf5,0xdd,0x04,0xcb,0xf5,0xab,0x86,0xd1,
+    0x5a,0x2e,0x5c,0x2b,0x6c,0xbe,0x48,0x23,0x5c,0x67,0xea,0xcb,0xac,0xfd,0x88,0xda,
+    0x4e,0x45,0x45,0x4d,0x2b,0x47,0x4d,0x98,0xb9,0x23,0x0b,0x3d,0xb4,0x0d,0xfa,0xfd,
+    0xbc,0x24,0x24,0x7e,0xda,0x8c,0x89,0x52,0x51,0x68,0xb1,0x8a,0xa8,0xf3,0x45,0x3a,
+    0xfd,0xd0,0x18,0x59,0xa7,0x0b,0x38,0x23,0x9a,0x53,0xf9,0xd5,0xda,0x76,0x5f,0xe1,
+    0xab,0x1f,0x1b,0x3e,0x24,0x34,0xdb,0x03,0x46,0x05,0xd0,0xc7,0xda,0xab,0xa2,0x1f,
+    0xd7,0x19,0xef,0x81,0x13,0x55,0x44,0x33,0x95,0x28,0xe1,0x1e,0x34,0x03,0xe5,0xe1,
+    0x93,0x20,0x34,0x3c,0xab,0xe9,0xa5,0xd7,0x97,0x71,0xb9,0x7c,0x5f,0xa6,0xaa,0xcd,
+    0xd0,0x56,0x15,0xca,0x1d,0x09,0x8d,0x92,0x44,0xc3,0xd6,0x95,0x59,0x4a,0xc1,0xda,
+    0x21,0xd4,0x9f,0xd5,0xea,0xe6,0x8e,0x14,0x6d,0x2a,0xb5,0xf2,0x94,0xf2,0x95,0xee,
+    0x6b,0x75,0x56,0xde,0xf0,0x60,0xab,0x1d,0xaa,0x27,0x79,0x6d,0x3b,0xc6,0x89,0x18,
+    0x78,0x2b,0x94,0xbd,0x1e,0xa6,0x22,0xbf,0x9d,0x10,0x30,0xbb,0x78,0x54,0x72,0x6e,
+    0xb9,0x7f,0x90,0x81,0xd2,0xf1,0x2e,0x6b,0xc3,0xbb,0x7a,0x92,0x5d,0xf3,0x51,0xde,
+    0xfd,0xc3,0xa7,0x9d,0x96,0x14,0xcf,0x3d,0x72,0x33,0xf1,0x6e,0xdd,0xc7,0x7a,0x74,
+    0x9d,0xf1,0x69,0x9a,0x45,0x32,0x23,0x28,0x03,0xdf,0x3b,0xdb,0x08,0xf4,0xf4,0x28,
+    0xad,0x46,0xff,0xe0,0x4e,0x61,0x7b,0xd3,0x5b,0xe8,0xcc,0x6d,0x19,0x78,0x3b,0x09,
+    0x8a,0xef,0x40,0x5d,0xb0,0x3e,0xdf,0x2b,0x75,0xd4,0x51,0xa0,0xd0,0x8b,0xdd,0xbe,
+    0xf5,0xd9,0x85,0x49,0xcd,0x47,0x34,0xbb,0xa2,0x75,0xf4,0x19,0xfb,0xb8,0xd5,0x08,
+    0xdd,0x81,0xb9,0xbe,0xd1,0xcb,0x5a,0x7f,0x2a,0xb3,0x0c,0xfa,0x55,0x00,0x6d,0xc6,
+    0x45,0x53,0x8f,0xc3,0x89,0x76,0x85,0xc0,0x10,0x3f,0xaa,0x75,0x47,0x5d,0xd5,0x16,
+    0x2b,0xda,0xdf,0x55,0x02,0x83,0x7e,0x8f,0x36,0x32,0xb6,0xf4,0x8b,0x8d,0x0a,0xa0,
+    0x3b,0xe4,0x25,0xeb,0xe5,0xbe,0x90,0xfb,0x21,0x6d,0x3d,0x44,0x6e,0xdb,0xa7,0x8c,
+    0x26,0xb3,0x95,0x7f,0xcb,0x3d,0xa9,0xac,0x7c,0xf5,0xac,0x95,0x43,0x1d,0xe4,0x50,
+    0x21,0xdb,0xe6,0x9d,0x67,0x4f,0xec,0xa7,0xf6,0x66,0xd6,0x75,0x0c,0x9f,0x47,0x5e,
+    0x0b,0xbb,0xd8,0x66,0xd9,0x87,0x7e,0x77,0x2d,0x63,0xf3,0xd0,0x3c,0x9f,0x53,0x2d,
+    0xf3,0xd0,0x71,0xc3,0x68,0xea,0xcb,0x52,0xe6,0xa1,0xe3,0x87,0xb3,0x69,0x24,0xdc,
+    0x1d,0x17,0xf3,0x28,0x98,0xd9,0xc2,0x8b,0x70,0x31,0x0d,0x83,0xe9,0xbc,0xae,0x71,
+    0xee,0x41,0xcc,0xe1,0xa8,0x9c,0xa6,0xb2,0x70,0xf2,0x8d,0xe8,0x3c,0x9c,0xab,0xc2,
+    0x49,0x6e,0x2a,0xaf,0x90,0x76,0x05,0xb3,0x3e,0x43,0x30,0xd3,0x73,0xc3,0x99,0x10,
+    0xcc,0x0e,0xbc,0x30,0x32,0x4b,0xc1,0xec,0xd0,0x8b,0x70,0x51,0x0a,0x16,0xfa,0x6e,
+    0x14,0x29,0xc1,0x3c,0xdf,0x8e,0xbc,0xcf,0x12,0xec,0xdc,0x09,0xb9,0x6f,0x4b,0xc1,
+    0xce,0x8c,0x27,0x81,0xff,0x44,0x09,0x56,0x5d,0xb5,0x2a,0x42,0xb5,0xaf,0xe7,0xfe,
+    0x62,0xb9,0xbe,0x6b,0x84,0x8e,0xa4,0xe4,0x72,0xd7,0x0a,0x3d,0x45,0xc9,0x33,0x5c,
+    0xc8,0x26,0x05,0xc3,0x3d,0xdb,0x31,0xbc,0xb9,0x94,0xac,0xba,0xfa,0x2c,0xd1,0xee,
+    0x53,0xec,0x96,0xb3,0xd6,0x72,0x9e,0x7a,0x7c,0x58,0xfe,0xb3,0x23,0xc7,0x62,0xc2,
+    0x9a,0x26,0x18,0x56,0x66,0x27,0x5a,0xfb,0x1b,0xe7,0xf4,0xcf,0x81,0x00,0x82,0x96,
+    0x1a,0xe8,0xdf,0x20,0xa1,0x45,0x1b,0xda,0xe1,0xdd,0xd8,0x74,0x7e,0x2a,0x17,0x22,
+    0xba,0x77,0xc5,0x5a,0x61,0x75,0x4f,0x1d,0xe9,0x8c,0x08,0x48,0xf2,0xf2,0x9f,0x3f,
+    0xf9,0x3f,0xa2,0xa6,0x05,0xf4,0x18,0x65,0x00,0x00
+    };
+
+static const char reso_index_html_gzip_hdr[] = "HTTP/1.1 200 OK\r\n"
+    "Content-Type: text/html\r\n"
+    "Content-Encoding: gzip\r\n"
+    "Content-Length: 6506\r\n";
+
+static const char reso_index_html_gzip_etag[] = "\"f11e590966b1d8b7\"";
+static const char reso_index_html_gzip_cache_hdr[] = "ETag: \"f11e590966b1d8b7\"\r\n"
+    "Vary: Accept-Encoding\r\n"
+    "Cache-Control: no-cache\r\n";
+
+static const RdWebServerResourceVariant reso_index_html_variants[] = {
+    RdWebServerResourceVariant("gzip", reso_index_html_gzip, sizeof(reso_index_html_gzip), reso_index_html_gzip_hdr, sizeof(reso_index_html_gzip_hdr) - 1, reso_index_html_gzip_cache_hdr, sizeof(reso_index_html_gzip_cache_hdr) - 1, reso_index_html_gzip_etag)
+    };
+
 // Resource descriptions
 static RdWebServerResourceDescr genResources[] = {
-    RdWebServerResourceDescr("favicon.ico", "image/ico", reso_favicon_ico, sizeof(reso_favicon_ico)),
-    RdWebServerResourceDescr("index.html", "text/html", reso_index_html, sizeof(reso_index_html))
+    RdWebServerResourceDescr("favicon.ico", "image/ico", reso_favicon_ico, sizeof(reso_favicon_ico), reso_favicon_ico_hdr, sizeof(reso_favicon_ico_hdr) - 1, reso_favicon_ico_cache_hdr, sizeof(reso_favicon_ico_cache_hdr) - 1, reso_favicon_ico_etag, reso_favicon_ico_variants, 1),
+    RdWebServerResourceDescr("index.html", "text/html", reso_index_html, sizeof(reso_index_html), reso_index_html_hdr, sizeof(reso_index_html_hdr) - 1, reso_index_html_cache_hdr, sizeof(reso_index_html_cache_hdr) - 1, reso_index_html_etag, reso_index_html_variants, 1)
     };
 
 static int genResourcesCount = sizeof(genResources) / sizeof(RdWebServerResourceDescr);
+
+// Resource index (perfect hash of lowercased names)
+static const int16_t genResourcesIndexSlots[] = {
+    0, -1, 1, -1
+    };
+
+static const RdWebServerResourceIndex genResourcesIndex(0UL, 4, genResourcesIndexSlots);
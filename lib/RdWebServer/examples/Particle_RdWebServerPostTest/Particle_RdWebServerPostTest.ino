@@ -74,7 +74,7 @@ void setup()
     if (pWebServer)
     {
         // Add resources to web server
-        pWebServer->addStaticResources(genResources, genResourcesCount);
+        pWebServer->addStaticResources(genResources, genResourcesCount, &genResourcesIndex);
 
         // Endpoints
         pWebServer->addRestAPIEndpoints(&restAPIEndpoints);
@@ -0,0 +1,64 @@
+// Posix_EndpointHashTest
+// Rob Dobson 2012-2017
+
+// Checks that the compile time (constexpr) and run time hashes of endpoint names agree - the
+// endpoint table is built with the run time hash and looked up with either
+// Build from the lib/RdWebServer folder with:
+//   g++ -std=c++11 -O2 -DRDWEBSERVER_POSIX -Isrc src/RdPosixWiring.cpp
+//       examples/Posix_EndpointHashTest/Posix_EndpointHashTest.cpp -o Posix_EndpointHashTest
+// Run with:
+//   ./Posix_EndpointHashTest
+// The exit code is the number of checks which failed
+
+#include "RestAPIEndpoints.h"
+
+static int numFailed = 0;
+
+static void restAPI_Dummy(RestAPIEndpointMsg& apiMsg, String& retStr)
+{
+    retStr = apiMsg._pEndpointStr;
+}
+
+static void check(bool ok, const char *pWhat, const char *pName)
+{
+    printf("%s %s %.40s\n", ok ? "ok  " : "FAIL", pWhat, pName);
+    if (!ok)
+    {
+        numFailed++;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    // Hashed by the compiler
+    static constexpr uint32_t emptyHash       = RestAPIEndpoints::hashName("");
+    static constexpr uint32_t getSettingsHash = RestAPIEndpoints::hashName("getsettings");
+    static constexpr uint32_t mixedCaseHash   = RestAPIEndpoints::hashName("GetSettings");
+    check(emptyHash == RestAPIEndpoints::hashNameRuntime(""), "empty", "");
+    check(getSettingsHash == RestAPIEndpoints::hashNameRuntime("getsettings"), "constexpr", "getsettings");
+    check(mixedCaseHash == RestAPIEndpoints::hashNameRuntime("GETSETTINGS"), "case", "GETSETTINGS");
+    check(getSettingsHash == mixedCaseHash, "case", "GetSettings");
+
+    // Names of all lengths up to that of a request which fills the receive buffer
+    String name;
+    bool   allMatch = true;
+    for (int len = 0; len < 2048; len++)
+    {
+        if (RestAPIEndpoints::hashName(name.c_str()) != RestAPIEndpoints::hashNameRuntime(name.c_str()))
+        {
+            allMatch = false;
+        }
+        name += (char)('!' + (len * 7) % 94);
+    }
+    check(allMatch, "lengths 0..2047", name.c_str());
+
+    // Endpoints added (run time hash) are found with a compile time hash
+    RestAPIEndpoints endpoints;
+    endpoints.addEndpoint("getsettings", RestAPIEndpointDef::ENDPOINT_CALLBACK, restAPI_Dummy, "");
+    RestAPIEndpointDef *pEndpoint = endpoints.getEndpoint("GetSettings", mixedCaseHash);
+    check(pEndpoint && (strcmp(pEndpoint->_pEndpointStr, "getsettings") == 0), "lookup", "GetSettings");
+    check(endpoints.getEndpoint("getsetting", RestAPIEndpoints::hashName("getsetting")) == NULL, "no match", "getsetting");
+
+    printf("%d checks failed\n", numFailed);
+    return numFailed;
+}
@@ -0,0 +1,163 @@
+// Posix_MethodTest
+// Rob Dobson 2012-2017
+
+// Checks the response to requests with recognised and unrecognised methods - requests are fed
+// from memory through a transport which keeps the response, one connection per request
+// Build from the lib/RdWebServer folder with:
+//   g++ -std=c++11 -O2 -DRDWEBSERVER_POSIX -Isrc src/*.cpp
+//       examples/Posix_MethodTest/Posix_MethodTest.cpp -o Posix_MethodTest
+// Run with:
+//   ./Posix_MethodTest
+// The exit code is the number of checks which failed
+
+#include "RdWebServer.h"
+
+// Transport with a single connection which is sent one request
+class MemTransport : public RdWebServerTransport
+{
+public:
+    MemTransport()
+    {
+        _pReqStr  = "";
+        _reqPos   = 0;
+        _connOpen = false;
+        _pending  = false;
+    }
+
+    // Make a connection which sends a request
+    void sendRequest(const char *pReqStr)
+    {
+        _pReqStr  = pReqStr;
+        _reqPos   = 0;
+        _pending  = true;
+        _response = "";
+    }
+    bool connOpen()
+    {
+        return _connOpen || _pending;
+    }
+
+    virtual bool isNetworkReady()
+    {
+        return true;
+    }
+    virtual bool begin(int port, int maxConnections)
+    {
+        return true;
+    }
+    virtual void stop()
+    {
+        _connOpen = false;
+    }
+    virtual int accept()
+    {
+        if (!_pending)
+            return -1;
+        _pending  = false;
+        _connOpen = true;
+        return 0;
+    }
+    virtual bool connected(int connId)
+    {
+        return _connOpen;
+    }
+    virtual int available(int connId)
+    {
+        return _connOpen ? strlen(_pReqStr + _reqPos) : 0;
+    }
+    virtual int read(int connId, uint8_t *pBuf, int maxLen)
+    {
+        int numRead = strlen(_pReqStr + _reqPos);
+        if (numRead > maxLen)
+            numRead = maxLen;
+        memcpy(pBuf, _pReqStr + _reqPos, numRead);
+        _reqPos += numRead;
+        return numRead;
+    }
+    virtual int write(int connId, const uint8_t *pBuf, int len)
+    {
+        for (int i = 0; i < len; i++)
+            _response += (char)pBuf[i];
+        return len;
+    }
+    virtual bool reportsSendSpace()
+    {
+        return true;
+    }
+    virtual void flush(int connId)
+    {
+    }
+    virtual void close(int connId)
+    {
+        _connOpen = false;
+    }
+    virtual void getRemoteIPStr(int connId, char *pBuf, int bufLen)
+    {
+        snprintf(pBuf, bufLen, "mem");
+    }
+
+    String _response;
+
+private:
+    const char *_pReqStr;
+    int        _reqPos;
+    bool       _connOpen;
+    bool       _pending;
+};
+
+static int numFailed = 0;
+
+void restAPI_QueryStatus(RestAPIEndpointMsg& apiMsg, String& retStr)
+{
+    retStr = "{\"rslt\":\"ok\"}";
+}
+
+// Send a request and check the status line of the response
+static void checkStatus(RdWebServer& webServer, MemTransport& transport, const char *pReqStr, const char *pStatus)
+{
+    transport.sendRequest(pReqStr);
+    for (int i = 0; (i < 1000) && transport.connOpen(); i++)
+    {
+        webServer.service();
+    }
+    int    lineEnd    = transport._response.indexOf("\r\n");
+    String statusLine = transport._response.substring(0, lineEnd < 0 ? 0 : lineEnd);
+    bool   ok         = statusLine.equals(String("HTTP/1.1 ") + pStatus);
+    printf("%s %.*s -> %s\n", ok ? "ok  " : "FAIL", (int)strcspn(pReqStr, "\r"), pReqStr, statusLine.c_str());
+    if (!ok)
+    {
+        numFailed++;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    MemTransport     transport;
+    RdWebServer      webServer(1, &transport);
+    RestAPIEndpoints restAPIEndpoints;
+    restAPIEndpoints.addEndpoint("Q", RestAPIEndpointDef::ENDPOINT_CALLBACK, restAPI_QueryStatus, "");
+    restAPIEndpoints.addEndpoint("devices/:id", RestAPIEndpointDef::ENDPOINT_CALLBACK, restAPI_QueryStatus, "");
+    webServer.addRestAPIEndpoints(&restAPIEndpoints);
+    webServer.start(80);
+
+    // Endpoints added for any method accept the recognised methods
+    checkStatus(webServer, transport, "GET /Q HTTP/1.1\r\nConnection: close\r\n\r\n", "200 OK");
+    checkStatus(webServer, transport, "DELETE /Q HTTP/1.1\r\nConnection: close\r\n\r\n", "200 OK");
+    checkStatus(webServer, transport, "PATCH /devices/1 HTTP/1.1\r\nConnection: close\r\n\r\n", "200 OK");
+
+    // Methods which aren't recognised don't reach endpoints (or resources)
+    checkStatus(webServer, transport, "FOO /Q HTTP/1.1\r\nConnection: close\r\n\r\n", "501 Not Implemented");
+    checkStatus(webServer, transport, "FOO /devices/1 HTTP/1.1\r\nConnection: close\r\n\r\n", "501 Not Implemented");
+    checkStatus(webServer, transport, "FOO /missing HTTP/1.1\r\nConnection: close\r\n\r\n", "501 Not Implemented");
+    int allowMask = 0;
+    bool notFound = restAPIEndpoints.getEndpoint("Q", RdHttpRequestParser::METHOD_OTHER, allowMask) == NULL;
+    printf("%s getEndpoint Q for METHOD_OTHER\n", notFound ? "ok  " : "FAIL");
+    if (!notFound)
+    {
+        numFailed++;
+    }
+
+    webServer.stop();
+    printf("%d checks failed\n", numFailed);
+    return numFailed;
+}
@@ -0,0 +1,180 @@
+// Posix_RdWebServerTest
+// Rob Dobson 2012-2017
+
+// Runs RdWebServer on a Linux host so that it can be load-tested (e.g. with wrk or ab)
+// Build from the lib/RdWebServer folder with:
+//   g++ -std=c++11 -O2 -DRDWEBSERVER_POSIX -Isrc src/*.cpp
+//       examples/Posix_RdWebServerTest/Posix_RdWebServerTest.cpp -o Posix_RdWebServerTest
+// Run with:
+//   ./Posix_RdWebServerTest [port] [trace]
+
+#include <signal.h>
+#include "RdWebServer.h"
+#include "../Particle_RdWebServerPostTest/GenResources.h"
+
+// API Endpoints
+RestAPIEndpoints restAPIEndpoints;
+
+// Flag set on Ctrl-C
+static volatile sig_atomic_t stopRequested = 0;
+
+static void handleSignal(int sig)
+{
+    stopRequested = 1;
+}
+
+String configStr = "{\"maxCfgLen\":2000, \"name\":\"Sand Table\",\"patterns\":{}, \"sequences\":{}, \"startup\":\"\"}";
+
+void restAPI_QueryStatus(RestAPIEndpointMsg& apiMsg, String& retStr)
+{
+    retStr = "{\"rslt\":\"ok\"}";
+}
+
+void restAPI_PostSettings(RestAPIEndpointMsg& apiMsg, String& retStr)
+{
+    if (apiMsg._pMsgContent)
+    {
+        configStr = (const char *)apiMsg._pMsgContent;
+    }
+    retStr = "{\"rslt\":\"ok\"}";
+}
+
+void restAPI_GetSettings(RestAPIEndpointMsg& apiMsg, String& retStr)
+{
+    retStr = configStr;
+}
+
+// Pattern endpoint (e.g. /devices/lamp%201/settings) - the id is captured from the path
+void restAPI_DeviceSettings(RestAPIEndpointMsg& apiMsg, String& retStr)
+{
+    String idStr;
+    const RestAPIParam* pId = apiMsg.getParam("id");
+    if (pId)
+    {
+        RestAPIEndpoints::formStringFromCharBuf(idStr, pId->_pValue, pId->_valueLen);
+    }
+    retStr = "{\"id\":\"" + idStr + "\",\"rslt\":\"ok\"}";
+}
+
+// Same path as above for PUT
+void restAPI_PutDeviceSettings(RestAPIEndpointMsg& apiMsg, String& retStr)
+{
+    retStr = String::format("{\"rslt\":\"ok\",\"contentLen\":%d}", apiMsg._msgContentLen);
+}
+
+// Streams a JSON array of the numbers 0..N-1 (N is the first argument e.g. /numbers/100000)
+// - the response is sent in chunks so its size isn't limited by memory
+bool restAPI_Numbers(RestAPIEndpointMsg& apiMsg, RestAPIStreamSink& sink)
+{
+    unsigned long count = RestAPIEndpoints::getNthArgStr(apiMsg._pArgStr, 0).toInt();
+    if (apiMsg._streamPos == 0)
+    {
+        if (!sink.write("["))
+            return true;
+        apiMsg._streamPos = 1;
+    }
+    // _streamPos is the next number + 1
+    while (apiMsg._streamPos <= count)
+    {
+        char valStr[16];
+        snprintf(valStr, sizeof(valStr), "%s%lu", apiMsg._streamPos > 1 ? "," : "", apiMsg._streamPos - 1);
+        if (!sink.write(valStr))
+            return true;
+        apiMsg._streamPos++;
+    }
+    return !sink.write("]");
+}
+
+// Upload (e.g. curl --data-binary @file http://host/upload) - the body is passed to the
+// body callback as it arrives and a byte count and checksum are returned - an argument (e.g.
+// /upload/100) limits the bytes consumed on each call to exercise backpressure
+static unsigned long uploadLen = 0;
+static unsigned long uploadSum = 0;
+int restAPI_UploadBody(RestAPIEndpointMsg& apiMsg)
+{
+    if (apiMsg._contentPos == 0)
+    {
+        uploadLen = 0;
+        uploadSum = 0;
+    }
+    int numToConsume = apiMsg._msgContentLen;
+    int maxPerCall   = RestAPIEndpoints::getNthArgStr(apiMsg._pArgStr, 0).toInt();
+    if ((maxPerCall > 0) && (numToConsume > maxPerCall))
+    {
+        numToConsume = maxPerCall;
+    }
+    for (int i = 0; i < numToConsume; i++)
+    {
+        uploadSum = (uploadSum + apiMsg._pMsgContent[i]) % 65521;
+    }
+    uploadLen += numToConsume;
+    return numToConsume;
+}
+
+void restAPI_Upload(RestAPIEndpointMsg& apiMsg, String& retStr)
+{
+    retStr = String::format("{\"rslt\":\"ok\",\"len\":%lu,\"sum\":%lu}", uploadLen, uploadSum);
+    uploadLen = 0;
+    uploadSum = 0;
+}
+
+// Web server
+RdWebServer webServer;
+
+void restAPI_Stats(RestAPIEndpointMsg& apiMsg, String& retStr)
+{
+    RdWebServerStats& stats = webServer.getStats();
+    retStr = String::format("{\"requests\":%lu,\"rxHeapAllocs\":%lu,\"rxOverflows\":%lu,\"rxTooLarge\":%lu,"
+                "\"rxNotImplemented\":%lu,\"rxBodyStreamed\":%lu,\"corsPreflights\":%lu}",
+                stats._requests, stats._rxHeapAllocs, stats._rxOverflows, stats._rxTooLarge,
+                stats._rxNotImplemented, stats._rxBodyStreamed, stats._corsPreflights);
+}
+
+int main(int argc, char *argv[])
+{
+    int webServerPort = 8080;
+    if (argc > 1)
+    {
+        webServerPort = atoi(argv[1]);
+    }
+    if ((argc > 2) && (strcmp(argv[2], "trace") == 0))
+    {
+        Log.setLevel(LOG_LEVEL_TRACE);
+    }
+    signal(SIGINT, handleSignal);
+    signal(SIGTERM, handleSignal);
+
+    // Add endpoints
+    restAPIEndpoints.addEndpoint("Q", RestAPIEndpointDef::ENDPOINT_CALLBACK, restAPI_QueryStatus, "");
+    restAPIEndpoints.addEndpoint("postsettings", RestAPIEndpointDef::ENDPOINT_CALLBACK, restAPI_PostSettings, "",
+                                 RestAPIEndpointDef::METHOD_MASK_POST);
+    restAPIEndpoints.addEndpoint("getsettings", RestAPIEndpointDef::ENDPOINT_CALLBACK, restAPI_GetSettings, "",
+                                 RestAPIEndpointDef::METHOD_MASK_GET);
+    restAPIEndpoints.addEndpoint("stats", RestAPIEndpointDef::ENDPOINT_CALLBACK, restAPI_Stats, "");
+    restAPIEndpoints.addStreamingEndpoint("numbers", restAPI_Numbers, "");
+    restAPIEndpoints.addEndpoint("devices/:id/settings", RestAPIEndpointDef::ENDPOINT_CALLBACK, restAPI_DeviceSettings, "",
+                                 RestAPIEndpointDef::METHOD_MASK_GET);
+    restAPIEndpoints.addEndpoint("devices/:id/settings", RestAPIEndpointDef::ENDPOINT_CALLBACK, restAPI_PutDeviceSettings, "",
+                                 RestAPIEndpointDef::METHOD_MASK_PUT);
+    restAPIEndpoints.addUploadEndpoint("upload", restAPI_UploadBody, restAPI_Upload, "",
+                                       RestAPIEndpointDef::METHOD_MASK_POST | RestAPIEndpointDef::METHOD_MASK_PUT);
+
+    // Configure and start web server
+    webServer.addStaticResources(genResources, genResourcesCount, &genResourcesIndex);
+    webServer.addRestAPIEndpoints(&restAPIEndpoints);
+    webServer.enableMetricsEndpoint("metrics");
+    // Nothing else runs in the loop so wait for network events for as long as the clients allow
+    webServer.setMaxServiceWaitMs(1000);
+    webServer.start(webServerPort);
+    Log.info("Posix_RdWebServerTest listening on port %d", webServerPort);
+
+    // Service the web server until stopped
+    while (!stopRequested)
+    {
+        webServer.service();
+    }
+    webServer.stop();
+    RdWebServerStats& stats = webServer.getStats();
+    Log.info("Requests %lu, heap allocations while receiving and routing %lu", stats._requests, stats._rxHeapAllocs);
+    return 0;
+}
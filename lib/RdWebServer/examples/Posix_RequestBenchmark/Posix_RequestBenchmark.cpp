@@ -0,0 +1,155 @@
+// Posix_RequestBenchmark
+// Rob Dobson 2012-2017
+
+// Measures the request rate of the web server itself - without the TCP stack - by feeding
+// pipelined requests from memory through a transport which discards the responses. Build it
+// with trace logging compiled in (the default) and compiled out to compare the two
+// Build from the lib/RdWebServer folder with:
+//   g++ -std=c++11 -O2 -DRDWEBSERVER_POSIX -Isrc src/*.cpp
+//       examples/Posix_RequestBenchmark/Posix_RequestBenchmark.cpp -o Posix_RequestBenchmark
+// and with trace compiled out by adding:
+//   -DRDWEBSERVER_LOG_LEVEL=RDWEBSERVER_LOG_LEVEL_INFO
+// Run with:
+//   ./Posix_RequestBenchmark [seconds] [trace]
+
+#include <time.h>
+#include "RdWebServer.h"
+
+// Transport with a single connection which always has requests waiting
+class MemTransport : public RdWebServerTransport
+{
+public:
+    MemTransport(const char *pReqStr)
+    {
+        _pReqStr       = pReqStr;
+        _reqLen        = strlen(pReqStr);
+        _reqPos        = 0;
+        _connOpen      = false;
+        _bytesWritten  = 0;
+        _connsAccepted = 0;
+    }
+
+    virtual bool isNetworkReady()
+    {
+        return true;
+    }
+    virtual bool begin(int port, int maxConnections)
+    {
+        return true;
+    }
+    virtual void stop()
+    {
+        _connOpen = false;
+    }
+    // A new connection is made whenever the last one is closed
+    virtual int accept()
+    {
+        if (_connOpen)
+            return -1;
+        _connOpen = true;
+        _reqPos   = 0;
+        _connsAccepted++;
+        return 0;
+    }
+    virtual bool connected(int connId)
+    {
+        return _connOpen;
+    }
+    virtual int available(int connId)
+    {
+        return _connOpen ? 0x10000 : 0;
+    }
+    virtual int read(int connId, uint8_t *pBuf, int maxLen)
+    {
+        for (int i = 0; i < maxLen; i++)
+        {
+            pBuf[i] = _pReqStr[_reqPos];
+            if (++_reqPos >= _reqLen)
+                _reqPos = 0;
+        }
+        return maxLen;
+    }
+    virtual int write(int connId, const uint8_t *pBuf, int len)
+    {
+        _bytesWritten += len;
+        return len;
+    }
+    virtual bool reportsSendSpace()
+    {
+        return true;
+    }
+    virtual void flush(int connId)
+    {
+    }
+    virtual void close(int connId)
+    {
+        _connOpen = false;
+    }
+    virtual void getRemoteIPStr(int connId, char *pBuf, int bufLen)
+    {
+        snprintf(pBuf, bufLen, "mem");
+    }
+
+    unsigned long long _bytesWritten;
+    unsigned long      _connsAccepted;
+
+private:
+    const char *_pReqStr;
+    int        _reqLen;
+    int        _reqPos;
+    bool       _connOpen;
+};
+
+RestAPIEndpoints restAPIEndpoints;
+
+void restAPI_QueryStatus(RestAPIEndpointMsg& apiMsg, String& retStr)
+{
+    retStr = "{\"rslt\":\"ok\"}";
+}
+
+static double nowUs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+int main(int argc, char *argv[])
+{
+    double testSecs = (argc > 1) ? atof(argv[1]) : 3;
+    if ((argc > 2) && (strcmp(argv[2], "trace") == 0))
+    {
+        Log.setLevel(LOG_LEVEL_TRACE);
+    }
+
+    MemTransport transport("GET /Q HTTP/1.1\r\nHost: bench\r\nUser-Agent: bench\r\nAccept: */*\r\n\r\n");
+    RdWebServer  webServer(1, &transport);
+    restAPIEndpoints.addEndpoint("Q", RestAPIEndpointDef::ENDPOINT_CALLBACK, restAPI_QueryStatus, "");
+    webServer.addRestAPIEndpoints(&restAPIEndpoints);
+    webServer.setKeepAlive(60000, 1000000);
+    webServer.start(80);
+
+    // Warm up then time a fixed period
+    for (int i = 0; i < 10000; i++)
+    {
+        webServer.service();
+    }
+    unsigned long reqsAtStart = webServer.getStats()._requests;
+    double        startUs     = nowUs();
+    double        elapsedUs   = 0;
+    while (elapsedUs < testSecs * 1e6)
+    {
+        for (int i = 0; i < 1000; i++)
+        {
+            webServer.service();
+        }
+        elapsedUs = nowUs() - startUs;
+    }
+    unsigned long numReqs = webServer.getStats()._requests - reqsAtStart;
+    webServer.stop();
+
+    printf("Log level %d: %lu requests in %.2fs, %.0f requests/s, %.2fus/request, %lu connections\n",
+           RDWEBSERVER_LOG_LEVEL, numReqs, elapsedUs / 1e6, numReqs / (elapsedUs / 1e6),
+           elapsedUs / (numReqs ? numReqs : 1), transport._connsAccepted);
+    return 0;
+}
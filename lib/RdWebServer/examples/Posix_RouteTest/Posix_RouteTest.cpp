@@ -0,0 +1,76 @@
+// Posix_RouteTest
+// Rob Dobson 2012-2017
+
+// Checks that pattern endpoints which can't be added (invalid or too many route nodes) leave
+// the route tree as it was - their nodes would otherwise point into the deleted pattern
+// Build from the lib/RdWebServer folder with:
+//   g++ -std=c++11 -g -fsanitize=address -DRDWEBSERVER_POSIX -Isrc src/RdPosixWiring.cpp
+//       examples/Posix_RouteTest/Posix_RouteTest.cpp -o Posix_RouteTest
+// Run with:
+//   ./Posix_RouteTest
+// The exit code is the number of checks which failed
+
+#include "RestAPIEndpoints.h"
+
+static int numFailed = 0;
+
+static void restAPI_Dummy(RestAPIEndpointMsg& apiMsg, String& retStr)
+{
+    retStr = apiMsg._pEndpointStr;
+}
+
+// Route a path and check the endpoint found (NULL if none should match)
+static void checkRoute(RestAPIEndpoints& endpoints, const char *pPath, const char *pExpected)
+{
+    RestAPIParam params[RestAPIEndpointMsg::MAX_PATH_PARAMS];
+    int          numParams = 0;
+    int          allowMask = 0;
+    RestAPIEndpointDef *pEndpoint = endpoints.matchRoute(pPath, strlen(pPath), RdHttpRequestParser::METHOD_GET,
+                                                         params, numParams, allowMask);
+    const char *pFound = pEndpoint ? pEndpoint->_pEndpointStr : NULL;
+    bool ok = pExpected ? (pFound && (strcmp(pFound, pExpected) == 0)) : (pFound == NULL);
+    printf("%s %s -> %s\n", ok ? "ok  " : "FAIL", pPath, pFound ? pFound : "none");
+    if (!ok)
+    {
+        numFailed++;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    RestAPIEndpoints endpoints;
+    endpoints.addEndpoint("devices/:id/settings", RestAPIEndpointDef::ENDPOINT_CALLBACK, restAPI_Dummy, "");
+
+    // * not last - adds a node for "a" and one for * before failing
+    endpoints.addEndpoint("a/*/b", RestAPIEndpointDef::ENDPOINT_CALLBACK, restAPI_Dummy, "");
+    // Too many parameters - adds nodes below the existing devices/:id
+    endpoints.addEndpoint("devices/:id/:b/:c/:d/:e", RestAPIEndpointDef::ENDPOINT_CALLBACK, restAPI_Dummy, "");
+    // More segments than there are route nodes
+    String longPattern = "long";
+    for (int i = 0; i < RestAPIEndpoints::MAX_ROUTE_NODES; i++)
+    {
+        longPattern += String::format("/s%d", i);
+    }
+    endpoints.addEndpoint(longPattern.c_str(), RestAPIEndpointDef::ENDPOINT_CALLBACK, restAPI_Dummy, "");
+    if (endpoints.getNumEndpoints() != 1)
+    {
+        printf("FAIL %d endpoints added\n", endpoints.getNumEndpoints());
+        numFailed++;
+    }
+
+    // Requests walk the nodes the failed patterns would have added
+    checkRoute(endpoints, "a/x/b", NULL);
+    checkRoute(endpoints, "devices/1/2/3/4/5", NULL);
+    checkRoute(endpoints, "long/s0/s1", NULL);
+    checkRoute(endpoints, "devices/12/settings", "devices/:id/settings");
+
+    // The nodes are free for patterns added afterwards
+    endpoints.addEndpoint("a/:id", RestAPIEndpointDef::ENDPOINT_CALLBACK, restAPI_Dummy, "");
+    endpoints.addEndpoint("devices/:id/state", RestAPIEndpointDef::ENDPOINT_CALLBACK, restAPI_Dummy, "");
+    checkRoute(endpoints, "a/x", "a/:id");
+    checkRoute(endpoints, "devices/12/state", "devices/:id/state");
+    checkRoute(endpoints, "devices/12/settings", "devices/:id/settings");
+
+    printf("%d checks failed\n", numFailed);
+    return numFailed;
+}
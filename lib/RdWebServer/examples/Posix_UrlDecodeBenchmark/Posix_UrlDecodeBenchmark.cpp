@@ -0,0 +1,94 @@
+// Posix_UrlDecodeBenchmark
+// Rob Dobson 2012-2017
+
+// Compares decoding a long query string with the previous decoder (a String::replace call
+// for each escape) and the single pass decoder in RestAPIEndpoints
+// Build from the lib/RdWebServer folder with:
+//   g++ -std=c++11 -O2 -DRDWEBSERVER_POSIX -Isrc src/RdPosixWiring.cpp
+//       examples/Posix_UrlDecodeBenchmark/Posix_UrlDecodeBenchmark.cpp -o Posix_UrlDecodeBenchmark
+// Run with:
+//   ./Posix_UrlDecodeBenchmark [queryLen] [iterations]
+
+#include <time.h>
+#include "RestAPIEndpoints.h"
+
+// Previous decoder - kept here for comparison
+static String unencodeHTTPCharsReplace(String& inStr)
+{
+    static const char *escapes[][2] = {
+        {"+", " "}, {"%20", " "}, {"%21", "!"}, {"%22", "\""}, {"%23", "#"}, {"%24", "$"},
+        {"%25", "%"}, {"%26", "&"}, {"%27", "^"}, {"%28", "("}, {"%29", ")"}, {"%2A", "*"},
+        {"%2B", "+"}, {"%2C", ","}, {"%2D", "-"}, {"%2E", "."}, {"%2F", "/"}, {"%3A", ":"},
+        {"%3B", ";"}, {"%3C", "<"}, {"%3D", "="}, {"%3E", ">"}, {"%3F", "?"}, {"%5B", "["},
+        {"%5C", "\\"}, {"%5D", "]"}, {"%5E", "^"}, {"%5F", "_"}, {"%60", "`"}, {"%7B", "{"},
+        {"%7C", "|"}, {"%7D", "}"}, {"%7E", "~"}
+    };
+    for (unsigned int i = 0; i < sizeof(escapes) / sizeof(escapes[0]); i++)
+    {
+        inStr.replace(escapes[i][0], escapes[i][1]);
+    }
+    return inStr;
+}
+
+static double nowUs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+int main(int argc, char *argv[])
+{
+    int queryLen   = (argc > 1) ? atoi(argv[1]) : 1024;
+    int iterations = (argc > 2) ? atoi(argv[2]) : 2000;
+
+    // Query string of form fields with typical escapes
+    static const char *pField = "name=Sand+Table%201&path=%2Fpatterns%2Fspiral&json=%7B%22a%22%3A1%7D&";
+    String query;
+    while ((int)query.length() < queryLen)
+    {
+        query += pField;
+    }
+
+    // Check that the decoders agree (on text without the escapes the old one got wrong)
+    String oldStr = query;
+    String newStr = query;
+    unencodeHTTPCharsReplace(oldStr);
+    RestAPIEndpoints::unencodeHTTPChars(newStr);
+    printf("Query %u bytes, decoded %u bytes, results %s\n", query.length(), newStr.length(),
+           oldStr.equals(newStr) ? "match" : "DIFFER");
+
+    // String::replace per escape
+    double startUs = nowUs();
+    for (int i = 0; i < iterations; i++)
+    {
+        String str = query;
+        unencodeHTTPCharsReplace(str);
+    }
+    double replaceUs = (nowUs() - startUs) / iterations;
+
+    // Single pass into a String
+    startUs = nowUs();
+    for (int i = 0; i < iterations; i++)
+    {
+        String str = query;
+        RestAPIEndpoints::unencodeHTTPChars(str);
+    }
+    double stringUs = (nowUs() - startUs) / iterations;
+
+    // Single pass in place in a buffer
+    char *pBuf = new char[query.length()];
+    startUs = nowUs();
+    for (int i = 0; i < iterations; i++)
+    {
+        memcpy(pBuf, query.c_str(), query.length());
+        RestAPIEndpoints::urlDecodeInPlace(pBuf, query.length(), true);
+    }
+    double inPlaceUs = (nowUs() - startUs) / iterations;
+    delete [] pBuf;
+
+    printf("String::replace per escape %8.2f us\n", replaceUs);
+    printf("Single pass to String      %8.2f us (%.1fx)\n", stringUs, replaceUs / stringUs);
+    printf("Single pass in place       %8.2f us (%.1fx)\n", inPlaceUs, replaceUs / inPlaceUs);
+    return 0;
+}
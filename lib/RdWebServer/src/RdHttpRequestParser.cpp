@@ -0,0 +1,435 @@
+// HTTP request parser
+// Rob Dobson 2012-2017
+
+#include "RdHttpRequestParser.h"
+
+void RdHttpRequestParser::reset()
+{
+    _parseState         = PARSE_STATE_METHOD;
+    _parsePos           = 0;
+    _method             = METHOD_OTHER;
+    _methodSpan._pos    = 0;
+    _methodSpan._len    = 0;
+    _target._pos        = 0;
+    _target._len        = 0;
+    _path               = _target;
+    _query              = _target;
+    _versionPos         = 0;
+    _httpMinorVersion   = 0;
+    _numHeaders         = 0;
+    _valueEndPos        = 0;
+    _contentLength      = 0;
+    _contentLengthSeen  = false;
+    _transferEncoding   = false;
+    _connClose          = false;
+    _connKeepAlive      = false;
+}
+
+
+//////////////////////////////////////
+// Parse - each byte is handled once and parsing stops at the end of the header (any
+// following bytes are payload or the next request)
+RdHttpRequestParser::ParseResult RdHttpRequestParser::parse(const uint8_t *pBuf, int dataLen)
+{
+    while ((_parsePos < dataLen) && (_parseState != PARSE_STATE_COMPLETE) &&
+           (_parseState != PARSE_STATE_ERROR))
+    {
+        uint8_t ch = pBuf[_parsePos];
+        switch (_parseState)
+        {
+        case PARSE_STATE_METHOD:
+            if (ch == ' ')
+            {
+                _methodSpan._len = _parsePos;
+                _target._pos     = _parsePos + 1;
+                _path._pos       = _parsePos + 1;
+                _parseState      = (_methodSpan._len > 0) ? PARSE_STATE_PATH : PARSE_STATE_ERROR;
+            }
+            else if ((ch < 'A') || (ch > 'Z'))
+            {
+                _parseState = PARSE_STATE_ERROR;
+            }
+            break;
+
+        case PARSE_STATE_PATH:
+        case PARSE_STATE_QUERY:
+            if (ch == ' ')
+            {
+                _target._len = _parsePos - _target._pos;
+                if (_parseState == PARSE_STATE_PATH)
+                {
+                    _path._len = _parsePos - _path._pos;
+                }
+                else
+                {
+                    _query._len = _parsePos - _query._pos;
+                }
+                _versionPos = _parsePos + 1;
+                _parseState = (_target._len > 0) ? PARSE_STATE_VERSION : PARSE_STATE_ERROR;
+            }
+            else if ((ch == '?') && (_parseState == PARSE_STATE_PATH))
+            {
+                _path._len  = _parsePos - _path._pos;
+                _query._pos = _parsePos + 1;
+                _parseState = PARSE_STATE_QUERY;
+            }
+            else if ((ch < 0x21) || (ch == 0x7f))
+            {
+                _parseState = PARSE_STATE_ERROR;
+            }
+            break;
+
+        case PARSE_STATE_VERSION:
+            if ((ch == '\r') || (ch == '\n'))
+            {
+                requestLineComplete(pBuf);
+                if ((_parseState != PARSE_STATE_ERROR) && (ch == '\n'))
+                {
+                    _parseState = PARSE_STATE_HDR_START;
+                }
+            }
+            break;
+
+        case PARSE_STATE_REQ_LINE_LF:
+        case PARSE_STATE_HDR_LF:
+            _parseState = (ch == '\n') ? PARSE_STATE_HDR_START : PARSE_STATE_ERROR;
+            break;
+
+        case PARSE_STATE_HDR_START:
+            if (ch == '\r')
+            {
+                _parseState = PARSE_STATE_END_LF;
+            }
+            else if (ch == '\n')
+            {
+                _parseState = PARSE_STATE_COMPLETE;
+            }
+            else if (isTokenChar(ch))
+            {
+                _curHeader._name._pos = _parsePos;
+                _parseState           = PARSE_STATE_HDR_NAME;
+            }
+            else
+            {
+                // Includes obsolete line folding which isn't supported
+                _parseState = PARSE_STATE_ERROR;
+            }
+            break;
+
+        case PARSE_STATE_HDR_NAME:
+            if (ch == ':')
+            {
+                _curHeader._name._len = _parsePos - _curHeader._name._pos;
+                _parseState           = PARSE_STATE_HDR_VALUE_START;
+            }
+            else if (!isTokenChar(ch))
+            {
+                _parseState = PARSE_STATE_ERROR;
+            }
+            break;
+
+        case PARSE_STATE_HDR_VALUE_START:
+            // Skip leading whitespace
+            if ((ch == ' ') || (ch == '\t'))
+            {
+                break;
+            }
+            _curHeader._value._pos = _parsePos;
+            _valueEndPos           = _parsePos;
+            _parseState            = PARSE_STATE_HDR_VALUE;
+            // The first character of the value is handled in the value state
+            // fall through
+
+        case PARSE_STATE_HDR_VALUE:
+            if ((ch == '\r') || (ch == '\n'))
+            {
+                // Trailing whitespace is excluded from the value
+                _curHeader._value._len = _valueEndPos - _curHeader._value._pos;
+                if (!headerComplete(pBuf))
+                {
+                    _parseState = PARSE_STATE_ERROR;
+                }
+                else
+                {
+                    _parseState = (ch == '\r') ? PARSE_STATE_HDR_LF : PARSE_STATE_HDR_START;
+                }
+            }
+            else if (((ch < 0x20) && (ch != '\t')) || (ch == 0x7f))
+            {
+                _parseState = PARSE_STATE_ERROR;
+            }
+            else if ((ch != ' ') && (ch != '\t'))
+            {
+                _valueEndPos = _parsePos + 1;
+            }
+            break;
+
+        case PARSE_STATE_END_LF:
+            _parseState = (ch == '\n') ? PARSE_STATE_COMPLETE : PARSE_STATE_ERROR;
+            break;
+
+        default:
+            break;
+        }
+        _parsePos++;
+    }
+
+    if (_parseState == PARSE_STATE_COMPLETE)
+    {
+        return PARSE_COMPLETE;
+    }
+    if (_parseState == PARSE_STATE_ERROR)
+    {
+        return PARSE_ERROR;
+    }
+    return PARSE_INCOMPLETE;
+}
+
+
+//////////////////////////////////////
+// Request line ends - check version and method
+void RdHttpRequestParser::requestLineComplete(const uint8_t *pBuf)
+{
+    // Version must be HTTP/1.x
+    const char *pVersion = (const char *)pBuf + _versionPos;
+    if ((_parsePos - _versionPos != 8) || (strncmp(pVersion, "HTTP/1.", 7) != 0) ||
+        (pVersion[7] < '0') || (pVersion[7] > '9'))
+    {
+        _parseState = PARSE_STATE_ERROR;
+        return;
+    }
+    _httpMinorVersion = pVersion[7] - '0';
+    _parseState       = PARSE_STATE_REQ_LINE_LF;
+
+    // Method (case sensitive)
+    const char *pMethod = (const char *)pBuf;
+    for (int method = METHOD_OTHER + 1; method < NUM_METHODS; method++)
+    {
+        const char *pName = getMethodName(method);
+        if ((_methodSpan._len == (int)strlen(pName)) && (strncmp(pMethod, pName, _methodSpan._len) == 0))
+        {
+            _method = method;
+            break;
+        }
+    }
+}
+
+
+//////////////////////////////////////
+// Method names (indexed by method)
+const char *RdHttpRequestParser::getMethodName(int method)
+{
+    static const char *methodNames[NUM_METHODS] = {
+        NULL, "GET", "POST", "OPTIONS", "HEAD", "PUT", "DELETE", "PATCH"
+    };
+    if ((method < 0) || (method >= NUM_METHODS))
+    {
+        return NULL;
+    }
+    return methodNames[method];
+}
+
+
+//////////////////////////////////////
+// Header line ends - record it and pick out the headers the server uses
+bool RdHttpRequestParser::headerComplete(const uint8_t *pBuf)
+{
+    if (_numHeaders < MAX_HEADERS)
+    {
+        _headers[_numHeaders++] = _curHeader;
+    }
+
+    // Content length
+    if (spanEqualsNoCase(pBuf, _curHeader._name, "Content-Length"))
+    {
+        if (_curHeader._value._len == 0)
+        {
+            return false;
+        }
+        int contentLength = 0;
+        for (int i = 0; i < _curHeader._value._len; i++)
+        {
+            uint8_t ch = pBuf[_curHeader._value._pos + i];
+            if ((ch < '0') || (ch > '9') || (contentLength > 99999999))
+            {
+                return false;
+            }
+            contentLength = contentLength * 10 + (ch - '0');
+        }
+        // Repeated headers must agree - otherwise the end of the body is ambiguous
+        if (_contentLengthSeen && (contentLength != _contentLength))
+        {
+            return false;
+        }
+        _contentLength     = contentLength;
+        _contentLengthSeen = true;
+    }
+    // Body framed with a transfer coding
+    else if (spanEqualsNoCase(pBuf, _curHeader._name, "Transfer-Encoding"))
+    {
+        _transferEncoding = true;
+    }
+    // Connection options
+    else if (spanEqualsNoCase(pBuf, _curHeader._name, "Connection"))
+    {
+        if (spanContainsNoCase(pBuf, _curHeader._value, "close"))
+        {
+            _connClose = true;
+        }
+        if (spanContainsNoCase(pBuf, _curHeader._value, "keep-alive"))
+        {
+            _connKeepAlive = true;
+        }
+    }
+    return true;
+}
+
+
+//////////////////////////////////////
+// Find a header by name
+bool RdHttpRequestParser::findHeader(const uint8_t *pBuf, const char *pName, RdHttpSpan& value)
+{
+    for (int headerIdx = 0; headerIdx < _numHeaders; headerIdx++)
+    {
+        if (spanEqualsNoCase(pBuf, _headers[headerIdx]._name, pName))
+        {
+            value = _headers[headerIdx]._value;
+            return true;
+        }
+    }
+    return false;
+}
+
+
+bool RdHttpRequestParser::spanEqualsNoCase(const uint8_t *pBuf, const RdHttpSpan& span, const char *pStr)
+{
+    return (strlen(pStr) == (size_t)span._len) &&
+           (strncasecmp((const char *)pBuf + span._pos, pStr, span._len) == 0);
+}
+
+
+bool RdHttpRequestParser::spanContainsNoCase(const uint8_t *pBuf, const RdHttpSpan& span, const char *pStr)
+{
+    int strLen = strlen(pStr);
+    for (int i = 0; i + strLen <= span._len; i++)
+    {
+        if (strncasecmp((const char *)pBuf + span._pos + i, pStr, strLen) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+//////////////////////////////////////
+// Check if a list of tokens (e.g. "gzip, deflate;q=0.5, br;q=0") accepts a token
+bool RdHttpRequestParser::acceptsToken(const uint8_t *pBuf, const RdHttpSpan& value, const char *pToken)
+{
+    const char *pCh       = (const char *)pBuf + value._pos;
+    const char *pValueEnd = pCh + value._len;
+    int        tokenLen   = strlen(pToken);
+    bool       wildcard   = false;
+    while (pCh < pValueEnd)
+    {
+        // Item is up to the next comma
+        while ((pCh < pValueEnd) && ((*pCh == ' ') || (*pCh == '\t') || (*pCh == ',')))
+        {
+            pCh++;
+        }
+        const char *pItem = pCh;
+        while ((pCh < pValueEnd) && (*pCh != ',') && (*pCh != ';') && (*pCh != ' ') && (*pCh != '\t'))
+        {
+            pCh++;
+        }
+        int itemLen = pCh - pItem;
+        // Quality - only q=0 matters (not acceptable)
+        bool qualityZero = false;
+        while ((pCh < pValueEnd) && (*pCh != ','))
+        {
+            if (((*pCh == 'q') || (*pCh == 'Q')) && (pCh + 1 < pValueEnd) && (*(pCh + 1) == '='))
+            {
+                const char *pQ = pCh + 2;
+                qualityZero = (pQ < pValueEnd) && (*pQ == '0');
+                for (pQ++; (pQ < pValueEnd) && qualityZero && (*pQ != ',') && (*pQ != ' ') && (*pQ != ';'); pQ++)
+                {
+                    qualityZero = (*pQ == '.') || (*pQ == '0');
+                }
+            }
+            pCh++;
+        }
+        if ((itemLen == tokenLen) && (strncasecmp(pItem, pToken, tokenLen) == 0))
+        {
+            return !qualityZero;
+        }
+        if ((itemLen == 1) && (*pItem == '*'))
+        {
+            wildcard = !qualityZero;
+        }
+    }
+    return wildcard;
+}
+
+
+//////////////////////////////////////
+// Check if a list of entity tags (e.g. "abc", W/"def") matches an entity tag
+bool RdHttpRequestParser::matchesETag(const uint8_t *pBuf, const RdHttpSpan& value, const char *pETag)
+{
+    const char *pCh       = (const char *)pBuf + value._pos;
+    const char *pValueEnd = pCh + value._len;
+    int        eTagLen    = strlen(pETag);
+    while (pCh < pValueEnd)
+    {
+        while ((pCh < pValueEnd) && ((*pCh == ' ') || (*pCh == '\t') || (*pCh == ',')))
+        {
+            pCh++;
+        }
+        if (pCh >= pValueEnd)
+        {
+            break;
+        }
+        if (*pCh == '*')
+        {
+            return true;
+        }
+        if ((pValueEnd - pCh >= 2) && (*pCh == 'W') && (*(pCh + 1) == '/'))
+        {
+            pCh += 2;
+        }
+        // Quoted tag
+        const char *pTag = pCh;
+        if ((pCh < pValueEnd) && (*pCh == '"'))
+        {
+            pCh++;
+            while ((pCh < pValueEnd) && (*pCh != '"'))
+            {
+                pCh++;
+            }
+            if (pCh < pValueEnd)
+            {
+                pCh++;
+                if ((pCh - pTag == eTagLen) && (strncmp(pTag, pETag, eTagLen) == 0))
+                {
+                    return true;
+                }
+            }
+        }
+        // Skip to next item
+        while ((pCh < pValueEnd) && (*pCh != ','))
+        {
+            pCh++;
+        }
+    }
+    return false;
+}
+
+
+// Characters allowed in header names (RFC 7230 token)
+bool RdHttpRequestParser::isTokenChar(uint8_t ch)
+{
+    if ((ch <= 0x20) || (ch >= 0x7f))
+    {
+        return false;
+    }
+    return strchr("\"(),/:;<=>?@[\\]{}", ch) == NULL;
+}
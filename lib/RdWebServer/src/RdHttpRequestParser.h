@@ -0,0 +1,187 @@
+// HTTP request parser
+// Rob Dobson 2012-2017
+
+// Single pass parser for the request line and headers of an HTTP request - it is resumable
+// so it can be called each time more data arrives and each byte is only examined once
+// The positions of the method, path, query and headers are recorded as offsets into the
+// receive buffer so nothing needs to be re-scanned once the header is complete
+
+#pragma once
+
+#include "RdWebServerPlatform.h"
+
+// Section of the receive buffer
+struct RdHttpSpan
+{
+    int _pos;
+    int _len;
+};
+
+// Header name and value
+struct RdHttpHeaderSpan
+{
+    RdHttpSpan _name;
+    RdHttpSpan _value;
+};
+
+class RdHttpRequestParser
+{
+public:
+    // Methods
+    static const int METHOD_OTHER   = 0;
+    static const int METHOD_GET     = 1;
+    static const int METHOD_POST    = 2;
+    static const int METHOD_OPTIONS = 3;
+    static const int METHOD_HEAD    = 4;
+    static const int METHOD_PUT     = 5;
+    static const int METHOD_DELETE  = 6;
+    static const int METHOD_PATCH   = 7;
+    static const int NUM_METHODS    = 8;
+
+    // Max number of headers recorded - further headers are parsed but not recorded
+    static const int MAX_HEADERS = 24;
+
+    enum ParseResult
+    {
+        PARSE_INCOMPLETE, PARSE_COMPLETE, PARSE_ERROR
+    };
+
+    RdHttpRequestParser()
+    {
+        reset();
+    }
+
+    // Start parsing a new request
+    void reset();
+
+    // Parse bytes from where parsing previously stopped up to dataLen - pBuf must be the
+    // start of the request (as all positions are relative to it)
+    ParseResult parse(const uint8_t *pBuf, int dataLen);
+
+    // Results - only valid once parse() returns PARSE_COMPLETE
+    int getMethod()
+    {
+        return _method;
+    }
+    const RdHttpSpan& getMethodSpan()
+    {
+        return _methodSpan;
+    }
+    // Request target (path and query) and its parts
+    const RdHttpSpan& getTarget()
+    {
+        return _target;
+    }
+    const RdHttpSpan& getPath()
+    {
+        return _path;
+    }
+    const RdHttpSpan& getQuery()
+    {
+        return _query;
+    }
+    // Request line received (so a header which is too long isn't just a long request line)
+    bool isRequestLineComplete()
+    {
+        return (_parseState > PARSE_STATE_VERSION) && (_parseState != PARSE_STATE_ERROR);
+    }
+    bool isHttp11()
+    {
+        return _httpMinorVersion >= 1;
+    }
+    // Length of the header including the blank line which ends it
+    int getHeaderLen()
+    {
+        return _parsePos;
+    }
+    // Number of bytes parsed so far
+    int getParsePos()
+    {
+        return _parsePos;
+    }
+    // Content-Length (0 if not present)
+    int getContentLength()
+    {
+        return _contentLength;
+    }
+    // Transfer-Encoding present - the body isn't delimited by Content-Length (chunked request
+    // bodies aren't supported)
+    bool hasTransferEncoding()
+    {
+        return _transferEncoding;
+    }
+    // Connection header tokens
+    bool connectionClose()
+    {
+        return _connClose;
+    }
+    bool connectionKeepAlive()
+    {
+        return _connKeepAlive;
+    }
+    int getNumHeaders()
+    {
+        return _numHeaders;
+    }
+    const RdHttpHeaderSpan& getHeader(int headerIdx)
+    {
+        return _headers[headerIdx];
+    }
+    // Find a header by name (case insensitive) - returns false if not present
+    bool findHeader(const uint8_t *pBuf, const char *pName, RdHttpSpan& value);
+
+    // Name of a method (NULL for METHOD_OTHER)
+    static const char *getMethodName(int method);
+
+    // Check if a span matches a string (case insensitive)
+    static bool spanEqualsNoCase(const uint8_t *pBuf, const RdHttpSpan& span, const char *pStr);
+
+    // Check if a header value listing tokens with optional quality values (e.g. Accept-Encoding)
+    // accepts a token - tokens with q=0 are not accepted and * matches any token
+    static bool acceptsToken(const uint8_t *pBuf, const RdHttpSpan& value, const char *pToken);
+
+    // Check if an If-None-Match header value (a list of entity tags or *) matches an entity tag
+    // (quoted) - weak comparison is used so W/ prefixes are ignored
+    static bool matchesETag(const uint8_t *pBuf, const RdHttpSpan& value, const char *pETag);
+
+private:
+    enum ParseState
+    {
+        PARSE_STATE_METHOD, PARSE_STATE_PATH, PARSE_STATE_QUERY, PARSE_STATE_VERSION,
+        PARSE_STATE_REQ_LINE_LF, PARSE_STATE_HDR_START, PARSE_STATE_HDR_NAME,
+        PARSE_STATE_HDR_VALUE_START, PARSE_STATE_HDR_VALUE, PARSE_STATE_HDR_LF,
+        PARSE_STATE_END_LF, PARSE_STATE_COMPLETE, PARSE_STATE_ERROR
+    };
+
+    // Current state and position in buffer
+    ParseState _parseState;
+    int        _parsePos;
+
+    // Request line
+    int        _method;
+    RdHttpSpan _methodSpan;
+    RdHttpSpan _target;
+    RdHttpSpan _path;
+    RdHttpSpan _query;
+    int        _versionPos;
+    int        _httpMinorVersion;
+
+    // Headers
+    RdHttpHeaderSpan _headers[MAX_HEADERS];
+    int              _numHeaders;
+    RdHttpHeaderSpan _curHeader;
+    int              _valueEndPos;
+
+    // Headers used by the server
+    int  _contentLength;
+    bool _contentLengthSeen;
+    bool _transferEncoding;
+    bool _connClose;
+    bool _connKeepAlive;
+
+    // Helpers
+    void requestLineComplete(const uint8_t *pBuf);
+    bool headerComplete(const uint8_t *pBuf);
+    static bool isTokenChar(uint8_t ch);
+    static bool spanContainsNoCase(const uint8_t *pBuf, const RdHttpSpan& span, const char *pStr);
+};
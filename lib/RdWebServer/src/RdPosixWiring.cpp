@@ -0,0 +1,160 @@
+// Minimal subset of the Particle wiring API for host (POSIX) builds
+// Rob Dobson 2012-2017
+
+#ifdef RDWEBSERVER_POSIX
+
+#include "RdPosixWiring.h"
+#include <stdarg.h>
+#include <time.h>
+#include <unistd.h>
+#include <new>
+
+RdPosixLogger Log;
+RdPosixTime Time;
+
+// Heap allocation counting - the global operator new is replaced so that tests can check
+// that code paths don't allocate
+static unsigned long _posixHeapAllocCount = 0;
+
+unsigned long RdPosixHeapAllocCount()
+{
+    return _posixHeapAllocCount;
+}
+
+void *operator new(size_t size)
+{
+    _posixHeapAllocCount++;
+    void *pMem = malloc(size ? size : 1);
+    if (!pMem)
+        throw std::bad_alloc();
+    return pMem;
+}
+
+void *operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void *pMem) noexcept
+{
+    free(pMem);
+}
+
+void operator delete[](void *pMem) noexcept
+{
+    free(pMem);
+}
+
+void operator delete(void *pMem, size_t /* size */) noexcept
+{
+    free(pMem);
+}
+
+void operator delete[](void *pMem, size_t /* size */) noexcept
+{
+    free(pMem);
+}
+
+String& String::trim()
+{
+    size_t first = 0;
+    while ((first < _str.length()) && isspace((unsigned char)_str[first]))
+        first++;
+    size_t last = _str.length();
+    while ((last > first) && isspace((unsigned char)_str[last - 1]))
+        last--;
+    _str = _str.substr(first, last - first);
+    return *this;
+}
+
+String String::format(const char *fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    va_list argsCopy;
+    va_copy(argsCopy, args);
+    int len = vsnprintf(NULL, 0, fmt, argsCopy);
+    va_end(argsCopy);
+    String outStr;
+    if (len > 0)
+    {
+        outStr._str.resize(len + 1);
+        vsnprintf(&outStr._str[0], len + 1, fmt, args);
+        outStr._str.resize(len);
+    }
+    va_end(args);
+    return outStr;
+}
+
+static void logWrite(const char *levelStr, const char *fmt, va_list args)
+{
+    fprintf(stderr, "%010lu %s ", millis(), levelStr);
+    vfprintf(stderr, fmt, args);
+    fputc('\n', stderr);
+}
+
+void RdPosixLogger::trace(const char *fmt, ...) const
+{
+    if (_level > LOG_LEVEL_TRACE)
+        return;
+    va_list args;
+    va_start(args, fmt);
+    logWrite("TRACE", fmt, args);
+    va_end(args);
+}
+
+void RdPosixLogger::info(const char *fmt, ...) const
+{
+    if (_level > LOG_LEVEL_INFO)
+        return;
+    va_list args;
+    va_start(args, fmt);
+    logWrite("INFO", fmt, args);
+    va_end(args);
+}
+
+void RdPosixLogger::warn(const char *fmt, ...) const
+{
+    if (_level > LOG_LEVEL_WARN)
+        return;
+    va_list args;
+    va_start(args, fmt);
+    logWrite("WARN", fmt, args);
+    va_end(args);
+}
+
+void RdPosixLogger::error(const char *fmt, ...) const
+{
+    if (_level > LOG_LEVEL_ERROR)
+        return;
+    va_list args;
+    va_start(args, fmt);
+    logWrite("ERROR", fmt, args);
+    va_end(args);
+}
+
+unsigned long RdPosixTime::now()
+{
+    return (unsigned long)time(NULL);
+}
+
+unsigned long millis()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long)(ts.tv_sec * 1000UL + ts.tv_nsec / 1000000UL);
+}
+
+unsigned long micros()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long)(ts.tv_sec * 1000000UL + ts.tv_nsec / 1000UL);
+}
+
+void delay(unsigned long ms)
+{
+    usleep(ms * 1000);
+}
+
+#endif // RDWEBSERVER_POSIX
@@ -0,0 +1,253 @@
+// Minimal subset of the Particle wiring API for host (POSIX) builds
+// Rob Dobson 2012-2017
+
+// Only the parts of the API used by RdWebServer and RestAPIEndpoints are provided
+
+#pragma once
+
+#ifdef RDWEBSERVER_POSIX
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <limits.h>
+#include <ctype.h>
+#include <string>
+
+// String - a thin wrapper around std::string with the wiring String methods
+class String
+{
+public:
+    String() {}
+    String(const char *pStr) : _str(pStr ? pStr : "") {}
+    String(const String& other) : _str(other._str) {}
+    explicit String(char ch) : _str(1, ch) {}
+    explicit String(int val) : _str(std::to_string(val)) {}
+    explicit String(long val) : _str(std::to_string(val)) {}
+    explicit String(unsigned long val) : _str(std::to_string(val)) {}
+
+    String& operator=(const String& other)
+    {
+        _str = other._str;
+        return *this;
+    }
+    String& operator=(const char *pStr)
+    {
+        _str = pStr ? pStr : "";
+        return *this;
+    }
+
+    const char *c_str() const
+    {
+        return _str.c_str();
+    }
+    operator const char *() const
+    {
+        return _str.c_str();
+    }
+    unsigned int length() const
+    {
+        return _str.length();
+    }
+    unsigned char reserve(unsigned int size)
+    {
+        _str.reserve(size);
+        return 1;
+    }
+
+    unsigned char concat(const String& str)
+    {
+        _str.append(str._str);
+        return 1;
+    }
+    unsigned char concat(const char *pStr)
+    {
+        if (pStr)
+            _str.append(pStr);
+        return 1;
+    }
+    unsigned char concat(char ch)
+    {
+        _str.push_back(ch);
+        return 1;
+    }
+    unsigned char concat(int val)
+    {
+        _str.append(std::to_string(val));
+        return 1;
+    }
+    String& operator+=(const String& str)
+    {
+        concat(str);
+        return *this;
+    }
+    String& operator+=(const char *pStr)
+    {
+        concat(pStr);
+        return *this;
+    }
+    String& operator+=(char ch)
+    {
+        concat(ch);
+        return *this;
+    }
+    friend String operator+(const String& lhs, const String& rhs)
+    {
+        String rslt(lhs);
+        rslt.concat(rhs);
+        return rslt;
+    }
+    friend String operator+(const String& lhs, const char *pRhs)
+    {
+        String rslt(lhs);
+        rslt.concat(pRhs);
+        return rslt;
+    }
+    friend String operator+(const char *pLhs, const String& rhs)
+    {
+        String rslt(pLhs);
+        rslt.concat(rhs);
+        return rslt;
+    }
+
+    bool equals(const String& other) const
+    {
+        return _str == other._str;
+    }
+    bool equals(const char *pStr) const
+    {
+        return _str == (pStr ? pStr : "");
+    }
+    bool operator==(const String& other) const
+    {
+        return equals(other);
+    }
+    bool operator==(const char *pStr) const
+    {
+        return equals(pStr);
+    }
+    bool operator!=(const String& other) const
+    {
+        return !equals(other);
+    }
+    bool operator!=(const char *pStr) const
+    {
+        return !equals(pStr);
+    }
+    bool equalsIgnoreCase(const String& other) const
+    {
+        return strcasecmp(_str.c_str(), other._str.c_str()) == 0;
+    }
+
+    char charAt(unsigned int idx) const
+    {
+        return idx < _str.length() ? _str[idx] : 0;
+    }
+    int indexOf(const char *pStr, unsigned int fromIdx = 0) const
+    {
+        size_t pos = _str.find(pStr, fromIdx);
+        return pos == std::string::npos ? -1 : (int)pos;
+    }
+    String substring(unsigned int beginIdx, unsigned int endIdx = UINT_MAX) const
+    {
+        if (beginIdx >= _str.length())
+            return String();
+        if (endIdx > _str.length())
+            endIdx = _str.length();
+        if (endIdx < beginIdx)
+            return String();
+        return String(_str.substr(beginIdx, endIdx - beginIdx).c_str());
+    }
+
+    String& replace(const String& find, const String& replace)
+    {
+        if (find._str.empty())
+            return *this;
+        size_t pos = 0;
+        while ((pos = _str.find(find._str, pos)) != std::string::npos)
+        {
+            _str.replace(pos, find._str.length(), replace._str);
+            pos += replace._str.length();
+        }
+        return *this;
+    }
+    String& toUpperCase()
+    {
+        for (size_t i = 0; i < _str.length(); i++)
+            _str[i] = toupper((unsigned char)_str[i]);
+        return *this;
+    }
+    String& toLowerCase()
+    {
+        for (size_t i = 0; i < _str.length(); i++)
+            _str[i] = tolower((unsigned char)_str[i]);
+        return *this;
+    }
+    String& trim();
+    long toInt() const
+    {
+        return strtol(_str.c_str(), NULL, 10);
+    }
+
+    static String format(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+
+private:
+    std::string _str;
+};
+
+// Log levels (values as used by Particle)
+typedef enum
+{
+    LOG_LEVEL_ALL   = 1,
+    LOG_LEVEL_TRACE = 1,
+    LOG_LEVEL_INFO  = 30,
+    LOG_LEVEL_WARN  = 40,
+    LOG_LEVEL_ERROR = 50,
+    LOG_LEVEL_NONE  = 70
+} LogLevel;
+
+// Logger - writes to stderr
+class RdPosixLogger
+{
+public:
+    RdPosixLogger()
+    {
+        _level = LOG_LEVEL_INFO;
+    }
+    void setLevel(LogLevel level)
+    {
+        _level = level;
+    }
+    bool isTraceEnabled() const
+    {
+        return _level <= LOG_LEVEL_TRACE;
+    }
+    void trace(const char *fmt, ...) const __attribute__((format(printf, 2, 3)));
+    void info(const char *fmt, ...) const __attribute__((format(printf, 2, 3)));
+    void warn(const char *fmt, ...) const __attribute__((format(printf, 2, 3)));
+    void error(const char *fmt, ...) const __attribute__((format(printf, 2, 3)));
+
+private:
+    LogLevel _level;
+};
+extern RdPosixLogger Log;
+
+// Time - seconds since epoch
+class RdPosixTime
+{
+public:
+    unsigned long now();
+};
+extern RdPosixTime Time;
+
+// Number of heap allocations (operator new) made by the program so far
+unsigned long RdPosixHeapAllocCount();
+
+// Timing
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+
+#endif // RDWEBSERVER_POSIX
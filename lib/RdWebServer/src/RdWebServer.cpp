@@ -1,33 +1,105 @@
 // Web Server (target Particle devices e.g. RedBear Duo)
 // Rob Dobson 2012-2017
 
-#include "application.h"
+#include "RdWebServerPlatform.h"
 #include "RdWebServer.h"
 #include "RdWebServerUtils.h"
+#ifdef RDWEBSERVER_POSIX
+#include "RdWebTransportPosix.h"
+typedef RdWebTransportPosix RdWebTransportDefault;
+#else
+#include "RdWebTransportParticle.h"
+typedef RdWebTransportParticle RdWebTransportDefault;
+#endif
+
+// Status line for responses to requests for resources the client already has
+static const char *HTTP_NOT_MODIFIED_STATUS_LINE = "HTTP/1.1 304 Not Modified\r\n";
 
 RdWebClient::RdWebClient()
 {
+    _connId                = -1;
+    _pTransport            = NULL;
+    _pMetrics              = NULL;
+    _clientIdx             = 0;
     _webClientState        = WEB_CLIENT_NONE;
     _webClientStateEntryMs = 0;
     _pResourceToSend       = NULL;
-    _resourceSendIdx       = 0;
+    _numTxSegments         = 0;
+    _txSegmentIdx          = 0;
+    _txSegmentPos          = 0;
+    _keepAlive             = false;
+    _requestsOnConn        = 0;
+    _keepAliveIdleMs       = 0;
+    _keepAliveMaxRequests  = 0;
+    _pRespHdrSuffixKeepAlive = NULL;
+    _pRespHdrSuffixClose     = NULL;
+    _txHdrBuf[0]           = 0;
     _resourceSendBlkCount  = 0;
     _resourceSendMillis    = 0;
+    _resourceSendBlocked   = false;
+    _numRouteParams        = 0;
+    _pStreamEndpoint       = NULL;
+    _streamPos             = 0;
+    _streamChunked         = false;
+    _streamComplete        = false;
+    _pTxChunkBuf           = NULL;
+    _txChunkSendIdx        = 0;
+    _txChunkLen            = 0;
+    _pRxBuf                = NULL;
+    _rxLen                 = 0;
+    _rxReqLen              = 0;
+    _rxReqEndByte          = 0;
     _pHttpReqPayload       = NULL;
     _httpReqPayloadLen     = 0;
     _curHttpPayloadRxPos   = 0;
+    _httpHeaderComplete    = false;
+    _rxPayloadTooLarge     = false;
+    _rxBodyNotImplemented  = false;
+    _bodyStreamed          = false;
+    _bodyBufPos            = 0;
+    _bodyBufLen            = 0;
+    _reqRouted             = false;
+    _reqIsPreflight        = false;
+    _pReqEndpoint          = NULL;
+    _reqAllowMask          = 0;
+    _connAcceptUs          = 0;
+    _connFirstByteUs       = 0;
+    _respStarted           = false;
+    _pReqResource          = NULL;
+    memset(&_reqTimes, 0, sizeof(_reqTimes));
 }
 
 
 RdWebClient::~RdWebClient()
 {
-    cleanUp();
 }
 
 
-void RdWebClient::cleanUp()
+void RdWebClient::connectionAccepted(int connId)
 {
-    delete _pHttpReqPayload;
+    // Now connected
+    _connId          = connId;
+    _connAcceptUs    = micros();
+    _connFirstByteUs = 0;
+    cleanupTCPRxResources();
+    _pStreamEndpoint = NULL;
+    _numTxSegments   = 0;
+    _requestsOnConn = 0;
+    setState(WEB_CLIENT_ACCEPTED);
+    // Info
+    char ipStr[48];
+    _pTransport->getRemoteIPStr(_connId, ipStr, sizeof(ipStr));
+    RDWS_LOG_TRACE("WebClient IP %s", ipStr);
+}
+
+
+void RdWebClient::resetConnection()
+{
+    _connId = -1;
+    cleanupTCPRxResources();
+    _pStreamEndpoint = NULL;
+    _numTxSegments   = 0;
+    _webClientState = WEB_CLIENT_NONE;
 }
 
 
@@ -37,7 +109,7 @@ void RdWebClient::setState(WebClientState newState)
     _webClientStateEntryMs = millis();
     if ((newState != WEB_CLIENT_SEND_RESOURCE) && (newState != WEB_CLIENT_SEND_RESOURCE_WAIT))
     {
-        Log.trace("WebClient %d State: %s", _clientIdx, connStateStr());
+        RDWS_LOG_TRACE("WebClient %d State: %s", _clientIdx, connStateStr());
     }
 }
 
@@ -64,131 +136,338 @@ const char *RdWebClient::connStateStr()
 
 //////////////////////////////
 // Handle read from TCP client
+// Data is read straight into the client's receive buffer which holds the header (null
+// terminated) followed by the payload (also null terminated)
 void RdWebClient::handleTCPReadData(int numToRead)
 {
-    // Read from TCP client
-    // Note: reads to a position a few chars ahead of the start of the buffer - this is
-    // to permit chars from the end of a previous buffer to be added for end of header testing
-    // allowing that the header might be split across two frames
-    const char *headerEndSequence = "\r\n\r\n";
-    const int  headerEndSeqLen    = strlen(headerEndSequence);
-    uint8_t    *pTCPReadBuf       = new uint8_t[numToRead + headerEndSeqLen + 1];
-
-    // Fill initial chars with spaces
-    memset(pTCPReadBuf, ' ', headerEndSeqLen);
-    // Pointer to where data actually read to
-    uint8_t *pTCPReadPos = pTCPReadBuf + headerEndSeqLen;
-    int     numRead      = _TCPClient.read(pTCPReadPos, numToRead);
-    if (numRead <= 0)
-    {
-        delete [] pTCPReadBuf;
-        return;
-    }
-    // Terminate buffer
-    pTCPReadPos[numRead] = '\0';
-
     // Check if header already complete
     if (!_httpHeaderComplete)
     {
-        // See if the end of header might be split across frames
-        if ((pTCPReadPos[0] == '\r') || (pTCPReadPos[0] == '\n'))
+        // Read to end of data received so far - it is parsed as it arrives
+        int spaceLeft = HTTPD_MAX_REQ_LENGTH - _rxLen;
+        if (numToRead > spaceLeft)
         {
-            // Copy at most headerEndSeqLen chars to the bit before the data we read
-            int        reqLen   = _httpReqStr.length();
-            const char *pReqStr = _httpReqStr.c_str();
-            for (int i = 0; (i < headerEndSeqLen) && (i < reqLen); i++)
-            {
-                pTCPReadBuf[headerEndSeqLen - i - 1] = pReqStr[reqLen - i - 1];
-            }
+            numToRead = spaceLeft;
         }
-        // Location of end of header in read buffer
-        uint8_t *pEndOfHeaderInReadBuf = NULL;
-        // Check if the composite buffer contains the end of header string
-        uint8_t *pEOLEOL = (uint8_t *)strstr((const char *)pTCPReadBuf, headerEndSequence);
-        if (pEOLEOL != NULL)
-        {
-            // End of the string to be added to the request header
-            pEndOfHeaderInReadBuf = pEOLEOL + headerEndSeqLen;
-            // Header now complete
-            _httpHeaderComplete = true;
-        }
-        // Copy the header portion to the request header string
-        uint8_t charReplacedForTerminator = 0;
-        if (pEndOfHeaderInReadBuf != NULL)
-        {
-            charReplacedForTerminator = *pEndOfHeaderInReadBuf;
-            // Terminate string temporarily
-            *pEndOfHeaderInReadBuf = 0;
-        }
-        if ((_httpReqStr.length() + strlen((const char*)pTCPReadPos) < HTTPD_MAX_REQ_LENGTH))
-            _httpReqStr.concat((char *)pTCPReadPos);
-        // Put back the char which we replaced with terminator
-        if (pEndOfHeaderInReadBuf != NULL)
-            *pEndOfHeaderInReadBuf = charReplacedForTerminator;
-        // Get the length of the payload
-        if (_httpHeaderComplete)
-        {
-            int payloadLen = getContentLengthFromHeader(_httpReqStr);
-            _curHttpPayloadRxPos = 0;
-            Log.trace("WebClient Payload length %d", payloadLen);
-            // We have to ignore payloads that are too big for our memory
-            if (payloadLen > HTTP_MAX_PAYLOAD_LENGTH)
-            {
-                payloadLen = 0;
-            }
-            if ((payloadLen != 0) && (payloadLen != _httpReqPayloadLen))
-            {
-                delete [] _pHttpReqPayload;
-                // Add space for null terminator
-                _pHttpReqPayload    = new unsigned char[payloadLen + 1];
-                _pHttpReqPayload[0] = 0;
-            }
-            _httpReqPayloadLen = payloadLen;
+        int numRead = _pTransport->read(_connId, _pRxBuf + _rxLen, numToRead);
+        if (numRead <= 0)
+        {
+            return;
         }
-        // Copy payload data to the payload buffer (if any)
-        if ((_httpReqPayloadLen > 0) && (pEndOfHeaderInReadBuf != NULL))
+        // Start of a request
+        if (_rxLen == 0)
         {
-            int toCopy = numRead - (pEndOfHeaderInReadBuf - pTCPReadPos);
-            if (toCopy > _httpReqPayloadLen)
+            _reqTimes._firstByteUs = micros();
+            if (_connFirstByteUs == 0)
             {
-                toCopy = _httpReqPayloadLen;
+                _connFirstByteUs = _reqTimes._firstByteUs;
             }
-            memcpy(_pHttpReqPayload, pEndOfHeaderInReadBuf, toCopy);
-            _curHttpPayloadRxPos = toCopy;
-            *(_pHttpReqPayload + _curHttpPayloadRxPos) = 0;
         }
+        _rxLen += numRead;
+        _pRxBuf[_rxLen] = 0;
+    }
+    else if (_bodyStreamed)
+    {
+        // Body for an upload endpoint - read into the start of the payload area once the
+        // endpoint has consumed what was there (so it is read no faster than the endpoint
+        // handles it) - the receive buffer lengths aren't changed as nothing after the body
+        // can have been received before it
+        int bodyLeft = _httpReqPayloadLen - _curHttpPayloadRxPos;
+        if ((_bodyBufLen > 0) || (bodyLeft <= 0))
+        {
+            return;
+        }
+        if (numToRead > bodyLeft)
+        {
+            numToRead = bodyLeft;
+        }
+        if (numToRead > HTTP_MAX_PAYLOAD_LENGTH)
+        {
+            numToRead = HTTP_MAX_PAYLOAD_LENGTH;
+        }
+        int numRead = _pTransport->read(_connId, _pHttpReqPayload, numToRead);
+        if (numRead <= 0)
+        {
+            return;
+        }
+        _curHttpPayloadRxPos += numRead;
+        _bodyBufPos           = 0;
+        _bodyBufLen           = numRead;
     }
     else
     {
-        // Copy data to payload
+        // Read directly into the payload
         int spaceLeft = _httpReqPayloadLen - _curHttpPayloadRxPos;
-        if (spaceLeft > 0)
+        if (spaceLeft <= 0)
         {
-            int toCopy = numRead;
-            if (toCopy > spaceLeft)
-            {
-                toCopy = spaceLeft;
-            }
-            memcpy(_pHttpReqPayload + _curHttpPayloadRxPos, pTCPReadPos, toCopy);
-            _curHttpPayloadRxPos += toCopy;
-            *(_pHttpReqPayload + _curHttpPayloadRxPos) = 0;
+            return;
+        }
+        if (numToRead > spaceLeft)
+        {
+            numToRead = spaceLeft;
+        }
+        int numRead = _pTransport->read(_connId, _pHttpReqPayload + _curHttpPayloadRxPos, numToRead);
+        if (numRead <= 0)
+        {
+            return;
+        }
+        _curHttpPayloadRxPos += numRead;
+        _rxLen               += numRead;
+        _rxReqLen            += numRead;
+        _pHttpReqPayload[_curHttpPayloadRxPos] = 0;
+    }
+}
+
+//////////////////////////////
+// Parse the header received so far - the parser carries on from where it stopped so each
+// byte is only looked at once
+bool RdWebClient::parseRxHeader()
+{
+    RdHttpRequestParser::ParseResult parseResult = _httpParser.parse(_pRxBuf, _rxLen);
+    if (parseResult == RdHttpRequestParser::PARSE_ERROR)
+    {
+        return false;
+    }
+    if (parseResult == RdHttpRequestParser::PARSE_INCOMPLETE)
+    {
+        return true;
+    }
+
+    // Header now complete - move anything after it up by one to make space for the header terminator
+    _httpHeaderComplete = true;
+    int headerLen    = _httpParser.getHeaderLen();
+    int payloadRxLen = _rxLen - headerLen;
+    memmove(_pRxBuf + headerLen + 1, _pRxBuf + headerLen, payloadRxLen);
+    _pRxBuf[headerLen] = 0;
+    _rxLen++;
+    _pHttpReqPayload   = _pRxBuf + headerLen + 1;
+    return true;
+}
+
+////////////////////////////////////////////
+// Find the endpoint for the request - done as soon as the header is complete so the body
+// can be passed to an upload endpoint as it is received
+void RdWebClient::routeRequest(RdWebServer *pWebServer)
+{
+    const char       *pHttpReq  = (const char *)_pRxBuf;
+    int              httpMethod = _httpParser.getMethod();
+    const RdHttpSpan& target    = _httpParser.getTarget();
+    _pReqEndpoint   = NULL;
+    _reqAllowMask   = 0;
+    _numRouteParams = 0;
+
+    // CORS preflight requests are answered with the preformatted response without looking for
+    // the endpoint
+    RdHttpSpan preflightMethod;
+    _reqIsPreflight = (httpMethod == RdHttpRequestParser::METHOD_OPTIONS) &&
+                      (pWebServer->getPreflightResponse(false).length() > 0) &&
+                      _httpParser.findHeader(_pRxBuf, "Access-Control-Request-Method", preflightMethod);
+    if (_reqIsPreflight)
+    {
+        _reqRouted = false;
+        return;
+    }
+
+    // Requests with methods which aren't recognised aren't passed to endpoints
+    if (httpMethod == RdHttpRequestParser::METHOD_OTHER)
+    {
+        _reqRouted = false;
+        return;
+    }
+
+    // See if there is a valid HTTP command
+    _reqRouted = extractEndpointArgs(pHttpReq + target._pos, target._len, _reqEndpointStr, _reqArgStr);
+    if (!_reqRouted)
+    {
+        return;
+    }
+    RDWS_LOG_TRACE("WebClient routeRequest EndPtStr %s ArgStr %s", _reqEndpointStr.c_str(), _reqArgStr.c_str());
+
+    // Pattern endpoints are matched on the whole path and their arguments are the query -
+    // allowMask is set if the path is found whatever the method
+    const RdHttpSpan&  path      = _httpParser.getPath();
+    RestAPIEndpointDef *pEndpoint = pWebServer->matchRoute(pHttpReq + path._pos, path._len, httpMethod,
+                                                           _routeParams, _numRouteParams, _reqAllowMask);
+    if (pEndpoint)
+    {
+        for (int paramIdx = 0; paramIdx < _numRouteParams; paramIdx++)
+        {
+            RestAPIParam& param = _routeParams[paramIdx];
+            param._valueLen = RestAPIEndpoints::urlDecodeInPlace((char *)param._pValue, param._valueLen, false);
         }
+        const RdHttpSpan& query = _httpParser.getQuery();
+        _reqEndpointStr = pEndpoint->_pEndpointStr;
+        RestAPIEndpoints::formDecodedStringFromCharBuf(_reqArgStr, pHttpReq + query._pos, query._len, true);
+    }
+    else if (_reqAllowMask == 0)
+    {
+        pEndpoint = pWebServer->getEndpoint(_reqEndpointStr.c_str(), httpMethod, _reqAllowMask);
+    }
+    _pReqEndpoint = pEndpoint;
+}
+
+////////////////////////////////////////////
+// Set up reception of the body - any of it received with the header is already in the
+// payload area
+void RdWebClient::startRequestBody()
+{
+    int headerLen    = _httpParser.getHeaderLen();
+    int payloadRxLen = _rxLen - (headerLen + 1);
+
+    // Get the length of the payload - bodies which are too big for the receive buffer are
+    // only accepted by upload endpoints - others are rejected without reading the body
+    int payloadLen = _httpParser.getContentLength();
+    RDWS_LOG_TRACE("WebClient Payload length %d", payloadLen);
+    _bodyStreamed = (_pReqEndpoint != NULL) && (_pReqEndpoint->_endpointType == RestAPIEndpointDef::ENDPOINT_UPLOAD);
+    if ((payloadLen > HTTP_MAX_PAYLOAD_LENGTH) && !_bodyStreamed)
+    {
+        _rxPayloadTooLarge = true;
+        payloadLen         = 0;
+    }
+    // Chunked (or otherwise transfer coded) bodies aren't supported - the body mustn't be
+    // taken as the next request so nothing more is read
+    if (_httpParser.hasTransferEncoding())
+    {
+        _rxBodyNotImplemented = true;
+        payloadLen            = 0;
+    }
+    _httpReqPayloadLen = payloadLen;
+    _curHttpPayloadRxPos = (payloadRxLen < payloadLen) ? payloadRxLen : payloadLen;
+    if (_bodyStreamed)
+    {
+        _bodyBufPos = 0;
+        _bodyBufLen = _curHttpPayloadRxPos;
+    }
+
+    // Anything received after the payload belongs to the next request - keep the byte
+    // which the payload terminator overwrites
+    _rxReqLen     = headerLen + 1 + _curHttpPayloadRxPos;
+    _rxReqEndByte = _pRxBuf[_rxReqLen];
+    _pHttpReqPayload[_curHttpPayloadRxPos] = 0;
+}
+
+////////////////////////////////////////////
+// Pass the body held in the payload area to the upload endpoint - whatever it doesn't
+// consume is passed again next time
+void RdWebClient::deliverRequestBody(RdWebServer *pWebServer)
+{
+    RestAPIEndpointMsg apiMsg(_httpParser.getMethod(), _reqEndpointStr.c_str(), _reqArgStr.c_str(), (const char *)_pRxBuf);
+    apiMsg._clientIdx = _clientIdx;
+    apiMsg.setParams(_routeParams, _numRouteParams);
+    apiMsg._pMsgContent     = _pHttpReqPayload + _bodyBufPos;
+    apiMsg._msgContentLen   = _bodyBufLen;
+    apiMsg._contentPos      = _curHttpPayloadRxPos - _bodyBufLen;
+    apiMsg._contentTotalLen = _httpReqPayloadLen;
+    int numConsumed = (_pReqEndpoint->_bodyCallback)(apiMsg);
+    if (numConsumed < 0)
+    {
+        numConsumed = 0;
+    }
+    if (numConsumed > _bodyBufLen)
+    {
+        numConsumed = _bodyBufLen;
     }
+    _bodyBufPos += numConsumed;
+    _bodyBufLen -= numConsumed;
+    pWebServer->getStats()._rxBodyStreamed += numConsumed;
+}
 
-    // Clean up temp buffer
-    delete [] pTCPReadBuf;
+////////////////////////////////////////////
+// Close the connection - the time it was open is recorded
+void RdWebClient::closeConnection()
+{
+    _pTransport->close(_connId);
+    if (_pMetrics)
+    {
+        _pMetrics->recordConnection(_connAcceptUs, _connFirstByteUs, micros());
+    }
+    cleanupTCPRxResources();
+    setState(WEB_CLIENT_NONE);
 }
 
 ////////////////////////////////////////////
 // Clean up resources used for TCP reception
 void RdWebClient::cleanupTCPRxResources()
 {
-    // Deallocate memory and reset payload length etc
-    _httpReqPayloadLen  = 0;
-    _httpHeaderComplete = false;
-    delete [] _pHttpReqPayload;
-    _pHttpReqPayload = NULL;
-    _httpReqStr      = "";
+    // Reset payload length etc - the receive buffer is reused
+    _rxLen                = 0;
+    _rxReqLen             = 0;
+    _httpReqPayloadLen    = 0;
+    _curHttpPayloadRxPos  = 0;
+    _httpHeaderComplete   = false;
+    _pHttpReqPayload      = NULL;
+    _rxPayloadTooLarge    = false;
+    _rxBodyNotImplemented = false;
+    _bodyStreamed         = false;
+    _bodyBufPos           = 0;
+    _bodyBufLen           = 0;
+    _reqRouted            = false;
+    _reqIsPreflight       = false;
+    _pReqEndpoint         = NULL;
+    _reqAllowMask         = 0;
+    _numRouteParams       = 0;
+    _pReqResource         = NULL;
+    _httpParser.reset();
+    if (_pRxBuf)
+    {
+        _pRxBuf[0] = 0;
+    }
+}
+
+////////////////////////////////////////////
+// Respond to a request which can't be handled (pStatus is also the body so must remain valid
+// until sent) - the connection is closed after the response
+void RdWebClient::startErrorResponse(const char *pStatus)
+{
+    _reqTimes._headerCompleteUs = micros();
+    _reqTimes._bodyCompleteUs   = _reqTimes._headerCompleteUs;
+    _reqTimes._handlerStartUs   = _reqTimes._headerCompleteUs;
+    _reqTimes._handlerEndUs     = _reqTimes._headerCompleteUs;
+    _keepAlive = false;
+    formHTTPResponse(pStatus, "text/plain", pStatus, -1);
+    _pResourceToSend = NULL;
+    cleanupTCPRxResources();
+    startResponse();
+}
+
+////////////////////////////////////////////
+// Get ready for the next request on the connection - pipelined data already received is
+// moved to the start of the receive buffer (it is parsed on the next service)
+void RdWebClient::startNextRequest()
+{
+    int pipelinedLen = _httpHeaderComplete ? _rxLen - _rxReqLen : 0;
+    int pipelinedPos = _rxReqLen;
+    cleanupTCPRxResources();
+    if (pipelinedLen > 0)
+    {
+        _pRxBuf[pipelinedPos] = _rxReqEndByte;
+        memmove(_pRxBuf, _pRxBuf + pipelinedPos, pipelinedLen);
+        _rxLen = pipelinedLen;
+        _reqTimes._firstByteUs = micros();
+    }
+    _pRxBuf[_rxLen] = 0;
+}
+
+////////////////////////////////////////////
+// Start sending the response (in sections as needed)
+void RdWebClient::startResponse()
+{
+    _txSegmentIdx         = 0;
+    _txSegmentPos         = 0;
+    _respStarted          = false;
+    _resourceSendBlkCount = 0;
+    _resourceSendMillis   = millis();
+    _resourceSendBlocked  = false;
+    // If the transport can report send buffer space then data is sent straight away
+    // otherwise wait before the first frame as the stack may not be ready
+    if (_pTransport->reportsSendSpace())
+    {
+        setState(WEB_CLIENT_SEND_RESOURCE);
+    }
+    else
+    {
+        setState(WEB_CLIENT_SEND_RESOURCE_WAIT);
+    }
 }
 
 
@@ -200,76 +479,134 @@ void RdWebClient::service(RdWebServer *pWebServer)
     switch (_webClientState)
     {
     case WEB_CLIENT_NONE:
-        // See if a connection is ready to be accepted
-        _TCPClient = pWebServer->available();
-        if (_TCPClient)
-        {
-            // Now connected
-            cleanupTCPRxResources();
-            setState(WEB_CLIENT_ACCEPTED);
-            // Info
-            IPAddress ip    = _TCPClient.remoteIP();
-            String    ipStr = ip;
-            Log.trace("WebClient IP %s", ipStr.c_str());
-        }
+        // Connections are accepted by the web server
         break;
 
     case WEB_CLIENT_ACCEPTED:
        {
            // Check if client is still connected
-           if (!_TCPClient.connected())
+           if (!_pTransport->connected(_connId))
            {
-               Log.trace("WebClient disconnected");
-               _TCPClient.stop();
-               cleanupTCPRxResources();
-               setState(WEB_CLIENT_NONE);
+               RDWS_LOG_TRACE("WebClient disconnected");
+               closeConnection();
                break;
            }
-           // Check for having been in this state for too long
-           if (RdWebServerUtils::isTimeout(millis(), _webClientStateEntryMs, MAX_MS_IN_CLIENT_STATE_WITHOUT_DATA))
+           // Check for having been in this state for too long - a persistent connection
+           // waiting for its next request uses the keep-alive idle timeout
+           unsigned long maxMsWithoutData = MAX_MS_IN_CLIENT_STATE_WITHOUT_DATA;
+           if ((_requestsOnConn > 0) && !_httpHeaderComplete && (_rxLen == 0))
            {
-               Log.trace("WebClient no-data timeout");
-               _TCPClient.stop();
-               cleanupTCPRxResources();
-               setState(WEB_CLIENT_NONE);
+               maxMsWithoutData = _keepAliveIdleMs;
+           }
+           if (RdWebServerUtils::isTimeout(millis(), _webClientStateEntryMs, maxMsWithoutData))
+           {
+               RDWS_LOG_TRACE("WebClient no-data timeout");
+               closeConnection();
+               break;
            }
            // Anything available?
-           int numBytesAvailable = _TCPClient.available();
+           int numBytesAvailable = _pTransport->available(_connId);
            int numToRead         = numBytesAvailable;
            if (numToRead > 0)
            {
-               // Make sure we don't overflow buffers
+               // Limit time spent on one client (buffer overflow is checked when reading)
                if (numToRead > MAX_CHS_IN_SERVICE_LOOP)
                    numToRead = MAX_CHS_IN_SERVICE_LOOP;
-               if (_httpReqStr.length() + numToRead > HTTPD_MAX_REQ_LENGTH)
-                   numToRead = HTTPD_MAX_REQ_LENGTH - _httpReqStr.length();
            }
 
-           // Check if we want to read
-           if (numToRead <= 0)
+           // Check if we want to read - data left over from a pipelined request may not
+           // have been parsed yet and an upload endpoint may not have consumed all of the body
+           // it was passed
+           bool unparsedData = !_httpHeaderComplete && (_httpParser.getParsePos() < _rxLen);
+           if ((numToRead <= 0) && !unparsedData && (_bodyBufLen <= 0))
                return;
 
-           // Handle read from TCP client
-           handleTCPReadData(numToRead);
+           // A header which doesn't fit in the buffer can't be handled - the status says whether
+           // the request line alone was too long
+           _pRespHdrSuffixKeepAlive = &pWebServer->getRespHeaderSuffix(true);
+           _pRespHdrSuffixClose     = &pWebServer->getRespHeaderSuffix(false);
+           if (!_httpHeaderComplete && !unparsedData && (_rxLen >= HTTPD_MAX_REQ_LENGTH))
+           {
+               RDWS_LOG_TRACE("WebClient header too long");
+               pWebServer->getStats()._rxOverflows++;
+               startErrorResponse(_httpParser.isRequestLineComplete() ?
+                            "431 Request Header Fields Too Large" : "414 URI Too Long");
+               break;
+           }
+
+           // Handle read from TCP client, parsing and routing - counting any heap allocations
+           unsigned long heapAllocsBefore = RDWEBSERVER_HEAP_ALLOC_COUNT();
+           if (numToRead > 0)
+           {
+               handleTCPReadData(numToRead);
+           }
+           bool headerWasComplete = _httpHeaderComplete;
+           bool requestValid      = _httpHeaderComplete || parseRxHeader();
+
+           // Route the request as soon as the header is complete
+           if (requestValid && _httpHeaderComplete && !headerWasComplete)
+           {
+               _reqTimes._headerCompleteUs = micros();
+               routeRequest(pWebServer);
+               startRequestBody();
+           }
+           pWebServer->getStats()._rxHeapAllocs += RDWEBSERVER_HEAP_ALLOC_COUNT() - heapAllocsBefore;
+
+           // Requests which can't be parsed get an error response and the connection is closed
+           if (!requestValid)
+           {
+               RDWS_LOG_TRACE("WebClient bad request");
+               pWebServer->getStats()._rxBadRequests++;
+               startErrorResponse("400 Bad Request");
+               break;
+           }
+
+           // Pass any body held for an upload endpoint to it
+           if (_bodyStreamed && (_bodyBufLen > 0))
+           {
+               deliverRequestBody(pWebServer);
+           }
 
            // Check for completion
-           if (_httpHeaderComplete && (_httpReqPayloadLen == _curHttpPayloadRxPos))
+           if (_httpHeaderComplete && (_httpReqPayloadLen == _curHttpPayloadRxPos) && (_bodyBufLen == 0))
            {
-               Log.trace("WebClient received %d", _httpReqStr.length());
-               bool handledOk = false;
-               _pResourceToSend = handleReceivedHttp(handledOk, pWebServer);
-               // clean the received resources
-               cleanupTCPRxResources();
-               // Get ready to send the response (in sections as needed)
-               _resourceSendIdx      = 0;
-               _resourceSendBlkCount = 0;
-               _resourceSendMillis   = millis();
-               // Wait until response complete
-               setState(WEB_CLIENT_SEND_RESOURCE_WAIT);
-               if (!handledOk)
+               RDWS_LOG_TRACE("WebClient received %d", _rxLen);
+               pWebServer->getStats()._requests++;
+               _reqTimes._bodyCompleteUs = micros();
+               _reqTimes._handlerStartUs = _reqTimes._bodyCompleteUs;
+               // Decide whether the connection stays open after the response
+               _requestsOnConn++;
+               _keepAliveIdleMs      = pWebServer->getKeepAliveIdleMs();
+               _keepAliveMaxRequests = pWebServer->getKeepAliveMaxRequests();
+               _keepAlive            = (_keepAliveMaxRequests > 0) &&
+                                       (_requestsOnConn < _keepAliveMaxRequests) &&
+                                       isKeepAliveRequested();
+               // The request stays in the receive buffer until the response is complete
+               if (_rxPayloadTooLarge)
+               {
+                   RDWS_LOG_TRACE("WebClient payload too large");
+                   pWebServer->getStats()._rxTooLarge++;
+                   formHTTPResponse("413 Payload Too Large", "text/plain", "413 Payload Too Large", -1);
+                   _pResourceToSend = NULL;
+               }
+               else if (_rxBodyNotImplemented)
+               {
+                   RDWS_LOG_TRACE("WebClient transfer coding not implemented");
+                   pWebServer->getStats()._rxNotImplemented++;
+                   formHTTPResponse("501 Not Implemented", "text/plain", "501 Not Implemented", -1);
+                   _pResourceToSend = NULL;
+               }
+               else
                {
-                   Log.trace("WebClient couldn't handle request");
+                   bool handledOk = false;
+                   _pResourceToSend = handleReceivedHttp(handledOk, pWebServer);
+                   if (!handledOk)
+                   {
+                       RDWS_LOG_TRACE("WebClient couldn't handle request");
+                   }
                }
+               _reqTimes._handlerEndUs = micros();
+               startResponse();
            }
            else
            {
@@ -281,9 +618,13 @@ void RdWebClient::service(RdWebServer *pWebServer)
 
     case WEB_CLIENT_SEND_RESOURCE_WAIT:
        {
-           // Check how long to wait
-           unsigned long msToWait = MS_WAIT_AFTER_LAST_TCP_FRAME;
-           if ((_pResourceToSend != NULL) && (_resourceSendIdx < _pResourceToSend->_dataLen))
+           // Only used when the transport can't report send buffer space - in that case frames
+           // are paced with fixed delays - check how long to wait
+           RdWebTxSegment blocks[MAX_TX_SEGMENTS + 1];
+           int            numBlocks = 0;
+           int            dataLen   = 0;
+           unsigned long  msToWait  = MS_WAIT_AFTER_LAST_TCP_FRAME;
+           if (getNextTxBlocks(blocks, numBlocks, dataLen))
            {
                msToWait = MS_WAIT_BETWEEN_TCP_FRAMES;
            }
@@ -298,46 +639,335 @@ void RdWebClient::service(RdWebServer *pWebServer)
 
     case WEB_CLIENT_SEND_RESOURCE:
        {
-           if (!_pResourceToSend)
+           if (_pTransport->reportsSendSpace())
            {
-               // Close connection and finish
-               _TCPClient.stop();
-               setState(WEB_CLIENT_NONE);
-               Log.trace("WebClient resp complete");
-               break;
+               serviceSendWithBackpressure();
            }
-           // Send data in chunks based on limited buffer sizes in TCP stack
-           if (_resourceSendIdx >= _pResourceToSend->_dataLen)
+           else
            {
-               // Completed - close client
-               _TCPClient.stop();
-               setState(WEB_CLIENT_NONE);
-               Log.trace("WebClient Sent %s, %d bytes total, %d blocks",
-                        _pResourceToSend->_pResId, _pResourceToSend->_dataLen, _resourceSendBlkCount);
-               break;
+               serviceSendPaced();
            }
+           break;
+       }
+    }
+}
 
-           // Get point and length of next chunk
-           const unsigned char *pMem       = _pResourceToSend->_pData + _resourceSendIdx;
-           int                 toSendBytes = _pResourceToSend->_dataLen - _resourceSendIdx;
-           if (toSendBytes > HTTPD_MAX_RESP_CHUNK_SIZE)
+
+//////////////////////////////////////
+// Time until the client next needs servicing if no network events happen
+unsigned long RdWebClient::msToNextService()
+{
+    switch (_webClientState)
+    {
+    case WEB_CLIENT_ACCEPTED:
+       {
+           // Data left to parse or read, or body held for an upload endpoint
+           bool unparsedData = !_httpHeaderComplete && (_httpParser.getParsePos() < _rxLen);
+           if (unparsedData || (_bodyBufLen > 0) || (_pTransport->available(_connId) > 0))
            {
-               toSendBytes = HTTPD_MAX_RESP_CHUNK_SIZE;
+               return 0;
            }
+           // No-data timeout
+           unsigned long maxMsWithoutData = MAX_MS_IN_CLIENT_STATE_WITHOUT_DATA;
+           if ((_requestsOnConn > 0) && !_httpHeaderComplete && (_rxLen == 0))
+           {
+               maxMsWithoutData = _keepAliveIdleMs;
+           }
+           return RdWebServerUtils::timeToTimeout(millis(), _webClientStateEntryMs, maxMsWithoutData) + 1;
+       }
 
-           // Send next chunk
-//    Log.trace("WebClient Writing %d bytes (%d) = %02x %02x %02x %02x ... %02x %02x %02x", toSendBytes, _resourceSendIdx,
-//             pMem[0], pMem[1], pMem[2], pMem[3], pMem[toSendBytes - 3], pMem[toSendBytes - 2], pMem[toSendBytes - 1]);
+    case WEB_CLIENT_SEND_RESOURCE_WAIT:
+        return RdWebServerUtils::timeToTimeout(millis(), _resourceSendMillis, MS_WAIT_BETWEEN_TCP_FRAMES) + 1;
 
-           _TCPClient.write(pMem, toSendBytes);
-           _TCPClient.flush();
-           _resourceSendIdx += toSendBytes;
-           _resourceSendBlkCount++;
-           _resourceSendMillis = millis();
-           setState(WEB_CLIENT_SEND_RESOURCE_WAIT);
-           break;
-       }
+    case WEB_CLIENT_SEND_RESOURCE:
+        // Waiting for send buffer space (a streaming endpoint is polled for data)
+        if (_resourceSendBlocked)
+        {
+            return RdWebServerUtils::timeToTimeout(millis(), _resourceSendMillis,
+                                                   MAX_MS_IN_CLIENT_STATE_WITHOUT_DATA) + 1;
+        }
+        return 0;
+
+    default:
+        return ULONG_MAX;
+    }
+}
+
+
+//////////////////////////////////////
+// Add a segment to the response - the data must remain valid until the response is sent
+void RdWebClient::addTxSegment(const uint8_t *pData, int len)
+{
+    if ((_numTxSegments >= MAX_TX_SEGMENTS) || (len <= 0))
+    {
+        return;
+    }
+    _txSegments[_numTxSegments]._pData = pData;
+    _txSegments[_numTxSegments]._len   = len;
+    _numTxSegments++;
+}
+
+
+//////////////////////////////////////
+// Get the next blocks of the response to send (written together with a gather write) -
+// returns false when all sent - dataLen is 0 if a streaming endpoint has nothing to send yet
+bool RdWebClient::getNextTxBlocks(RdWebTxSegment *pBlocks, int& numBlocks, int& dataLen)
+{
+    numBlocks = 0;
+    dataLen   = 0;
+    if ((_txSegmentIdx >= _numTxSegments) &&
+        ((_pStreamEndpoint == NULL) || ((_txChunkSendIdx >= _txChunkLen) && _streamComplete)))
+    {
+        return false;
+    }
+
+    // Segments (header and, for REST API responses and static resources, body) first - data
+    // is sent in blocks based on limited buffer sizes in TCP stack
+    int segIdx = _txSegmentIdx;
+    int segPos = _txSegmentPos;
+    while ((segIdx < _numTxSegments) && (dataLen < HTTPD_MAX_RESP_CHUNK_SIZE))
+    {
+        int len = _txSegments[segIdx]._len - segPos;
+        if (len > HTTPD_MAX_RESP_CHUNK_SIZE - dataLen)
+        {
+            len = HTTPD_MAX_RESP_CHUNK_SIZE - dataLen;
+        }
+        pBlocks[numBlocks]._pData = _txSegments[segIdx]._pData + segPos;
+        pBlocks[numBlocks]._len   = len;
+        numBlocks++;
+        dataLen += len;
+        segIdx++;
+        segPos = 0;
+    }
+
+    // Then the chunks of a streaming response - the next chunk is requested from the endpoint
+    // once the previous one has been sent (it may have nothing to send yet)
+    if ((segIdx >= _numTxSegments) && (dataLen < HTTPD_MAX_RESP_CHUNK_SIZE) &&
+        (_pStreamEndpoint != NULL) && ((_txChunkSendIdx < _txChunkLen) || !_streamComplete))
+    {
+        if (_txChunkSendIdx >= _txChunkLen)
+        {
+            fillStreamChunk();
+        }
+        int len = _txChunkLen - _txChunkSendIdx;
+        if (len > HTTPD_MAX_RESP_CHUNK_SIZE - dataLen)
+        {
+            len = HTTPD_MAX_RESP_CHUNK_SIZE - dataLen;
+        }
+        if (len > 0)
+        {
+            pBlocks[numBlocks]._pData = _pTxChunkBuf + _txChunkSendIdx;
+            pBlocks[numBlocks]._len   = len;
+            numBlocks++;
+            dataLen += len;
+        }
     }
+    return true;
+}
+
+
+//////////////////////////////////////
+// Account for data sent
+void RdWebClient::advanceTx(int numBytes)
+{
+    while ((numBytes > 0) && (_txSegmentIdx < _numTxSegments))
+    {
+        int segLeft = _txSegments[_txSegmentIdx]._len - _txSegmentPos;
+        if (numBytes < segLeft)
+        {
+            _txSegmentPos += numBytes;
+            return;
+        }
+        numBytes     -= segLeft;
+        _txSegmentIdx++;
+        _txSegmentPos = 0;
+    }
+    _txChunkSendIdx += numBytes;
+}
+
+
+//////////////////////////////////////
+// Time the first write of the response
+void RdWebClient::respBytesWritten()
+{
+    if (!_respStarted)
+    {
+        _respStarted               = true;
+        _reqTimes._firstRespByteUs = micros();
+    }
+}
+
+
+//////////////////////////////////////
+// Get the next chunk of a streaming response from the endpoint's callback - the chunk size
+// line is placed immediately before the data
+void RdWebClient::fillStreamChunk()
+{
+    RestAPIStreamSink sink(_pTxChunkBuf + STREAM_CHUNK_HDR_LEN, STREAM_CHUNK_MAX_DATA);
+    RestAPIEndpointMsg apiMsg(_httpParser.getMethod(), _reqEndpointStr.c_str(), _reqArgStr.c_str(), (const char *)_pRxBuf);
+    apiMsg._clientIdx = _clientIdx;
+    apiMsg._pMsgContent   = _pHttpReqPayload;
+    apiMsg._msgContentLen = _httpReqPayloadLen;
+    apiMsg._streamPos     = _streamPos;
+    apiMsg.setParams(_routeParams, _numRouteParams);
+    bool moreToCome = (_pStreamEndpoint->_streamCallback)(apiMsg, sink);
+    _streamPos = apiMsg._streamPos;
+
+    // Chunk framing is only used for HTTP/1.1 clients
+    int dataLen = sink.length();
+    _txChunkSendIdx = STREAM_CHUNK_HDR_LEN;
+    _txChunkLen     = STREAM_CHUNK_HDR_LEN + dataLen;
+    if (_streamChunked && (dataLen > 0))
+    {
+        char chunkHdr[STREAM_CHUNK_HDR_LEN + 1];
+        int  chunkHdrLen = snprintf(chunkHdr, sizeof(chunkHdr), "%x\r\n", dataLen);
+        _txChunkSendIdx -= chunkHdrLen;
+        memcpy(_pTxChunkBuf + _txChunkSendIdx, chunkHdr, chunkHdrLen);
+        memcpy(_pTxChunkBuf + _txChunkLen, "\r\n", 2);
+        _txChunkLen += 2;
+    }
+    if (!moreToCome)
+    {
+        _streamComplete = true;
+        if (_streamChunked)
+        {
+            memcpy(_pTxChunkBuf + _txChunkLen, "0\r\n\r\n", 5);
+            _txChunkLen += 5;
+        }
+    }
+}
+
+
+//////////////////////////////////////
+// Response complete
+void RdWebClient::responseComplete()
+{
+    // Record the request's timings against its endpoint or resource
+    _reqTimes._respCompleteUs = micros();
+    if (!_respStarted)
+    {
+        _reqTimes._firstRespByteUs = _reqTimes._respCompleteUs;
+    }
+    if (_pMetrics)
+    {
+        if (_pReqResource)
+        {
+            _pMetrics->recordRequest(_reqTimes, RdWebServerMetrics::SERIES_RESOURCE, _pReqResource, _pReqResource->_pResId);
+        }
+        else if (_pReqEndpoint)
+        {
+            _pMetrics->recordRequest(_reqTimes, RdWebServerMetrics::SERIES_ENDPOINT, _pReqEndpoint, _pReqEndpoint->_pEndpointStr);
+        }
+        else
+        {
+            _pMetrics->recordRequest(_reqTimes, RdWebServerMetrics::SERIES_OTHER, NULL, "");
+        }
+    }
+
+    // Persistent connections go back to waiting for the next request - otherwise close
+    // connection and finish
+    // The request is no longer needed (any pipelined request following it is kept)
+    if (_keepAlive && _pTransport->connected(_connId))
+    {
+        startNextRequest();
+        setState(WEB_CLIENT_ACCEPTED);
+    }
+    else
+    {
+        closeConnection();
+    }
+    _pStreamEndpoint = NULL;
+    _numTxSegments   = 0;
+    if (_pResourceToSend)
+    {
+        RDWS_LOG_TRACE("WebClient Sent %s, %d bytes total, %d blocks",
+                  _pResourceToSend->_pResId, _pResourceToSend->_dataLen, _resourceSendBlkCount);
+    }
+    else
+    {
+        RDWS_LOG_TRACE("WebClient resp complete");
+    }
+    _httpRespBodyStr = "";
+}
+
+
+//////////////////////////////////////
+// Send as much of the response as the transport has buffer space for
+void RdWebClient::serviceSendWithBackpressure()
+{
+    RdWebTxSegment blocks[MAX_TX_SEGMENTS + 1];
+    int            numBlocks = 0;
+    int            dataLen   = 0;
+    while (getNextTxBlocks(blocks, numBlocks, dataLen))
+    {
+        // Streaming endpoint has nothing to send yet
+        if (dataLen == 0)
+        {
+            return;
+        }
+        int numWritten = _pTransport->writev(_connId, blocks, numBlocks);
+        if (numWritten < 0)
+        {
+            RDWS_LOG_TRACE("WebClient write failed");
+            responseComplete();
+            return;
+        }
+        _resourceSendBlocked = (numWritten < dataLen);
+        if (numWritten > 0)
+        {
+            respBytesWritten();
+            advanceTx(numWritten);
+            _resourceSendBlkCount++;
+            _resourceSendMillis = millis();
+        }
+        // Send buffer full - continue when there is space
+        if (numWritten < dataLen)
+        {
+            // Give up if the other end isn't taking data
+            if (RdWebServerUtils::isTimeout(millis(), _resourceSendMillis, MAX_MS_IN_CLIENT_STATE_WITHOUT_DATA))
+            {
+                RDWS_LOG_TRACE("WebClient send timeout");
+                responseComplete();
+            }
+            return;
+        }
+    }
+    responseComplete();
+}
+
+
+//////////////////////////////////////
+// Send the next frame of the response and wait a fixed time (for stacks which can't report
+// buffer space)
+void RdWebClient::serviceSendPaced()
+{
+    RdWebTxSegment blocks[MAX_TX_SEGMENTS + 1];
+    int            numBlocks = 0;
+    int            dataLen   = 0;
+    if (!getNextTxBlocks(blocks, numBlocks, dataLen))
+    {
+        responseComplete();
+        return;
+    }
+
+    // Send next blocks together (a streaming endpoint may have nothing to send yet)
+    if (dataLen > 0)
+    {
+        _pTransport->writev(_connId, blocks, numBlocks);
+        _pTransport->flush(_connId);
+        respBytesWritten();
+        advanceTx(dataLen);
+        _resourceSendBlkCount++;
+        _resourceSendMillis = millis();
+    }
+
+    // The wait after the last frame is only needed before closing the connection
+    if (_keepAlive && !getNextTxBlocks(blocks, numBlocks, dataLen))
+    {
+        responseComplete();
+        return;
+    }
+    setState(WEB_CLIENT_SEND_RESOURCE_WAIT);
 }
 
 
@@ -348,91 +978,195 @@ RdWebServerResourceDescr *RdWebClient::handleReceivedHttp(bool& handledOk, RdWeb
     handledOk = false;
     RdWebServerResourceDescr *pResourceToRespondWith = NULL;
 
-    // Request string
-    const char *pHttpReq = _httpReqStr.c_str();
+    // Request string and method (from the parser) - the request was routed when its header
+    // was complete
+    const char *pHttpReq  = (const char *)_pRxBuf;
+    int        httpMethod = _httpParser.getMethod();
 
-    // Get HTTP method
-    int httpMethod = METHOD_OTHER;
-    if (strncmp(pHttpReq, "GET ", 4) == 0)
-    {
-        httpMethod = METHOD_GET;
-    }
-    else if (strncmp(pHttpReq, "POST", 4) == 0)
+    // CORS preflight requests are answered with the preformatted response
+    if (_reqIsPreflight)
     {
-        httpMethod = METHOD_POST;
+        const String& preflightResp = pWebServer->getPreflightResponse(_keepAlive);
+        RDWS_LOG_TRACE("WebClient CORS preflight");
+        addTxSegment((const uint8_t *)preflightResp.c_str(), preflightResp.length());
+        pWebServer->getStats()._corsPreflights++;
+        handledOk = true;
+        return NULL;
     }
-    else if (strncmp(pHttpReq, "OPTIONS", 7) == 0)
+
+    // Methods which aren't recognised weren't routed
+    if (httpMethod == RdHttpRequestParser::METHOD_OTHER)
     {
-        httpMethod = METHOD_OPTIONS;
+        RDWS_LOG_TRACE("WebClient method not implemented");
+        formHTTPResponse("501 Not Implemented", "text/plain", "501 Not Implemented", -1);
+        handledOk = true;
+        return NULL;
     }
 
     // See if there is a valid HTTP command
-    String endpointStr, argStr;
-    if (extractEndpointArgs(pHttpReq + 3, endpointStr, argStr))
+    const String& endpointStr = _reqEndpointStr;
+    const String& argStr      = _reqArgStr;
+    if (_reqRouted)
     {
-        // Received cmd and arguments
-        Log.trace("WebClient handleHTTP EndPtStr %s ArgStr %s", endpointStr.c_str(), argStr.c_str());
-
         // Handle REST API commands
-        RestAPIEndpointDef *pEndpoint = pWebServer->getEndpoint(endpointStr);
+        RestAPIEndpointDef *pEndpoint = _pReqEndpoint;
+        int                allowMask  = _reqAllowMask;
         if (pEndpoint)
         {
-            Log.trace("WebClient FoundEndpoint <%s> Type %d", endpointStr.c_str(), pEndpoint->_endpointType);
-            if (pEndpoint->_endpointType == RestAPIEndpointDef::ENDPOINT_CALLBACK)
+            RDWS_LOG_TRACE("WebClient FoundEndpoint <%s> Type %d", endpointStr.c_str(), pEndpoint->_endpointType);
+            if ((pEndpoint->_endpointType == RestAPIEndpointDef::ENDPOINT_CALLBACK) ||
+                (pEndpoint->_endpointType == RestAPIEndpointDef::ENDPOINT_UPLOAD))
             {
-                String             retStr;
+                // The body of an upload has already been passed to the endpoint - the response
+                // body is sent from where the endpoint puts it
                 RestAPIEndpointMsg apiMsg(httpMethod, endpointStr.c_str(), argStr.c_str(), pHttpReq);
-                apiMsg._pMsgContent   = _pHttpReqPayload;
-                apiMsg._msgContentLen = _httpReqPayloadLen;
-                (pEndpoint->_callback)(apiMsg, retStr);
-                Log.trace("WebClient api response len %d", retStr.length());
+                apiMsg._clientIdx = _clientIdx;
+                apiMsg.setParams(_routeParams, _numRouteParams);
+                if (_bodyStreamed)
+                {
+                    apiMsg._contentPos      = _httpReqPayloadLen;
+                    apiMsg._contentTotalLen = _httpReqPayloadLen;
+                }
+                else
+                {
+                    apiMsg._pMsgContent   = _pHttpReqPayload;
+                    apiMsg._msgContentLen = _httpReqPayloadLen;
+                }
+                (pEndpoint->_callback)(apiMsg, _httpRespBodyStr);
+                RDWS_LOG_TRACE("WebClient api response len %d", _httpRespBodyStr.length());
                 if (strlen(pEndpoint->_pContentType) == 0)
                 {
-                    formHTTPResponse(_httpRespStr, "200 OK", "application/json", retStr.c_str(), -1);
+                    formHTTPResponse("200 OK", "application/json", _httpRespBodyStr.c_str(), -1);
                 }
                 else
                 {
-                    formHTTPResponse(_httpRespStr, "200 OK", pEndpoint->_pContentType, retStr.c_str(), -1);
+                    formHTTPResponse("200 OK", pEndpoint->_pContentType, _httpRespBodyStr.c_str(), -1);
                 }
-                Log.trace("WebClient http response len %d", _httpRespStr.length());
-                // These delays arrived at by experimentation - 15ms seems ok, 10ms is not
-                delay(20);
-                _TCPClient.write((uint8_t *)_httpRespStr.c_str(), _httpRespStr.length());
-                Log.trace("WebClient write to tcp clientIdx %d len %d", _clientIdx, _httpRespStr.length());
-                // See comment above
-                delay(20);
-                _TCPClient.flush();
                 handledOk = true;
             }
+            else if ((pEndpoint->_endpointType == RestAPIEndpointDef::ENDPOINT_STREAM) &&
+                     (httpMethod == RdHttpRequestParser::METHOD_HEAD))
+            {
+                // Header only so the stream isn't started
+                const char *pContentType = (strlen(pEndpoint->_pContentType) == 0) ? "application/json" : pEndpoint->_pContentType;
+                formHTTPResponse("200 OK", pContentType, "",
+                                 _httpParser.isHttp11() ? CONTENT_LENGTH_CHUNKED : CONTENT_LENGTH_UNKNOWN);
+                handledOk = true;
+            }
+            else if (pEndpoint->_endpointType == RestAPIEndpointDef::ENDPOINT_STREAM)
+            {
+                // Only the header is formed now - the body is requested from the endpoint
+                // a chunk at a time while sending - HTTP/1.0 clients don't support chunked
+                // encoding so the end of the body is signalled by closing the connection
+                _pStreamEndpoint   = pEndpoint;
+                _streamPos         = 0;
+                _streamComplete    = false;
+                _streamChunked     = _httpParser.isHttp11();
+                _txChunkSendIdx    = 0;
+                _txChunkLen        = 0;
+                if (!_streamChunked)
+                {
+                    _keepAlive = false;
+                }
+                const char *pContentType = (strlen(pEndpoint->_pContentType) == 0) ? "application/json" : pEndpoint->_pContentType;
+                formHTTPResponse("200 OK", pContentType, "",
+                                 _streamChunked ? CONTENT_LENGTH_CHUNKED : CONTENT_LENGTH_UNKNOWN);
+                handledOk = true;
+            }
+        }
+
+        // Endpoint found but not for this method
+        if (!handledOk && (allowMask != 0))
+        {
+            formMethodNotAllowedResponse(allowMask);
+            handledOk = true;
         }
 
         // Look for the command in the static resources
         if (!handledOk)
         {
-            for (int wsResIdx = 0; wsResIdx < pWebServer->getNumResources(); wsResIdx++)
+            // An empty path is the index page
+            RdWebServerResourceDescr *pRes = pWebServer->findResource(endpointStr.length() == 0 ? "index.html" : endpointStr.c_str());
+            bool isHead = (httpMethod == RdHttpRequestParser::METHOD_HEAD);
+            if ((pRes != NULL) && (pRes->_pData != NULL) && !isHead && (httpMethod != RdHttpRequestParser::METHOD_GET))
+            {
+                formMethodNotAllowedResponse(RestAPIEndpointDef::METHOD_MASK_GET | RestAPIEndpointDef::METHOD_MASK_HEAD);
+                handledOk = true;
+            }
+            else if ((pRes != NULL) && (pRes->_pData != NULL))
             {
-                RdWebServerResourceDescr *pRes = pWebServer->getResource(wsResIdx);
-                if ((strcasecmp(pRes->_pResId, endpointStr) == 0) ||
-                    ((strlen(endpointStr) == 0) && (strcasecmp(pRes->_pResId, "index.html") == 0)))
+                RDWS_LOG_TRACE("WebClient sending resource %s, %d bytes, %s",
+                          pRes->_pResId, pRes->_dataLen, pRes->_pMimeType);
+                _pReqResource = pRes;
+                // Header - precomputed (with the server's suffix) if available - is sent
+                // ahead of the resource data
+                if (pRes->_pRespHeader != NULL)
                 {
-                    if (pRes->_pData != NULL)
+                    // Use the first encoded variant (in order of preference) which the
+                    // client accepts
+                    const uint8_t *pData          = pRes->_pData;
+                    int           dataLen         = pRes->_dataLen;
+                    const char    *pRespHeader    = pRes->_pRespHeader;
+                    int           respHeaderLen   = pRes->_respHeaderLen;
+                    const char    *pCacheHeaders  = pRes->_pCacheHeaders;
+                    int           cacheHeadersLen = pRes->_cacheHeadersLen;
+                    const char    *pETag          = pRes->_pETag;
+                    RdHttpSpan    acceptEncoding;
+                    if ((pRes->_numVariants > 0) && _httpParser.findHeader(_pRxBuf, "Accept-Encoding", acceptEncoding))
+                    {
+                        for (int varIdx = 0; varIdx < pRes->_numVariants; varIdx++)
+                        {
+                            const RdWebServerResourceVariant& variant = pRes->_pVariants[varIdx];
+                            if (RdHttpRequestParser::acceptsToken(_pRxBuf, acceptEncoding, variant._pEncoding))
+                            {
+                                RDWS_LOG_TRACE("WebClient using %s encoding, %d bytes", variant._pEncoding, variant._dataLen);
+                                pData           = variant._pData;
+                                dataLen         = variant._dataLen;
+                                pRespHeader     = variant._pRespHeader;
+                                respHeaderLen   = variant._respHeaderLen;
+                                pCacheHeaders   = variant._pCacheHeaders;
+                                cacheHeadersLen = variant._cacheHeadersLen;
+                                pETag           = variant._pETag;
+                                break;
+                            }
+                        }
+                    }
+                    // The body isn't sent if the client already has this version
+                    const String& hdrSuffix = pWebServer->getRespHeaderSuffix(_keepAlive);
+                    RdHttpSpan    ifNoneMatch;
+                    if ((pETag != NULL) &&
+                        _httpParser.findHeader(_pRxBuf, "If-None-Match", ifNoneMatch) &&
+                        RdHttpRequestParser::matchesETag(_pRxBuf, ifNoneMatch, pETag))
                     {
-                        Log.trace("WebClient sending resource %s, %d bytes, %s",
-                                  pRes->_pResId, pRes->_dataLen, pRes->_pMimeType);
-                        // Form header
-                        formHTTPResponse(_httpRespStr, "200 OK", pRes->_pMimeType, "", pRes->_dataLen);
-                        _TCPClient.write((uint8_t *)_httpRespStr.c_str(), _httpRespStr.length());
-
-                        /*const char *pBuff   = _httpRespStr.c_str();
-                         * const int  bufffLen = strlen(pBuff);
-                         * Log.trace("Header %d = %02x %02x %02x ... %02x %02x %02x", _httpRespStr.length(),
-                         *        pBuff[0], pBuff[1], pBuff[2], pBuff[bufffLen - 3], pBuff[bufffLen - 2], pBuff[bufffLen - 1]);*/
-                        _TCPClient.flush();
-                        // Respond with static resource
+                        RDWS_LOG_TRACE("WebClient %s not modified", pRes->_pResId);
+                        addTxSegment((const uint8_t *)HTTP_NOT_MODIFIED_STATUS_LINE, strlen(HTTP_NOT_MODIFIED_STATUS_LINE));
+                        addTxSegment((const uint8_t *)pCacheHeaders, cacheHeadersLen);
+                        addTxSegment((const uint8_t *)hdrSuffix.c_str(), hdrSuffix.length());
+                        handledOk = true;
+                    }
+                    else
+                    {
+                        addTxSegment((const uint8_t *)pRespHeader, respHeaderLen);
+                        addTxSegment((const uint8_t *)pCacheHeaders, cacheHeadersLen);
+                        addTxSegment((const uint8_t *)hdrSuffix.c_str(), hdrSuffix.length());
+                        if (!isHead)
+                        {
+                            addTxSegment(pData, dataLen);
+                        }
                         pResourceToRespondWith = pRes;
                         handledOk = true;
                     }
-                    break;
+                }
+                else
+                {
+                    formHTTPResponse("200 OK", pRes->_pMimeType, "", pRes->_dataLen);
+                    if (!isHead)
+                    {
+                        addTxSegment(pRes->_pData, pRes->_dataLen);
+                    }
+                    // Respond with static resource
+                    pResourceToRespondWith = pRes;
+                    handledOk = true;
                 }
             }
         }
@@ -440,116 +1174,195 @@ RdWebServerResourceDescr *RdWebClient::handleReceivedHttp(bool& handledOk, RdWeb
         // If not handled ok
         if (!handledOk)
         {
-            Log.trace("WebClient Endpoint %s not found or invalid", endpointStr.c_str());
+            RDWS_LOG_TRACE("WebClient Endpoint %s not found or invalid", endpointStr.c_str());
         }
     }
     else
     {
-        Log.trace("WebClient Cannot find command or args");
+        RDWS_LOG_TRACE("WebClient Cannot find command or args");
     }
 
     // Handle situations where the command wasn't handled ok
     if (!handledOk)
     {
-        Log.trace("WebClient Returning 404 Not found");
-        formHTTPResponse(_httpRespStr, "404 Not Found", "text/plain", "404 Not Found", -1);
-        _TCPClient.write((uint8_t *)_httpRespStr.c_str(), _httpRespStr.length());
+        RDWS_LOG_TRACE("WebClient Returning 404 Not found");
+        formHTTPResponse("404 Not Found", "text/plain", "404 Not Found", -1);
     }
     return pResourceToRespondWith;
 }
 
 
 //////////////////////////////////////
-// Extract arguments from rest api string
-bool RdWebClient::extractEndpointArgs(const char *buf, String& endpointStr, String& argStr)
+// Extract endpoint and arguments from the request target - the endpoint is the first
+// part of the path and the arguments are everything after it
+bool RdWebClient::extractEndpointArgs(const char *pTarget, int targetLen, String& endpointStr, String& argStr)
 {
-    if (buf == NULL)
+    if (pTarget == NULL)
     {
         return false;
     }
 
     // Check for first slash
-    char *pSlash1 = strchr(buf, '/');
-    if (pSlash1 == NULL)
+    const char *pTargetEnd = pTarget + targetLen;
+    const char *pCh        = (const char *)memchr(pTarget, '/', targetLen);
+    if (pCh == NULL)
     {
         return false;
     }
-    pSlash1++;
+    pCh++;
     // Extract command
-    while (*pSlash1)
+    const char *pEndpoint = pCh;
+    while ((pCh < pTargetEnd) && (*pCh != '/') && (*pCh != '?') && (*pCh != '&'))
     {
-        if ((*pSlash1 == '/') || (*pSlash1 == ' ') || (*pSlash1 == '\n') ||
-            (*pSlash1 == '?') || (*pSlash1 == '&'))
-        {
-            break;
-        }
-        endpointStr.concat(*pSlash1++);
-    }
-    if ((*pSlash1 == '\0') || (*pSlash1 == ' ') || (*pSlash1 == '\n'))
-    {
-        return true;
+        pCh++;
     }
+    // Escaped characters are decoded as the strings are formed (once only)
+    RestAPIEndpoints::formDecodedStringFromCharBuf(endpointStr, pEndpoint, pCh - pEndpoint, false);
     // Now args
-    pSlash1++;
-    while (*pSlash1)
+    if (pCh < pTargetEnd)
     {
-        if ((*pSlash1 == ' ') || (*pSlash1 == '\n'))
-        {
-            break;
-        }
-        argStr.concat(*pSlash1++);
+        pCh++;
+        RestAPIEndpoints::formDecodedStringFromCharBuf(argStr, pCh, pTargetEnd - pCh, true);
     }
-    // Convert escaped characters
-    RestAPIEndpoints::unencodeHTTPChars(endpointStr);
-    RestAPIEndpoints::unencodeHTTPChars(argStr);
     return true;
 }
 
 
-int RdWebClient::getContentLengthFromHeader(const char *msgBuf)
+//////////////////////////////////////
+// Check if the client wants the connection kept open - HTTP/1.1 connections are persistent
+// unless "Connection: close" is specified, HTTP/1.0 ones only with "Connection: keep-alive"
+// Requests with a payload too big to receive (or which can't be received) can't be followed
+// by another request
+bool RdWebClient::isKeepAliveRequested()
 {
-    char *ptr = strstr(msgBuf, "Content-Length:");
-
-    if (ptr)
+    if (_rxPayloadTooLarge || _rxBodyNotImplemented)
     {
-        ptr += 15;
-        int contentLen = atoi(ptr);
-        if (contentLen >= 0)
-        {
-            return contentLen;
-        }
+        return false;
+    }
+    if (_httpParser.isHttp11())
+    {
+        return !_httpParser.connectionClose();
     }
-    return 0;
+    return _httpParser.connectionKeepAlive();
 }
 
 
-// Form a header to respond
-void RdWebClient::formHTTPResponse(String& respStr, const char *rsltCode,
-                                   const char *contentType, const char *respBody, int contentLen)
+// Form a response - the status line and headers specific to this response are formatted
+// into the header buffer and sent with the server's header suffix and the body
+void RdWebClient::formHTTPResponse(const char *rsltCode,
+                                   const char *contentType, const char *respBody, int contentLen,
+                                   const char *pExtraHdrs)
 {
+    int bodyLen = strlen(respBody);
     if (contentLen == -1)
     {
-        contentLen = strlen(respBody);
+        contentLen = bodyLen;
     }
-    respStr = String::format("HTTP/1.1 %s\r\nAccess-Control-Allow-Origin: *\r\nContent-Type: %s\r\nConnection: close\r\nContent-Length: %d\r\n\r\n%s", rsltCode, contentType, contentLen, respBody);
+    // HEAD gets the headers of the response (including its length) but not the body
+    if (_httpParser.getMethod() == RdHttpRequestParser::METHOD_HEAD)
+    {
+        bodyLen = 0;
+    }
+    // Length of body (if known)
+    char lengthHdr[40];
+    lengthHdr[0] = 0;
+    if (contentLen == CONTENT_LENGTH_CHUNKED)
+    {
+        snprintf(lengthHdr, sizeof(lengthHdr), "Transfer-Encoding: chunked\r\n");
+    }
+    else if (contentLen >= 0)
+    {
+        snprintf(lengthHdr, sizeof(lengthHdr), "Content-Length: %d\r\n", contentLen);
+    }
+    int hdrLen = snprintf(_txHdrBuf, sizeof(_txHdrBuf), "HTTP/1.1 %s\r\nContent-Type: %s\r\n%s%s",
+                          rsltCode, contentType, pExtraHdrs, lengthHdr);
+    if (hdrLen >= (int)sizeof(_txHdrBuf))
+    {
+        hdrLen = sizeof(_txHdrBuf) - 1;
+    }
+    // The suffix (CORS and connection headers) ends the header
+    const String *pHdrSuffix = _keepAlive ? _pRespHdrSuffixKeepAlive : _pRespHdrSuffixClose;
+    addTxSegment((const uint8_t *)_txHdrBuf, hdrLen);
+    if (pHdrSuffix)
+    {
+        addTxSegment((const uint8_t *)pHdrSuffix->c_str(), pHdrSuffix->length());
+    }
+    else
+    {
+        addTxSegment((const uint8_t *)"\r\n", 2);
+    }
+    addTxSegment((const uint8_t *)respBody, bodyLen);
 }
 
 
-RdWebServer::RdWebServer()
+//////////////////////////////////////
+// Form 405 response
+void RdWebClient::formMethodNotAllowedResponse(int allowMask)
 {
-    _pTCPServer            = NULL;
+    char allowHdr[80];
+    int  hdrLen = snprintf(allowHdr, sizeof(allowHdr), "Allow:");
+    for (int method = 0; method < RdHttpRequestParser::NUM_METHODS; method++)
+    {
+        const char *pName = RdHttpRequestParser::getMethodName(method);
+        if (pName && (allowMask & (1 << method)) && (hdrLen < (int)sizeof(allowHdr)))
+        {
+            hdrLen += snprintf(allowHdr + hdrLen, sizeof(allowHdr) - hdrLen, "%s %s",
+                               (hdrLen > (int)strlen("Allow:")) ? "," : "", pName);
+        }
+    }
+    if (hdrLen < (int)sizeof(allowHdr))
+    {
+        snprintf(allowHdr + hdrLen, sizeof(allowHdr) - hdrLen, "\r\n");
+    }
+    RDWS_LOG_TRACE("WebClient method not allowed - %s", allowHdr);
+    formHTTPResponse("405 Method Not Allowed", "text/plain", "405 Method Not Allowed", -1, allowHdr);
+}
+
+
+RdWebServer::RdWebServer(int maxWebClients, RdWebServerTransport *pTransport)
+{
+    _pTransport            = pTransport;
+    _ownTransport          = false;
+    _transportBegun        = false;
+    _transportBeginFailed  = false;
     _pRestAPIEndpoints     = NULL;
     _pWebServerResources   = NULL;
     _numWebServerResources = 0;
+    _pWebServerResourceIndex = NULL;
     _TCPPort                     = 80;
     _webServerState              = WEB_SERVER_STOPPED;
     _webServerStateEntryMs       = 0;
     _numWebServerResources       = 0;
     _webServerActiveLastUnixTime = 0;
-    // Configure each client
-    for (int clientIdx = 0; clientIdx < MAX_WEB_CLIENTS; clientIdx++)
+    _keepAliveIdleMs             = DEFAULT_KEEP_ALIVE_IDLE_MS;
+    _keepAliveMaxRequests        = DEFAULT_KEEP_ALIVE_MAX_REQUESTS;
+    _maxServiceWaitMs            = DEFAULT_MAX_SERVICE_WAIT_MS;
+    setCORSPolicy("*");
+    // Use the default transport if none specified
+    if (!_pTransport)
+    {
+        _pTransport   = new RdWebTransportDefault();
+        _ownTransport = true;
+    }
+    // Client pool - all clients start on the free list
+    if (maxWebClients < 1)
+    {
+        maxWebClients = 1;
+    }
+    _maxWebClients       = maxWebClients;
+    _pWebClients         = new RdWebClient[_maxWebClients];
+    _pFreeClientIdxs     = new int[_maxWebClients];
+    _pActiveClientIdxs   = new int[_maxWebClients];
+    _pRxBufferPool       = new uint8_t[_maxWebClients * RdWebClient::RX_BUFFER_SIZE];
+    _pTxChunkBufferPool  = new uint8_t[_maxWebClients * RdWebClient::TX_CHUNK_BUFFER_SIZE];
+    _numActiveClients    = 0;
+    _numFreeClients      = 0;
+    for (int clientIdx = _maxWebClients - 1; clientIdx >= 0; clientIdx--)
     {
-        _webClients[clientIdx].setClientIdx(clientIdx);
+        _pWebClients[clientIdx].setClientIdx(clientIdx, _pTransport, &_metrics);
+        _pWebClients[clientIdx].setRxBuffer(_pRxBufferPool + clientIdx * RdWebClient::RX_BUFFER_SIZE);
+        _pWebClients[clientIdx].setTxChunkBuffer(_pTxChunkBufferPool + clientIdx * RdWebClient::TX_CHUNK_BUFFER_SIZE);
+        _pFreeClientIdxs[_numFreeClients++] = clientIdx;
     }
 }
 
@@ -557,6 +1370,19 @@ RdWebServer::RdWebServer()
 // Destructor
 RdWebServer::~RdWebServer()
 {
+    if (_transportBegun)
+    {
+        stop();
+    }
+    if (_ownTransport)
+    {
+        delete _pTransport;
+    }
+    delete [] _pWebClients;
+    delete [] _pFreeClientIdxs;
+    delete [] _pActiveClientIdxs;
+    delete [] _pRxBufferPool;
+    delete [] _pTxChunkBufferPool;
 }
 
 
@@ -598,54 +1424,100 @@ void RdWebServer::setState(WebServerState newState)
 {
     _webServerState        = newState;
     _webServerStateEntryMs = millis();
-    Log.trace("WebServerState: %s", connStateStr());
+    RDWS_LOG_TRACE("WebServerState: %s", connStateStr());
 }
 
 
 void RdWebServer::start(int port)
 {
-    Log.info("WebServer: Start");
-    _TCPPort = port;
+    RDWS_LOG_INFO("WebServer: Start");
+    _TCPPort              = port;
+    _transportBeginFailed = false;
     setState(WEB_SERVER_WAIT_CONN);
 }
 
 
 void RdWebServer::restart(int port)
 {
-    Log.info("WebServer: Restart");
+    RDWS_LOG_INFO("WebServer: Restart");
     // Check if already started
-    if (_pTCPServer)
+    if (_transportBegun)
     {
         stop();
     }
-    // Create server and begin
-    _TCPPort    = port;
-    _pTCPServer = new TCPServer(_TCPPort);
+    // Begin listening
+    _TCPPort        = port;
+    _transportBegun       = _pTransport->begin(_TCPPort, _maxWebClients);
+    _transportBeginFailed = !_transportBegun;
     setState(WEB_SERVER_WAIT_CONN);
 }
 
 
 void RdWebServer::stop()
 {
-    Log.info("WebServer: Stop");
-    if (_pTCPServer)
+    RDWS_LOG_INFO("WebServer: Stop");
+    if (_transportBegun)
     {
-        _pTCPServer->stop();
-        // Delete previous server
-        delete _pTCPServer;
-        _pTCPServer = NULL;
+        // Stop listening and close connections
+        _pTransport->stop();
+        _transportBegun = false;
+        while (_numActiveClients > 0)
+        {
+            int clientIdx = _pActiveClientIdxs[--_numActiveClients];
+            _pWebClients[clientIdx].resetConnection();
+            _pFreeClientIdxs[_numFreeClients++] = clientIdx;
+        }
     }
     setState(WEB_SERVER_STOPPED);
 }
 
 
-TCPClient RdWebServer::available()
+int RdWebServer::clientConnections()
 {
-    if (_pTCPServer)
+    int connCount = 0;
+    for (int i = 0; i < _numActiveClients; i++)
     {
-        return _pTCPServer->available();
+        if (_pWebClients[_pActiveClientIdxs[i]].clientConnState() == RdWebClient::WEB_CLIENT_ACCEPTED)
+        {
+            connCount++;
+        }
     }
-    return -1;
+    return connCount;
+}
+
+
+//////////////////////////////////////
+// Accept pending connections while there are free clients
+void RdWebServer::acceptConnections()
+{
+    while (_numFreeClients > 0)
+    {
+        int connId = _pTransport->accept();
+        if (connId < 0)
+        {
+            break;
+        }
+        int clientIdx = _pFreeClientIdxs[--_numFreeClients];
+        _pWebClients[clientIdx].connectionAccepted(connId);
+        _pActiveClientIdxs[_numActiveClients++] = clientIdx;
+    }
+}
+
+
+//////////////////////////////////////
+// Time until an active client next needs servicing (limited to the max wait)
+unsigned long RdWebServer::msToNextClientService()
+{
+    unsigned long maxWaitMs = _maxServiceWaitMs;
+    for (int i = 0; (i < _numActiveClients) && (maxWaitMs > 0); i++)
+    {
+        unsigned long clientWaitMs = _pWebClients[_pActiveClientIdxs[i]].msToNextService();
+        if (clientWaitMs < maxWaitMs)
+        {
+            maxWaitMs = clientWaitMs;
+        }
+    }
+    return maxWaitMs;
 }
 
 
@@ -660,28 +1532,42 @@ void RdWebServer::service()
         break;
 
     case WEB_SERVER_WAIT_CONN:
-        if (WiFi.ready())
+        // A failed attempt to begin listening is retried after a delay
+        if (_transportBeginFailed &&
+            !RdWebServerUtils::isTimeout(millis(), _webServerStateEntryMs, MS_BETWEEN_BEGIN_ATTEMPTS))
+        {
+            break;
+        }
+        if (_pTransport->isNetworkReady())
         {
             restart(_TCPPort);
-            if (_pTCPServer)
+            if (_transportBegun)
             {
-                Log.info("WebServer TCPServer Begin");
-                _pTCPServer->begin();
+                RDWS_LOG_INFO("WebServer TCPServer Begin");
                 setState(WEB_SERVER_BEGUN);
             }
         }
         break;
 
     case WEB_SERVER_BEGUN:
-        // Service the clients
-        for (int clientIdx = 0; clientIdx < MAX_WEB_CLIENTS; clientIdx++)
+        // Service the transport (e.g. wait for socket events) - waiting no longer than until
+        // a client next needs servicing
+        _pTransport->service(msToNextClientService());
+        // New connections
+        acceptConnections();
+        // Service the active clients - those which have finished go back on the free list
+        for (int i = 0; i < _numActiveClients;)
         {
-            _webClients[clientIdx].service(this);
-
-            if (_webClients[clientIdx].clientIsActive())
+            int clientIdx = _pActiveClientIdxs[i];
+            _pWebClients[clientIdx].service(this);
+            if (!_pWebClients[clientIdx].clientIsActive())
             {
-                _webServerActiveLastUnixTime = Time.now();
+                _pActiveClientIdxs[i] = _pActiveClientIdxs[--_numActiveClients];
+                _pFreeClientIdxs[_numFreeClients++] = clientIdx;
+                continue;
             }
+            _webServerActiveLastUnixTime = Time.now();
+            i++;
         }
         break;
     }
@@ -690,10 +1576,86 @@ void RdWebServer::service()
 
 //////////////////////////////////////
 // Add resources to the web server
-void RdWebServer::addStaticResources(RdWebServerResourceDescr *pResources, int numResources)
+void RdWebServer::addStaticResources(RdWebServerResourceDescr *pResources, int numResources,
+                                     const RdWebServerResourceIndex *pIndex)
+{
+    _pWebServerResources     = pResources;
+    _numWebServerResources   = numResources;
+    _pWebServerResourceIndex = pIndex;
+}
+
+RdWebServerResourceDescr* RdWebServer::findResource(const char *pResId)
 {
-    _pWebServerResources   = pResources;
-    _numWebServerResources = numResources;
+    if (!_pWebServerResources)
+        return NULL;
+    // Index gives the only candidate
+    if (_pWebServerResourceIndex)
+    {
+        int resIdx = _pWebServerResourceIndex->getCandidate(pResId);
+        if ((resIdx < 0) || (resIdx >= _numWebServerResources))
+            return NULL;
+        RdWebServerResourceDescr *pRes = _pWebServerResources + resIdx;
+        return (strcasecmp(pRes->_pResId, pResId) == 0) ? pRes : NULL;
+    }
+    // No index so search
+    for (int resIdx = 0; resIdx < _numWebServerResources; resIdx++)
+    {
+        RdWebServerResourceDescr *pRes = _pWebServerResources + resIdx;
+        if (strcasecmp(pRes->_pResId, pResId) == 0)
+            return pRes;
+    }
+    return NULL;
+}
+
+
+// Configure persistent connections - maxRequestsPerConn of 0 disables keep-alive
+void RdWebServer::setKeepAlive(unsigned long idleTimeoutMs, int maxRequestsPerConn)
+{
+    _keepAliveIdleMs      = idleTimeoutMs;
+    _keepAliveMaxRequests = maxRequestsPerConn;
+    formRespHeaderSuffixes();
+}
+
+
+// Configure CORS - an empty (or NULL) origin disables CORS headers
+void RdWebServer::setCORSPolicy(const char *pAllowOrigin, const char *pAllowMethods,
+                                const char *pAllowHeaders, unsigned long maxAgeSecs)
+{
+    _corsAllowOrigin  = pAllowOrigin ? pAllowOrigin : "";
+    _corsAllowMethods = pAllowMethods ? pAllowMethods : "";
+    _corsAllowHeaders = pAllowHeaders ? pAllowHeaders : "";
+    _corsMaxAgeSecs   = maxAgeSecs;
+    formRespHeaderSuffixes();
+}
+
+
+// Form the ends of response headers used with precomputed headers and the responses to CORS
+// preflight requests
+void RdWebServer::formRespHeaderSuffixes()
+{
+    _corsOriginHdr = "";
+    if (_corsAllowOrigin.length() > 0)
+    {
+        // Responses vary with the request's origin unless all are allowed
+        _corsOriginHdr = String::format("Access-Control-Allow-Origin: %s\r\n%s", _corsAllowOrigin.c_str(),
+                    _corsAllowOrigin.equals("*") ? "" : "Vary: Origin\r\n");
+    }
+    _respHeaderSuffixKeepAlive = String::format("%sConnection: keep-alive\r\nKeep-Alive: timeout=%lu\r\n\r\n",
+                _corsOriginHdr.c_str(), _keepAliveIdleMs / 1000);
+    _respHeaderSuffixClose = String::format("%sConnection: close\r\n\r\n", _corsOriginHdr.c_str());
+
+    // Preflight responses
+    _preflightRespKeepAlive = "";
+    _preflightRespClose     = "";
+    if (_corsAllowOrigin.length() > 0)
+    {
+        String preflightHdr = String::format("HTTP/1.1 204 No Content\r\n%sAccess-Control-Allow-Methods: %s\r\n"
+                    "Access-Control-Allow-Headers: %s\r\nAccess-Control-Max-Age: %lu\r\nContent-Length: 0\r\n",
+                    _corsOriginHdr.c_str(), _corsAllowMethods.c_str(), _corsAllowHeaders.c_str(), _corsMaxAgeSecs);
+        _preflightRespKeepAlive = preflightHdr + String::format("Connection: keep-alive\r\nKeep-Alive: timeout=%lu\r\n\r\n",
+                    _keepAliveIdleMs / 1000);
+        _preflightRespClose = preflightHdr + "Connection: close\r\n\r\n";
+    }
 }
 
 
@@ -702,3 +1664,79 @@ void RdWebServer::addRestAPIEndpoints(RestAPIEndpoints *pRestAPIEndpoints)
 {
     _pRestAPIEndpoints = pRestAPIEndpoints;
 }
+
+
+// Add the metrics endpoint - its output is streamed a line at a time
+bool RdWebServer::enableMetricsEndpoint(const char *pEndpointStr)
+{
+    if (!_pRestAPIEndpoints)
+    {
+        RDWS_LOG_INFO("WebServer: metrics endpoint needs REST API endpoints");
+        return false;
+    }
+    _pRestAPIEndpoints->addStreamingEndpoint(pEndpointStr,
+                [this](RestAPIEndpointMsg& apiMsg, RestAPIStreamSink& sink)
+                {
+                    char line[MAX_METRICS_LINE_LEN];
+                    while (true)
+                    {
+                        int lineLen = formMetricsLine(apiMsg._streamPos, line, sizeof(line));
+                        if (lineLen < 0)
+                        {
+                            return false;
+                        }
+                        if (!sink.write((const uint8_t *)line, lineLen))
+                        {
+                            return true;
+                        }
+                        apiMsg._streamPos++;
+                    }
+                },
+                "text/plain; version=0.0.4", RestAPIEndpointDef::METHOD_MASK_GET);
+    return true;
+}
+
+
+// Form a line of the metrics output - statistics (three lines each) then the histograms
+int RdWebServer::formMetricsLine(unsigned long lineIdx, char *pBuf, int bufLen)
+{
+    struct MetricsValue
+    {
+        const char    *_pName;
+        const char    *_pType;
+        const char    *_pHelp;
+        unsigned long _value;
+    };
+    const MetricsValue values[] =
+    {
+        { "rdws_requests_total", "counter", "Requests received", _stats._requests },
+        { "rdws_rx_heap_allocs_total", "counter", "Heap allocations while receiving and routing requests", _stats._rxHeapAllocs },
+        { "rdws_rx_overflows_total", "counter", "Requests with a header too long for the receive buffer", _stats._rxOverflows },
+        { "rdws_rx_bad_requests_total", "counter", "Requests which couldn't be parsed", _stats._rxBadRequests },
+        { "rdws_rx_too_large_total", "counter", "Requests rejected as the body was too large", _stats._rxTooLarge },
+        { "rdws_rx_not_implemented_total", "counter", "Requests rejected as the body used a transfer coding", _stats._rxNotImplemented },
+        { "rdws_rx_body_streamed_bytes_total", "counter", "Request body bytes passed to upload endpoints", _stats._rxBodyStreamed },
+        { "rdws_cors_preflights_total", "counter", "CORS preflight requests answered", _stats._corsPreflights },
+        { "rdws_active_clients", "gauge", "Connections open", (unsigned long)_numActiveClients },
+    };
+    const unsigned long numValueLines = 3 * (sizeof(values) / sizeof(values[0]));
+    if (lineIdx >= numValueLines)
+    {
+        return _metrics.formPrometheusLine(lineIdx - numValueLines, pBuf, bufLen);
+    }
+    const MetricsValue& value = values[lineIdx / 3];
+    int lineLen = 0;
+    switch (lineIdx % 3)
+    {
+    case 0:
+        lineLen = snprintf(pBuf, bufLen, "# HELP %s %s\n", value._pName, value._pHelp);
+        break;
+    case 1:
+        lineLen = snprintf(pBuf, bufLen, "# TYPE %s %s\n", value._pName, value._pType);
+        break;
+    default:
+        lineLen = snprintf(pBuf, bufLen, "%s %lu\n", value._pName, value._value);
+        break;
+    }
+    return (lineLen < bufLen) ? lineLen : bufLen - 1;
+}
@@ -3,27 +3,79 @@
 
 #pragma once
 
+#include "RdWebServerPlatform.h"
+#include "RdWebServerTransport.h"
+#include "RdHttpRequestParser.h"
 #include "RdWebServerResources.h"
+#include "RdWebServerMetrics.h"
 #include "RestAPIEndpoints.h"
 
 class RdWebServer;
 
+// Web server statistics
+struct RdWebServerStats
+{
+    // Requests received
+    unsigned long _requests;
+    // Heap allocations made while receiving, parsing and routing requests
+    unsigned long _rxHeapAllocs;
+    // Requests rejected because the header didn't fit in the receive buffer
+    unsigned long _rxOverflows;
+    // Requests rejected because they couldn't be parsed
+    unsigned long _rxBadRequests;
+    // Requests rejected because the body didn't fit in the receive buffer (and the endpoint
+    // doesn't accept uploads)
+    unsigned long _rxTooLarge;
+    // Requests rejected because the body used a transfer coding (e.g. chunked)
+    unsigned long _rxNotImplemented;
+    // Request body bytes passed to upload endpoints
+    unsigned long _rxBodyStreamed;
+    // CORS preflight requests answered with the preformatted response
+    unsigned long _corsPreflights;
+    RdWebServerStats()
+    {
+        _requests         = 0;
+        _rxHeapAllocs     = 0;
+        _rxOverflows      = 0;
+        _rxBadRequests    = 0;
+        _rxTooLarge       = 0;
+        _rxNotImplemented = 0;
+        _rxBodyStreamed   = 0;
+        _corsPreflights   = 0;
+    }
+};
+
 class RdWebClient
 {
 private:
     // Max length of an http request
     static const int HTTPD_MAX_REQ_LENGTH = 2048;
 
-    // Max payload of a message
+    // Max payload of a message - larger bodies are only accepted by upload endpoints which
+    // are passed the body a buffer at a time
     static const int HTTP_MAX_PAYLOAD_LENGTH = 2048;
 
+    // Streaming responses - max data in each chunk and space for the chunk size line (up to
+    // 4 hex digits)
+    static const int STREAM_CHUNK_MAX_DATA = 1024;
+    static const int STREAM_CHUNK_HDR_LEN = 6;
+
+public:
+    // Size of receive buffer - header and payload each with a terminator
+    static const int RX_BUFFER_SIZE = HTTPD_MAX_REQ_LENGTH + 1 + HTTP_MAX_PAYLOAD_LENGTH + 1;
+
+    // Size of buffer for streaming response chunks - chunk size line, data, chunk terminator
+    // and the last-chunk which ends the response
+    static const int TX_CHUNK_BUFFER_SIZE = STREAM_CHUNK_HDR_LEN + STREAM_CHUNK_MAX_DATA + 2 + 5;
+
+private:
     // Each call to service() process max this number of chars received from a TCP connection
     static const int MAX_CHS_IN_SERVICE_LOOP = 500;
 
     // Timeouts
     static const unsigned long MAX_MS_IN_CLIENT_STATE_WITHOUT_DATA = 2000;
 
-    // Time between TCP frames
+    // Time between TCP frames - only used if the transport can't report send buffer space
     // On Photon 20ms works almost all the time, 10ms fails
     static const unsigned long MS_WAIT_BETWEEN_TCP_FRAMES = 25;
     static const unsigned long MS_WAIT_AFTER_LAST_TCP_FRAME = 200;
@@ -32,25 +84,53 @@ private:
     // On Photon 2000 works ok, 5000 fails
     static const int HTTPD_MAX_RESP_CHUNK_SIZE = 4000;
 
-    // TCP client
-    TCPClient _TCPClient;
+    // Content length values for responses with a body of unknown length - sent with chunked
+    // transfer-encoding or (for HTTP/1.0 clients) ended by closing the connection
+    static const int CONTENT_LENGTH_CHUNKED = -2;
+    static const int CONTENT_LENGTH_UNKNOWN = -3;
 
-    // Methods
-    static const int METHOD_OTHER   = 0;
-    static const int METHOD_GET     = 1;
-    static const int METHOD_POST    = 2;
-    static const int METHOD_OPTIONS = 3;
+    // TCP connection (-1 if none)
+    int _connId;
+
+    // Transport used for the connection
+    RdWebServerTransport *_pTransport;
+
+    // Metrics which request and connection timings are recorded in
+    RdWebServerMetrics *_pMetrics;
 
 public:
     RdWebClient();
     ~RdWebClient();
 
-    void setClientIdx(int clientIdx)
+    void setClientIdx(int clientIdx, RdWebServerTransport *pTransport, RdWebServerMetrics *pMetrics)
+    {
+        _clientIdx  = clientIdx;
+        _pTransport = pTransport;
+        _pMetrics   = pMetrics;
+    }
+    // Receive buffer (RX_BUFFER_SIZE bytes) - allocated by the web server
+    void setRxBuffer(uint8_t *pRxBuf)
+    {
+        _pRxBuf    = pRxBuf;
+        _pRxBuf[0] = 0;
+    }
+    // Buffer for streaming response chunks (TX_CHUNK_BUFFER_SIZE bytes) - allocated by the web server
+    void setTxChunkBuffer(uint8_t *pTxChunkBuf)
     {
-        _clientIdx = clientIdx;
+        _pTxChunkBuf = pTxChunkBuf;
     }
     void service(RdWebServer *pWebServer);
 
+    // Time until the client next needs servicing if no network events happen (e.g. a timeout)
+    // - 0 if it has work to do now
+    unsigned long msToNextService();
+
+    // Start handling a newly accepted connection
+    void connectionAccepted(int connId);
+
+    // Drop the connection without closing it (e.g. when the transport has been stopped)
+    void resetConnection();
+
     bool clientIsActive()
     {
         return _webClientState != WEB_CLIENT_NONE;
@@ -75,10 +155,20 @@ private:
     WebClientState _webClientState;
     unsigned long  _webClientStateEntryMs;
 
-    // HTTP Request
-    String _httpReqStr;
+    // Receive buffer - the request header is received into the start of the buffer and
+    // the payload follows it
+    uint8_t *_pRxBuf;
+    int     _rxLen;
+
+    // Parser for the request header - positions are offsets into the receive buffer
+    RdHttpRequestParser _httpParser;
 
-    // HTTP Request payload and header complete
+    // End of the current request in the receive buffer - anything after it is the start of
+    // the next (pipelined) request - and the byte overwritten by the payload terminator
+    int     _rxReqLen;
+    uint8_t _rxReqEndByte;
+
+    // HTTP Request payload (in receive buffer) and header complete
     unsigned char* _pHttpReqPayload;
     int _httpReqPayloadLen;
     bool _httpHeaderComplete;
@@ -86,14 +176,84 @@ private:
     // HTTP payload while being received
     int _curHttpPayloadRxPos;
 
-    // HTTP response
-    String _httpRespStr;
+    // Body too large for the receive buffer (and not for an upload endpoint)
+    bool _rxPayloadTooLarge;
+
+    // Body sent with a transfer coding - its length isn't known so it can't be received and
+    // the connection is closed after the response
+    bool _rxBodyNotImplemented;
+
+    // Body passed to an upload endpoint - it is received into the payload area of the receive
+    // buffer which is only refilled when the endpoint has consumed what was there
+    bool _bodyStreamed;
+    int  _bodyBufPos;
+    int  _bodyBufLen;
+
+    // Request routing - done when the header is complete so the endpoint is known before the
+    // body is received - the endpoint is NULL if the request isn't for one and allowMask is set
+    // if the path is for an endpoint which doesn't accept the method
+    bool               _reqRouted;
+    bool               _reqIsPreflight;
+    RestAPIEndpointDef *_pReqEndpoint;
+    int                _reqAllowMask;
+    String             _reqEndpointStr;
+    String             _reqArgStr;
+
+    // HTTP response formed for this request (when not precomputed) - the start of the header
+    // is formatted into the header buffer and sent with the server's preformatted header suffix
+    // and the body (e.g. the response from a REST API endpoint) without copying them together
+    static const int TX_HDR_BUF_SIZE = 256;
+    char   _txHdrBuf[TX_HDR_BUF_SIZE];
+    String _httpRespBodyStr;
+
+    // Response segments - sent in order from const memory (e.g. a precomputed resource header,
+    // the server's header suffix and the resource data) - and position in them while sending
+    static const int MAX_TX_SEGMENTS = 4;
+    RdWebTxSegment _txSegments[MAX_TX_SEGMENTS];
+    int       _numTxSegments;
+    int       _txSegmentIdx;
+    int       _txSegmentPos;
 
     // Resource to send
     RdWebServerResourceDescr* _pResourceToSend;
-    int _resourceSendIdx;
     int _resourceSendBlkCount;
     unsigned long _resourceSendMillis;
+    // Transport's send buffer was full on the last write
+    bool _resourceSendBlocked;
+
+    // Parameters captured from the path by a pattern endpoint - decoded in place in the
+    // receive buffer so valid until the response is complete
+    RestAPIParam  _routeParams[RestAPIEndpointMsg::MAX_PATH_PARAMS];
+    int           _numRouteParams;
+
+    // Streaming response - the endpoint's callback is called each time the previous chunk
+    // has been sent
+    RestAPIEndpointDef *_pStreamEndpoint;
+    unsigned long _streamPos;
+    bool          _streamChunked;
+    bool          _streamComplete;
+    uint8_t       *_pTxChunkBuf;
+    int           _txChunkSendIdx;
+    int           _txChunkLen;
+
+    // Persistent connection - number of requests handled on this connection and whether to
+    // keep it open after the current response
+    bool          _keepAlive;
+    int           _requestsOnConn;
+    unsigned long _keepAliveIdleMs;
+    int           _keepAliveMaxRequests;
+
+    // Timings of the current request and connection (from micros()) - the resource requested
+    // and whether any of the response has been written are kept for the metrics
+    RdWebRequestTimes        _reqTimes;
+    unsigned long            _connAcceptUs;
+    unsigned long            _connFirstByteUs;
+    bool                     _respStarted;
+    RdWebServerResourceDescr *_pReqResource;
+
+    // Server's preformatted header suffixes (CORS and connection headers) for responses
+    const String  *_pRespHdrSuffixKeepAlive;
+    const String  *_pRespHdrSuffixClose;
 
     // Index of client - for debug
     int _clientIdx;
@@ -102,31 +262,75 @@ private:
     // Handle reading of data from TCP
     void handleTCPReadData(int numToRead);
 
+    // Parse the header received so far - returns false if the request is invalid
+    bool parseRxHeader();
+
+    // Find the endpoint for the request once the header is complete
+    void routeRequest(RdWebServer *pWebServer);
+
+    // Set up reception of the body (once the request has been routed)
+    void startRequestBody();
+
+    // Pass body received for an upload endpoint to its body callback
+    void deliverRequestBody(RdWebServer *pWebServer);
+
     // Cleanup resources used for TCP Rx
     void cleanupTCPRxResources();
 
-    // cleanUp
-    void cleanUp();
+    // Respond to a request which can't be handled and close the connection
+    void startErrorResponse(const char *pStatus);
 
-    // Helpers
-    static int getContentLengthFromHeader(const char *msgBuf);
+    // Close the connection and record its timings
+    void closeConnection();
 
-    // Extract endpoint arguments
-    static bool extractEndpointArgs(const char *buf, String& endpointStr, String& argStr);
+    // Note that the response has started to be written
+    void respBytesWritten();
 
-    // Utility
-    static void formStringFromCharBuf(String& outStr, char *pStr, int len);
+    // Move any pipelined data to the start of the receive buffer ready for the next request
+    void startNextRequest();
+
+    // Start sending the response
+    void startResponse();
+
+    // Response sending
+    void addTxSegment(const uint8_t *pData, int len);
+    bool getNextTxBlocks(RdWebTxSegment *pBlocks, int& numBlocks, int& dataLen);
+    void advanceTx(int numBytes);
+    void responseComplete();
+    void serviceSendWithBackpressure();
+    void serviceSendPaced();
+    void fillStreamChunk();
+
+    // Check if the client wants the connection kept open
+    bool isKeepAliveRequested();
+
+    // Extract endpoint arguments from the request target
+    static bool extractEndpointArgs(const char *pTarget, int targetLen, String& endpointStr, String& argStr);
 
-    // Form HTTP response
-    static void formHTTPResponse(String& respStr, const char *rsltCode,
-                          const char *contentType, const char *respBody, int contentLen);
+    // Form HTTP response - extra headers (each ending CRLF) may be added - the body isn't
+    // included in the response to a HEAD request and must remain valid until it is sent
+    void formHTTPResponse(const char *rsltCode,
+                          const char *contentType, const char *respBody, int contentLen,
+                          const char *pExtraHdrs = "");
+
+    // Form 405 response with an Allow header listing the allowed methods
+    void formMethodNotAllowedResponse(int allowMask);
 
 };
 
 class RdWebServer
 {
 public:
-    RdWebServer();
+    // Default number of clients (simultaneous connections) - the Photon's TCP stack only
+    // supports a few sockets
+#ifdef RDWEBSERVER_POSIX
+    static const int DEFAULT_MAX_WEB_CLIENTS = 64;
+#else
+    static const int DEFAULT_MAX_WEB_CLIENTS = 3;
+#endif
+
+    // If no transport is specified the default for the platform is used
+    RdWebServer(int maxWebClients = DEFAULT_MAX_WEB_CLIENTS, RdWebServerTransport *pTransport = NULL);
     virtual ~RdWebServer();
 
     void start(int port);
@@ -141,24 +345,91 @@ public:
     }
 
 
-    int clientConnections()
+    // Number of connections waiting for (or receiving) a request
+    int clientConnections();
+
+    // Statistics
+    RdWebServerStats& getStats()
+    {
+        return _stats;
+    }
+
+    // Request timing metrics
+    RdWebServerMetrics& getMetrics()
     {
-        int connCount = 0;
-        for (int clientIdx = 0; clientIdx < MAX_WEB_CLIENTS; clientIdx++)
-        {
-            if (_webClients[clientIdx].clientConnState() == RdWebClient::WebClientState::WEB_CLIENT_ACCEPTED)
-            {
-                connCount++;
-            }
-        }
-        return connCount;
+        return _metrics;
+    }
+
+    // Add an endpoint (to the endpoints added with addRestAPIEndpoints) which responds with
+    // the statistics and timing histograms in Prometheus text format
+    bool enableMetricsEndpoint(const char *pEndpointStr = "metrics");
+
+    // Form a line of the metrics output (counters then histograms) - returns the length or -1
+    // when there are no more lines
+    int formMetricsLine(unsigned long lineIdx, char *pBuf, int bufLen);
+
+    // Size of client pool and number of clients currently in use
+    int maxWebClients()
+    {
+        return _maxWebClients;
+    }
+    int activeWebClients()
+    {
+        return _numActiveClients;
     }
 
     // Add endpoints to the web server
     void addRestAPIEndpoints(RestAPIEndpoints *pRestAPIEndpoints);
 
-    // Add resources to the web server
-    void addStaticResources(RdWebServerResourceDescr *pResources, int numResources);
+    // Persistent connections - idle timeout and max requests on a connection before it is
+    // closed (0 disables keep-alive)
+    void setKeepAlive(unsigned long idleTimeoutMs, int maxRequestsPerConn);
+    unsigned long getKeepAliveIdleMs()
+    {
+        return _keepAliveIdleMs;
+    }
+    int getKeepAliveMaxRequests()
+    {
+        return _keepAliveMaxRequests;
+    }
+
+    // Max time service() waits for network events when no client has work to do - the
+    // application's loop doesn't run while waiting (only transports which can wait for
+    // events, e.g. POSIX, block)
+    void setMaxServiceWaitMs(unsigned long maxWaitMs)
+    {
+        _maxServiceWaitMs = maxWaitMs;
+    }
+
+    // End of the response header used with precomputed headers (CORS and connection headers and
+    // the blank line) - formed once so static resources are sent without formatting
+    const String& getRespHeaderSuffix(bool keepAlive)
+    {
+        return keepAlive ? _respHeaderSuffixKeepAlive : _respHeaderSuffixClose;
+    }
+
+    // CORS policy - the origin allowed (e.g. * or http://mysite.com - NULL or empty disables
+    // CORS headers), the methods and request headers allowed and how long browsers may cache
+    // the result of a preflight request (which is answered without calling any endpoint)
+    void setCORSPolicy(const char *pAllowOrigin, const char *pAllowMethods = "GET, HEAD, POST, PUT, PATCH, DELETE",
+                       const char *pAllowHeaders = "Content-Type", unsigned long maxAgeSecs = DEFAULT_CORS_MAX_AGE_SECS);
+    const String& getCORSOriginHdr()
+    {
+        return _corsOriginHdr;
+    }
+    // Response to a CORS preflight request (empty if CORS is disabled)
+    const String& getPreflightResponse(bool keepAlive)
+    {
+        return keepAlive ? _preflightRespKeepAlive : _preflightRespClose;
+    }
+
+    // Add resources to the web server - with an index (generated by GenResources.py) finding a
+    // resource doesn't depend on the number of resources
+    void addStaticResources(RdWebServerResourceDescr *pResources, int numResources,
+                            const RdWebServerResourceIndex *pIndex = NULL);
+
+    // Find a resource by name (case insensitive) - NULL if not found
+    RdWebServerResourceDescr* findResource(const char *pResId);
 
     // resources
     int getNumResources()
@@ -182,24 +453,67 @@ public:
             return NULL;
         return _pRestAPIEndpoints->getEndpoint(endpointStr);
     }
-
-public:
-    // Get an available client
-    TCPClient available();
+    RestAPIEndpointDef* getEndpoint(const char* endpointStr, int method, int& allowMask)
+    {
+        allowMask = 0;
+        if (!_pRestAPIEndpoints)
+            return NULL;
+        return _pRestAPIEndpoints->getEndpoint(endpointStr, method, allowMask);
+    }
+    RestAPIEndpointDef* matchRoute(const char *pPath, int pathLen, int method, RestAPIParam *pParams, int& numParams,
+                                   int& allowMask)
+    {
+        numParams = 0;
+        allowMask = 0;
+        if (!_pRestAPIEndpoints)
+            return NULL;
+        return _pRestAPIEndpoints->matchRoute(pPath, pathLen, method, pParams, numParams, allowMask);
+    }
 
 private:
-    // Clients
-    static const int MAX_WEB_CLIENTS = 3;
+    // Persistent connection defaults
+    static const unsigned long DEFAULT_KEEP_ALIVE_IDLE_MS = 2000;
+    static const int DEFAULT_KEEP_ALIVE_MAX_REQUESTS = 100;
+
+    // Time browsers may cache the result of a CORS preflight request
+    static const unsigned long DEFAULT_CORS_MAX_AGE_SECS = 86400;
+
+    // Default max time service() waits for network events
+    static const unsigned long DEFAULT_MAX_SERVICE_WAIT_MS = 10;
+
+    // Time between attempts to begin listening when an attempt fails (e.g. port in use)
+    static const unsigned long MS_BETWEEN_BEGIN_ATTEMPTS = 1000;
 
 private:
     // Port
     int _TCPPort;
 
-    // TCP server
-    TCPServer *_pTCPServer;
-
-    // Client
-    RdWebClient _webClients[MAX_WEB_CLIENTS];
+    // Transport (TCP stack)
+    RdWebServerTransport *_pTransport;
+    bool                 _ownTransport;
+    bool                 _transportBegun;
+    // Last attempt to begin listening failed - retried after a delay
+    bool                 _transportBeginFailed;
+
+    // Client pool - contiguous array of clients with a free-list and a list of those
+    // which are active (so only active clients are serviced)
+    RdWebClient *_pWebClients;
+    int         _maxWebClients;
+    int         *_pFreeClientIdxs;
+    int         _numFreeClients;
+    int         *_pActiveClientIdxs;
+    int         _numActiveClients;
+
+    // Receive and streaming response buffers for all clients - allocated once
+    uint8_t     *_pRxBufferPool;
+    uint8_t     *_pTxChunkBufferPool;
+
+    // Statistics and metrics
+    RdWebServerStats   _stats;
+    RdWebServerMetrics _metrics;
+
+    // Max length of a line of the metrics output
+    static const int MAX_METRICS_LINE_LEN = 200;
 
     // Possible states of web server
 public:
@@ -219,16 +533,45 @@ private:
     // Web server resources
     RdWebServerResourceDescr *_pWebServerResources;
     int _numWebServerResources;
+    const RdWebServerResourceIndex *_pWebServerResourceIndex;
 
     // Utility
     void setState(WebServerState newState);
 
+    // Time until an active client next needs servicing
+    unsigned long msToNextClientService();
+
     // Last time web server was active
     unsigned long _webServerActiveLastUnixTime;
 
+    // Persistent connection settings
+    unsigned long _keepAliveIdleMs;
+    int           _keepAliveMaxRequests;
+
+    // Max time service() waits for network events
+    unsigned long _maxServiceWaitMs;
+
+    // CORS policy
+    String        _corsAllowOrigin;
+    String        _corsAllowMethods;
+    String        _corsAllowHeaders;
+    unsigned long _corsMaxAgeSecs;
+
+    // Preformatted headers - response header suffixes, the CORS header and the responses to
+    // preflight requests
+    String _respHeaderSuffixKeepAlive;
+    String _respHeaderSuffixClose;
+    String _corsOriginHdr;
+    String _preflightRespKeepAlive;
+    String _preflightRespClose;
+    void formRespHeaderSuffixes();
+
     // Restart
     void restart(int port);
 
+    // Accept new connections
+    void acceptConnections();
+
 public:
     // Check if web server was active in last n seconds
     bool wasActiveInLastNSeconds(unsigned int nSeconds)
@@ -0,0 +1,213 @@
+// Web server metrics
+// Rob Dobson 2012-2017
+
+#include "RdWebServerMetrics.h"
+
+// Bucket bounds from 100us to 1s
+const unsigned long RdWebLatencyHistogram::BOUNDS_US[NUM_BOUNDS] =
+{
+    100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000, 250000, 1000000
+};
+const char *RdWebLatencyHistogram::BOUNDS_STR[NUM_BOUNDS] =
+{
+    "0.0001", "0.00025", "0.0005", "0.001", "0.0025", "0.005", "0.01", "0.025", "0.05", "0.1", "0.25", "1"
+};
+
+void RdWebLatencyHistogram::clear()
+{
+    for (int i = 0; i <= NUM_BOUNDS; i++)
+    {
+        _bucketCounts[i] = 0;
+    }
+    _count = 0;
+    _sumUs = 0;
+}
+
+void RdWebLatencyHistogram::add(unsigned long durationUs)
+{
+    int bucketIdx = 0;
+    while ((bucketIdx < NUM_BOUNDS) && (durationUs > BOUNDS_US[bucketIdx]))
+    {
+        bucketIdx++;
+    }
+    _bucketCounts[bucketIdx]++;
+    _count++;
+    _sumUs += durationUs;
+}
+
+unsigned long RdWebLatencyHistogram::getCumulativeCount(int boundIdx) const
+{
+    unsigned long count = 0;
+    for (int i = 0; (i <= boundIdx) && (i <= NUM_BOUNDS); i++)
+    {
+        count += _bucketCounts[i];
+    }
+    return count;
+}
+
+////////////////////////////////////////////
+RdWebServerMetrics::RdWebServerMetrics()
+{
+    // The first series is for requests which aren't for an endpoint or resource
+    _series[0]._pTarget = NULL;
+    _series[0]._pName   = "";
+    _series[0]._kind    = SERIES_OTHER;
+    _numSeries = 1;
+}
+
+////////////////////////////////////////////
+// Record the phases of a request and its total time against its endpoint or resource -
+// times are from micros() so differences are correct when it wraps
+void RdWebServerMetrics::recordRequest(const RdWebRequestTimes& times, SeriesKind kind, const void *pTarget,
+                                       const char *pName)
+{
+    _phaseHists[PHASE_HEADER].add(times._headerCompleteUs - times._firstByteUs);
+    _phaseHists[PHASE_BODY].add(times._bodyCompleteUs - times._headerCompleteUs);
+    _phaseHists[PHASE_HANDLER].add(times._handlerEndUs - times._handlerStartUs);
+    _phaseHists[PHASE_RESP_START].add(times._firstRespByteUs - times._handlerEndUs);
+    _phaseHists[PHASE_SEND].add(times._respCompleteUs - times._firstRespByteUs);
+    unsigned long totalUs = times._respCompleteUs - times._firstByteUs;
+    _phaseHists[PHASE_TOTAL].add(totalUs);
+    _series[findSeries(kind, pTarget, pName)]._hist.add(totalUs);
+}
+
+////////////////////////////////////////////
+void RdWebServerMetrics::recordConnection(unsigned long acceptUs, unsigned long firstByteUs, unsigned long closeUs)
+{
+    if (firstByteUs != 0)
+    {
+        _phaseHists[PHASE_CONN_WAIT].add(firstByteUs - acceptUs);
+    }
+    _phaseHists[PHASE_CONN_LIFE].add(closeUs - acceptUs);
+}
+
+////////////////////////////////////////////
+// Find the series for a target - added if there is space - the "other" series otherwise
+int RdWebServerMetrics::findSeries(SeriesKind kind, const void *pTarget, const char *pName)
+{
+    if ((kind == SERIES_OTHER) || (pTarget == NULL))
+    {
+        return 0;
+    }
+    for (int i = 1; i < _numSeries; i++)
+    {
+        if (_series[i]._pTarget == pTarget)
+        {
+            return i;
+        }
+    }
+    if (_numSeries >= MAX_SERIES)
+    {
+        return 0;
+    }
+    Series& series  = _series[_numSeries];
+    series._pTarget = pTarget;
+    series._pName   = pName;
+    series._kind    = kind;
+    series._hist.clear();
+    return _numSeries++;
+}
+
+////////////////////////////////////////////
+const char *RdWebServerMetrics::getPhaseName(int phase)
+{
+    static const char *phaseNames[NUM_PHASES] =
+    {
+        "header", "body", "handler", "resp_start", "send", "total", "conn_wait", "conn_life"
+    };
+    return ((phase >= 0) && (phase < NUM_PHASES)) ? phaseNames[phase] : "";
+}
+
+const char *RdWebServerMetrics::getKindName(SeriesKind kind)
+{
+    switch (kind)
+    {
+    case SERIES_ENDPOINT:
+        return "endpoint";
+    case SERIES_RESOURCE:
+        return "resource";
+    default:
+        return "other";
+    }
+}
+
+////////////////////////////////////////////
+// Form a line of a histogram - the buckets then the sum and count
+int RdWebServerMetrics::formHistogramLine(char *pBuf, int bufLen, const char *pMetricName, const char *pLabels,
+                                          const RdWebLatencyHistogram& hist, int lineInHist)
+{
+    int lineLen = 0;
+    if (lineInHist <= RdWebLatencyHistogram::NUM_BOUNDS)
+    {
+        const char *pBound = (lineInHist < RdWebLatencyHistogram::NUM_BOUNDS) ?
+                             RdWebLatencyHistogram::BOUNDS_STR[lineInHist] : "+Inf";
+        lineLen = snprintf(pBuf, bufLen, "%s_bucket{%s,le=\"%s\"} %lu\n", pMetricName, pLabels, pBound,
+                           hist.getCumulativeCount(lineInHist));
+    }
+    else if (lineInHist == RdWebLatencyHistogram::NUM_BOUNDS + 1)
+    {
+        uint64_t sumUs = hist.getSumUs();
+        lineLen = snprintf(pBuf, bufLen, "%s_sum{%s} %lu.%06lu\n", pMetricName, pLabels,
+                           (unsigned long)(sumUs / 1000000), (unsigned long)(sumUs % 1000000));
+    }
+    else
+    {
+        lineLen = snprintf(pBuf, bufLen, "%s_count{%s} %lu\n", pMetricName, pLabels, hist.getCount());
+    }
+    return (lineLen < bufLen) ? lineLen : bufLen - 1;
+}
+
+////////////////////////////////////////////
+// Lines are the request duration histogram for each series then the phase histograms - each
+// preceded by HELP and TYPE lines
+int RdWebServerMetrics::formPrometheusLine(unsigned long lineIdx, char *pBuf, int bufLen)
+{
+    static const char *pReqMetric   = "rdws_request_duration_seconds";
+    static const char *pPhaseMetric = "rdws_phase_duration_seconds";
+    char labels[MAX_LABEL_VALUE_LEN + 40];
+    int  lineLen = -1;
+
+    // Request durations by endpoint or resource
+    unsigned long numReqLines = 2 + _numSeries * LINES_PER_HISTOGRAM;
+    if (lineIdx == 0)
+    {
+        lineLen = snprintf(pBuf, bufLen, "# HELP %s Time from the first byte of a request to its response being sent\n",
+                           pReqMetric);
+    }
+    else if (lineIdx == 1)
+    {
+        lineLen = snprintf(pBuf, bufLen, "# TYPE %s histogram\n", pReqMetric);
+    }
+    else if (lineIdx < numReqLines)
+    {
+        const Series& series = _series[(lineIdx - 2) / LINES_PER_HISTOGRAM];
+        snprintf(labels, sizeof(labels), "kind=\"%s\",target=\"%.*s\"", getKindName(series._kind),
+                 MAX_LABEL_VALUE_LEN, series._pName);
+        return formHistogramLine(pBuf, bufLen, pReqMetric, labels, series._hist, (lineIdx - 2) % LINES_PER_HISTOGRAM);
+    }
+    else
+    {
+        // Phases of requests and connections
+        lineIdx -= numReqLines;
+        if (lineIdx == 0)
+        {
+            lineLen = snprintf(pBuf, bufLen, "# HELP %s Time spent in each phase of handling requests and connections\n",
+                               pPhaseMetric);
+        }
+        else if (lineIdx == 1)
+        {
+            lineLen = snprintf(pBuf, bufLen, "# TYPE %s histogram\n", pPhaseMetric);
+        }
+        else if (lineIdx < 2 + NUM_PHASES * LINES_PER_HISTOGRAM)
+        {
+            int phase = (lineIdx - 2) / LINES_PER_HISTOGRAM;
+            snprintf(labels, sizeof(labels), "phase=\"%s\"", getPhaseName(phase));
+            return formHistogramLine(pBuf, bufLen, pPhaseMetric, labels, _phaseHists[phase], (lineIdx - 2) % LINES_PER_HISTOGRAM);
+        }
+    }
+    if (lineLen >= bufLen)
+    {
+        lineLen = bufLen - 1;
+    }
+    return lineLen;
+}
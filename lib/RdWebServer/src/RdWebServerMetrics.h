@@ -0,0 +1,125 @@
+// Web server metrics
+// Rob Dobson 2012-2017
+
+// Request timings aggregated into fixed size latency histograms - one for each endpoint and
+// resource requested and one for each phase of handling a request - which can be read in
+// Prometheus text format a line at a time (so the output doesn't need to be held in memory)
+
+#pragma once
+
+#include "RdWebServerPlatform.h"
+
+// Times (from micros()) at which the phases of a request were reached
+struct RdWebRequestTimes
+{
+    unsigned long _firstByteUs;
+    unsigned long _headerCompleteUs;
+    unsigned long _bodyCompleteUs;
+    unsigned long _handlerStartUs;
+    unsigned long _handlerEndUs;
+    unsigned long _firstRespByteUs;
+    unsigned long _respCompleteUs;
+};
+
+// Histogram of durations with fixed buckets
+class RdWebLatencyHistogram
+{
+public:
+    // Bucket upper bounds - durations longer than the last go in an extra bucket
+    static const int NUM_BOUNDS = 12;
+    static const unsigned long BOUNDS_US[NUM_BOUNDS];
+    static const char *BOUNDS_STR[NUM_BOUNDS];
+
+    RdWebLatencyHistogram()
+    {
+        clear();
+    }
+    void clear();
+    void add(unsigned long durationUs);
+
+    // Number of durations <= the bound (all of them for NUM_BOUNDS) as Prometheus expects
+    unsigned long getCumulativeCount(int boundIdx) const;
+    unsigned long getCount() const
+    {
+        return _count;
+    }
+    uint64_t getSumUs() const
+    {
+        return _sumUs;
+    }
+
+private:
+    unsigned long _bucketCounts[NUM_BOUNDS + 1];
+    unsigned long _count;
+    uint64_t      _sumUs;
+};
+
+class RdWebServerMetrics
+{
+public:
+    // Max number of endpoints and resources with their own histogram - others (and requests
+    // which aren't for an endpoint or resource) are counted as "other"
+#ifdef RDWEBSERVER_POSIX
+    static const int MAX_SERIES = 64;
+#else
+    static const int MAX_SERIES = 16;
+#endif
+
+    // Phases - each measured from the end of the previous one - and the connection timings
+    enum Phase
+    {
+        PHASE_HEADER,       // first byte of request to header complete
+        PHASE_BODY,         // header complete to body complete
+        PHASE_HANDLER,      // handling the request (e.g. the endpoint's callback)
+        PHASE_RESP_START,   // handler end to first byte of response written
+        PHASE_SEND,         // first byte of response written to all written
+        PHASE_TOTAL,        // first byte of request to all of response written
+        PHASE_CONN_WAIT,    // connection accepted to first byte of its first request
+        PHASE_CONN_LIFE,    // connection accepted to closed
+        NUM_PHASES
+    };
+
+    // Kinds of series
+    enum SeriesKind
+    {
+        SERIES_OTHER, SERIES_ENDPOINT, SERIES_RESOURCE
+    };
+
+    RdWebServerMetrics();
+
+    // Record a completed request - pTarget (an endpoint or resource definition) identifies
+    // the series and pName is its name (both must remain valid)
+    void recordRequest(const RdWebRequestTimes& times, SeriesKind kind, const void *pTarget, const char *pName);
+
+    // Record connection timings - firstByteUs is 0 if no request was received
+    void recordConnection(unsigned long acceptUs, unsigned long firstByteUs, unsigned long closeUs);
+
+    // Form a line (ending with a newline) of the Prometheus text format output - returns the
+    // length or -1 when there are no more lines
+    int formPrometheusLine(unsigned long lineIdx, char *pBuf, int bufLen);
+
+private:
+    // Lines for each histogram - buckets, sum and count
+    static const int LINES_PER_HISTOGRAM = RdWebLatencyHistogram::NUM_BOUNDS + 3;
+
+    // Longest label value output
+    static const int MAX_LABEL_VALUE_LEN = 96;
+
+    struct Series
+    {
+        const void            *_pTarget;
+        const char            *_pName;
+        SeriesKind            _kind;
+        RdWebLatencyHistogram _hist;
+    };
+    Series _series[MAX_SERIES];
+    int    _numSeries;
+
+    RdWebLatencyHistogram _phaseHists[NUM_PHASES];
+
+    static const char *getPhaseName(int phase);
+    static const char *getKindName(SeriesKind kind);
+    int findSeries(SeriesKind kind, const void *pTarget, const char *pName);
+    static int formHistogramLine(char *pBuf, int bufLen, const char *pMetricName, const char *pLabels,
+                                 const RdWebLatencyHistogram& hist, int lineInHist);
+};
@@ -0,0 +1,56 @@
+// Web server platform selection
+// Rob Dobson 2012-2017
+
+// Define RDWEBSERVER_POSIX to build the web server on a host (e.g. Linux) - in that case
+// a minimal set of the Particle wiring API (String, Log, millis, etc) is provided by
+// RdPosixWiring.h and the TCP stack is implemented with BSD sockets
+
+#pragma once
+
+#ifdef RDWEBSERVER_POSIX
+#include "RdPosixWiring.h"
+#else
+#include "application.h"
+#endif
+
+// Count of heap allocations made so far - used to check that request handling doesn't
+// allocate - only available on host builds
+#ifdef RDWEBSERVER_POSIX
+#define RDWEBSERVER_HEAP_ALLOC_COUNT() RdPosixHeapAllocCount()
+#else
+#define RDWEBSERVER_HEAP_ALLOC_COUNT() 0UL
+#endif
+
+// Logging - calls below RDWEBSERVER_LOG_LEVEL (set when building e.g.
+// -DRDWEBSERVER_LOG_LEVEL=RDWEBSERVER_LOG_LEVEL_INFO) compile to nothing so their arguments
+// aren't evaluated - trace arguments are also only evaluated (and formatted) when trace is
+// enabled at run time - levels have the same values as Particle's LOG_LEVEL_xxx
+#define RDWEBSERVER_LOG_LEVEL_TRACE 1
+#define RDWEBSERVER_LOG_LEVEL_INFO  30
+#define RDWEBSERVER_LOG_LEVEL_WARN  40
+#define RDWEBSERVER_LOG_LEVEL_ERROR 50
+#define RDWEBSERVER_LOG_LEVEL_NONE  70
+#ifndef RDWEBSERVER_LOG_LEVEL
+#define RDWEBSERVER_LOG_LEVEL RDWEBSERVER_LOG_LEVEL_TRACE
+#endif
+
+#if RDWEBSERVER_LOG_LEVEL <= RDWEBSERVER_LOG_LEVEL_TRACE
+#define RDWS_LOG_TRACE(...) do { if (Log.isTraceEnabled()) { Log.trace(__VA_ARGS__); } } while (0)
+#else
+#define RDWS_LOG_TRACE(...) do { } while (0)
+#endif
+#if RDWEBSERVER_LOG_LEVEL <= RDWEBSERVER_LOG_LEVEL_INFO
+#define RDWS_LOG_INFO(...) Log.info(__VA_ARGS__)
+#else
+#define RDWS_LOG_INFO(...) do { } while (0)
+#endif
+#if RDWEBSERVER_LOG_LEVEL <= RDWEBSERVER_LOG_LEVEL_WARN
+#define RDWS_LOG_WARN(...) Log.warn(__VA_ARGS__)
+#else
+#define RDWS_LOG_WARN(...) do { } while (0)
+#endif
+#if RDWEBSERVER_LOG_LEVEL <= RDWEBSERVER_LOG_LEVEL_ERROR
+#define RDWS_LOG_ERROR(...) Log.error(__VA_ARGS__)
+#else
+#define RDWS_LOG_ERROR(...) do { } while (0)
+#endif
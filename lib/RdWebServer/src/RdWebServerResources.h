@@ -3,18 +3,138 @@
 
 #pragma once
 
+#include <stdint.h>
+
+// Encoded (e.g. gzip compressed) variant of a resource with its precomputed response and
+// caching headers
+class RdWebServerResourceVariant
+{
+public:
+    RdWebServerResourceVariant(const char *pEncoding, const unsigned char *pData, int dataLen,
+                               const char *pRespHeader, int respHeaderLen,
+                               const char *pCacheHeaders, int cacheHeadersLen, const char *pETag)
+    {
+        _pEncoding       = pEncoding;
+        _pData           = pData;
+        _dataLen         = dataLen;
+        _pRespHeader     = pRespHeader;
+        _respHeaderLen   = respHeaderLen;
+        _pCacheHeaders   = pCacheHeaders;
+        _cacheHeadersLen = cacheHeadersLen;
+        _pETag           = pETag;
+    }
+    const char          *_pEncoding;
+    const unsigned char *_pData;
+    int                 _dataLen;
+    const char          *_pRespHeader;
+    int                 _respHeaderLen;
+    const char          *_pCacheHeaders;
+    int                 _cacheHeadersLen;
+    const char          *_pETag;
+};
+
 class RdWebServerResourceDescr
 {
 public:
     RdWebServerResourceDescr(const char *pResId, const char *pMimeType, const unsigned char *pData, int dataLen)
     {
-        _pResId    = pResId;
-        _pMimeType = pMimeType;
-        _pData     = pData;
-        _dataLen   = dataLen;
+        _pResId          = pResId;
+        _pMimeType       = pMimeType;
+        _pData           = pData;
+        _dataLen         = dataLen;
+        _pRespHeader     = NULL;
+        _respHeaderLen   = 0;
+        _pCacheHeaders   = NULL;
+        _cacheHeadersLen = 0;
+        _pETag           = NULL;
+        _pVariants       = NULL;
+        _numVariants     = 0;
+    }
+    // Resource with a precomputed response header - the status line, Content-Type and
+    // Content-Length (the server adds the CORS and connection headers and the blank line)
+    RdWebServerResourceDescr(const char *pResId, const char *pMimeType, const unsigned char *pData, int dataLen,
+                             const char *pRespHeader, int respHeaderLen)
+    {
+        _pResId          = pResId;
+        _pMimeType       = pMimeType;
+        _pData           = pData;
+        _dataLen         = dataLen;
+        _pRespHeader     = pRespHeader;
+        _respHeaderLen   = respHeaderLen;
+        _pCacheHeaders   = NULL;
+        _cacheHeadersLen = 0;
+        _pETag           = NULL;
+        _pVariants       = NULL;
+        _numVariants     = 0;
+    }
+    // Resource with caching headers (ETag, Cache-Control and Vary - sent with 200 and 304
+    // responses), the ETag itself (quoted) and encoded variants in order of preference
+    RdWebServerResourceDescr(const char *pResId, const char *pMimeType, const unsigned char *pData, int dataLen,
+                             const char *pRespHeader, int respHeaderLen,
+                             const char *pCacheHeaders, int cacheHeadersLen, const char *pETag,
+                             const RdWebServerResourceVariant *pVariants, int numVariants)
+    {
+        _pResId          = pResId;
+        _pMimeType       = pMimeType;
+        _pData           = pData;
+        _dataLen         = dataLen;
+        _pRespHeader     = pRespHeader;
+        _respHeaderLen   = respHeaderLen;
+        _pCacheHeaders   = pCacheHeaders;
+        _cacheHeadersLen = cacheHeadersLen;
+        _pETag           = pETag;
+        _pVariants       = pVariants;
+        _numVariants     = numVariants;
     }
     const char          *_pResId;
     const char          *_pMimeType;
     const unsigned char *_pData;
     int                 _dataLen;
+    const char          *_pRespHeader;
+    int                 _respHeaderLen;
+    const char          *_pCacheHeaders;
+    int                 _cacheHeadersLen;
+    const char          *_pETag;
+    const RdWebServerResourceVariant *_pVariants;
+    int                 _numVariants;
+};
+
+// Perfect hash index of resources (generated by GenResources.py) - the hash of a lowercased
+// resource name selects a slot holding the index of the only resource which can have that name
+// (or -1) so finding a resource costs one hash and one compare however many there are
+class RdWebServerResourceIndex
+{
+public:
+    RdWebServerResourceIndex(uint32_t seed, int numSlots, const int16_t *pSlots)
+    {
+        _seed     = seed;
+        _numSlots = numSlots;
+        _pSlots   = pSlots;
+    }
+
+    // FNV-1a hash of a name (case insensitive) starting from a seed - must match GenResources.py
+    static uint32_t hashName(const char *pName, uint32_t seed)
+    {
+        uint32_t hash = 2166136261UL ^ seed;
+        for (const char *pCh = pName; *pCh; pCh++)
+        {
+            char ch = *pCh;
+            if ((ch >= 'A') && (ch <= 'Z'))
+                ch += 'a' - 'A';
+            hash = (hash ^ (uint8_t)ch) * 16777619UL;
+        }
+        return hash;
+    }
+
+    // Index of the resource which may match the name (or -1) - the caller must compare names
+    int getCandidate(const char *pName) const
+    {
+        if (_numSlots <= 0)
+            return -1;
+        return _pSlots[hashName(pName, _seed) % _numSlots];
+    }
+
+    uint32_t      _seed;
+    int           _numSlots;
+    const int16_t *_pSlots;
 };
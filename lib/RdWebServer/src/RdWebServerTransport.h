@@ -0,0 +1,90 @@
+// Web server transport
+// Rob Dobson 2012-2017
+
+// The web server and its clients only talk to the TCP stack through this interface so the
+// same request/response state machine can run on a Particle device (TCPServer/TCPClient)
+// or on a host using BSD sockets
+
+#pragma once
+
+#include "RdWebServerPlatform.h"
+
+// Block of data to send - a response is sent as a list of these (e.g. header, preformatted
+// header suffix and body) without copying them together
+struct RdWebTxSegment
+{
+    const uint8_t *_pData;
+    int           _len;
+};
+
+class RdWebServerTransport
+{
+public:
+    virtual ~RdWebServerTransport()
+    {
+    }
+
+    // Check if the network is available (e.g. WiFi connected)
+    virtual bool isNetworkReady() = 0;
+
+    // Start listening on a port - maxConnections is the number of connections
+    // which may be open at the same time
+    virtual bool begin(int port, int maxConnections) = 0;
+
+    // Stop listening and close all connections
+    virtual void stop() = 0;
+
+    // Called at the start of each web server service loop - a transport which can wait for
+    // network events (data received, send buffer space or a new connection) may block for up
+    // to maxWaitMs (0 when a client has work to do without waiting)
+    virtual void service(unsigned long /* maxWaitMs */)
+    {
+    }
+
+    // Accept a new connection - returns a connection id (>= 0) or -1 if none pending
+    virtual int accept() = 0;
+
+    // Connection status and number of bytes waiting to be read
+    virtual bool connected(int connId) = 0;
+    virtual int available(int connId) = 0;
+
+    // Read - returns number of bytes read (<= 0 if none)
+    virtual int read(int connId, uint8_t *pBuf, int maxLen) = 0;
+
+    // Write - returns number of bytes written or < 0 on error
+    virtual int write(int connId, const uint8_t *pBuf, int len) = 0;
+    virtual void flush(int connId) = 0;
+
+    // Gather write of a list of segments - returns number of bytes written (which may end part
+    // way through a segment) or < 0 on error - transports should send small segments together
+    // rather than as a packet each - by default each segment is written in turn
+    virtual int writev(int connId, const RdWebTxSegment *pSegs, int numSegs)
+    {
+        int totalWritten = 0;
+        for (int segIdx = 0; segIdx < numSegs; segIdx++)
+        {
+            int numWritten = write(connId, pSegs[segIdx]._pData, pSegs[segIdx]._len);
+            if (numWritten < 0)
+            {
+                return (totalWritten > 0) ? totalWritten : numWritten;
+            }
+            totalWritten += numWritten;
+            if (numWritten < pSegs[segIdx]._len)
+            {
+                break;
+            }
+        }
+        return totalWritten;
+    }
+
+    // True if write() only takes as much data as there is send buffer space for and returns
+    // the number of bytes taken - the web client then pushes data whenever there is space.
+    // Otherwise the web client falls back to pacing frames with fixed delays
+    virtual bool reportsSendSpace() = 0;
+
+    // Close connection
+    virtual void close(int connId) = 0;
+
+    // Remote IP address as a string (for debug)
+    virtual void getRemoteIPStr(int connId, char *pBuf, int bufLen) = 0;
+};
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "limits.h"
+#include "RdWebServerPlatform.h"
 
 class RdWebServerUtils
 {
@@ -30,20 +31,22 @@ public:
     }
     static void logLongStr(const char* headerMsg, const char* toLog, bool infoLevel = false)
     {
+        // Nothing to do if the level isn't enabled
+        if (infoLevel ? (RDWEBSERVER_LOG_LEVEL > RDWEBSERVER_LOG_LEVEL_INFO) :
+                        ((RDWEBSERVER_LOG_LEVEL > RDWEBSERVER_LOG_LEVEL_TRACE) || !Log.isTraceEnabled()))
+            return;
         if (infoLevel)
-            Log.info(headerMsg);
+            RDWS_LOG_INFO("%s", headerMsg);
         else
-            Log.trace(headerMsg);
-        const int linLen = 80;
-        for (unsigned int i = 0; i < strlen(toLog); i+=linLen)
+            RDWS_LOG_TRACE("%s", headerMsg);
+        const int linLen   = 80;
+        int       toLogLen = strlen(toLog);
+        for (int i = 0; i < toLogLen; i += linLen)
         {
-            char pBuf[linLen+1];
-            strncpy(pBuf, toLog+i, linLen);
-            pBuf[linLen] = 0;
             if (infoLevel)
-                Log.info(pBuf);
+                RDWS_LOG_INFO("%.*s", linLen, toLog + i);
             else
-                Log.trace(pBuf);
+                RDWS_LOG_TRACE("%.*s", linLen, toLog + i);
         }
     }
 };
@@ -0,0 +1,262 @@
+// Web server transport using Particle TCPServer/TCPClient
+// Rob Dobson 2012-2017
+
+#ifndef RDWEBSERVER_POSIX
+
+#include "RdWebTransportParticle.h"
+
+RdWebTransportParticle::RdWebTransportParticle()
+{
+    _pTCPServer     = NULL;
+    _pTCPClients    = NULL;
+    _pClientInUse   = NULL;
+    _maxConnections = 0;
+    _pTxCoalesceBuf = NULL;
+    _pacedSend      = false;
+}
+
+
+RdWebTransportParticle::~RdWebTransportParticle()
+{
+    stop();
+}
+
+
+bool RdWebTransportParticle::isNetworkReady()
+{
+    return WiFi.ready();
+}
+
+
+bool RdWebTransportParticle::begin(int port, int maxConnections)
+{
+    // Check if already started
+    if (_pTCPServer)
+    {
+        stop();
+    }
+    // Clients
+    _maxConnections = maxConnections;
+    _pTCPClients    = new TCPClient[_maxConnections];
+    _pClientInUse   = new bool[_maxConnections];
+    for (int i = 0; i < _maxConnections; i++)
+    {
+        _pClientInUse[i] = false;
+    }
+    _pTxCoalesceBuf = new uint8_t[TX_COALESCE_BUF_SIZE];
+    // Create server and begin
+    _pTCPServer = new TCPServer(port);
+    if (!_pTCPServer)
+    {
+        return false;
+    }
+    _pTCPServer->begin();
+    return true;
+}
+
+
+void RdWebTransportParticle::stop()
+{
+    if (_pTCPServer)
+    {
+        _pTCPServer->stop();
+        // Delete previous server
+        delete _pTCPServer;
+        _pTCPServer = NULL;
+    }
+    for (int i = 0; i < _maxConnections; i++)
+    {
+        if (_pClientInUse[i])
+        {
+            _pTCPClients[i].stop();
+        }
+    }
+    delete [] _pTCPClients;
+    _pTCPClients = NULL;
+    delete [] _pClientInUse;
+    _pClientInUse   = NULL;
+    _maxConnections = 0;
+    delete [] _pTxCoalesceBuf;
+    _pTxCoalesceBuf = NULL;
+}
+
+
+int RdWebTransportParticle::accept()
+{
+    if (!_pTCPServer)
+    {
+        return -1;
+    }
+    // Find a free slot
+    int connId = -1;
+    for (int i = 0; i < _maxConnections; i++)
+    {
+        if (!_pClientInUse[i])
+        {
+            connId = i;
+            break;
+        }
+    }
+    if (connId < 0)
+    {
+        return -1;
+    }
+    // See if a connection is ready to be accepted
+    _pTCPClients[connId] = _pTCPServer->available();
+    if (!_pTCPClients[connId])
+    {
+        return -1;
+    }
+    _pClientInUse[connId] = true;
+    return connId;
+}
+
+
+bool RdWebTransportParticle::connected(int connId)
+{
+    if (!isValidConn(connId))
+    {
+        return false;
+    }
+    return _pTCPClients[connId].connected();
+}
+
+
+int RdWebTransportParticle::available(int connId)
+{
+    if (!isValidConn(connId))
+    {
+        return 0;
+    }
+    return _pTCPClients[connId].available();
+}
+
+
+int RdWebTransportParticle::read(int connId, uint8_t *pBuf, int maxLen)
+{
+    if (!isValidConn(connId))
+    {
+        return -1;
+    }
+    return _pTCPClients[connId].read(pBuf, maxLen);
+}
+
+
+int RdWebTransportParticle::write(int connId, const uint8_t *pBuf, int len)
+{
+    if (!isValidConn(connId))
+    {
+        return -1;
+    }
+    // A negative result on a connection which is still open means the send buffer is full -
+    // nothing was taken so the web client tries again when it next services the connection
+    int numWritten = _pTCPClients[connId].write(pBuf, len);
+    if ((numWritten < 0) && _pTCPClients[connId].connected())
+    {
+        return 0;
+    }
+    return numWritten;
+}
+
+
+int RdWebTransportParticle::writev(int connId, const RdWebTxSegment *pSegs, int numSegs)
+{
+    if (!isValidConn(connId) || !_pTxCoalesceBuf)
+    {
+        return -1;
+    }
+    // Segments are copied into the coalescing buffer which is written each time it is full -
+    // data which would fill it anyway is written from where it is
+    int totalWritten = 0;
+    int bufLen       = 0;
+    for (int segIdx = 0; segIdx < numSegs; segIdx++)
+    {
+        const uint8_t *pData = pSegs[segIdx]._pData;
+        int           len    = pSegs[segIdx]._len;
+        if ((bufLen == 0) && (len >= TX_COALESCE_BUF_SIZE))
+        {
+            if (!writeBlock(connId, pData, len, totalWritten))
+            {
+                return totalWritten;
+            }
+            continue;
+        }
+        while (len > 0)
+        {
+            int numToCopy = TX_COALESCE_BUF_SIZE - bufLen;
+            if (numToCopy > len)
+            {
+                numToCopy = len;
+            }
+            memcpy(_pTxCoalesceBuf + bufLen, pData, numToCopy);
+            bufLen += numToCopy;
+            pData  += numToCopy;
+            len    -= numToCopy;
+            if (bufLen == TX_COALESCE_BUF_SIZE)
+            {
+                if (!writeBlock(connId, _pTxCoalesceBuf, bufLen, totalWritten))
+                {
+                    return totalWritten;
+                }
+                bufLen = 0;
+            }
+        }
+    }
+    if (bufLen > 0)
+    {
+        writeBlock(connId, _pTxCoalesceBuf, bufLen, totalWritten);
+    }
+    return totalWritten;
+}
+
+
+bool RdWebTransportParticle::writeBlock(int connId, const uint8_t *pBuf, int len, int& totalWritten)
+{
+    int numWritten = write(connId, pBuf, len);
+    if (numWritten < 0)
+    {
+        // An error is only reported if nothing has been written
+        if (totalWritten == 0)
+        {
+            totalWritten = numWritten;
+        }
+        return false;
+    }
+    totalWritten += numWritten;
+    return numWritten == len;
+}
+
+
+void RdWebTransportParticle::flush(int connId)
+{
+    if (!isValidConn(connId))
+    {
+        return;
+    }
+    _pTCPClients[connId].flush();
+}
+
+
+void RdWebTransportParticle::close(int connId)
+{
+    if (!isValidConn(connId))
+    {
+        return;
+    }
+    _pTCPClients[connId].stop();
+    _pClientInUse[connId] = false;
+}
+
+
+void RdWebTransportParticle::getRemoteIPStr(int connId, char *pBuf, int bufLen)
+{
+    if (!isValidConn(connId))
+    {
+        snprintf(pBuf, bufLen, "-");
+        return;
+    }
+    IPAddress ip = _pTCPClients[connId].remoteIP();
+    snprintf(pBuf, bufLen, "%d.%d.%d.%d", ip[0], ip[1], ip[2], ip[3]);
+}
+
+#endif // RDWEBSERVER_POSIX
@@ -0,0 +1,66 @@
+// Web server transport using Particle TCPServer/TCPClient
+// Rob Dobson 2012-2017
+
+#pragma once
+
+#ifndef RDWEBSERVER_POSIX
+
+#include "RdWebServerTransport.h"
+
+class RdWebTransportParticle : public RdWebServerTransport
+{
+public:
+    RdWebTransportParticle();
+    virtual ~RdWebTransportParticle();
+
+    virtual bool isNetworkReady();
+    virtual bool begin(int port, int maxConnections);
+    virtual void stop();
+    virtual int accept();
+    virtual bool connected(int connId);
+    virtual int available(int connId);
+    virtual int read(int connId, uint8_t *pBuf, int maxLen);
+    virtual int write(int connId, const uint8_t *pBuf, int len);
+    virtual int writev(int connId, const RdWebTxSegment *pSegs, int numSegs);
+    // A full send buffer is reported by TCPClient::write() (it returns a negative value) so
+    // responses are sent as fast as the buffer empties - fixed pacing of frames (the previous
+    // behaviour) is kept as a fallback for firmware which doesn't report it
+    virtual bool reportsSendSpace()
+    {
+        return !_pacedSend;
+    }
+    void setPacedSend(bool pacedSend)
+    {
+        _pacedSend = pacedSend;
+    }
+    virtual void flush(int connId);
+    virtual void close(int connId);
+    virtual void getRemoteIPStr(int connId, char *pBuf, int bufLen);
+
+private:
+    // Small segments of a gather write are copied together so they are sent in packets of
+    // up to the TCP maximum segment size
+    static const int TX_COALESCE_BUF_SIZE = 1460;
+    uint8_t *_pTxCoalesceBuf;
+
+    // TCP server
+    TCPServer *_pTCPServer;
+
+    // TCP clients - one per connection
+    TCPClient *_pTCPClients;
+    bool      *_pClientInUse;
+    int       _maxConnections;
+
+    // Send frames with fixed delays rather than when there is buffer space
+    bool _pacedSend;
+
+    bool isValidConn(int connId)
+    {
+        return (connId >= 0) && (connId < _maxConnections) && _pClientInUse[connId];
+    }
+
+    // Write a block as part of a gather write - returns false if it wasn't all written
+    bool writeBlock(int connId, const uint8_t *pBuf, int len, int& totalWritten);
+};
+
+#endif // RDWEBSERVER_POSIX
@@ -0,0 +1,445 @@
+// Web server transport using non-blocking BSD sockets and epoll (Linux)
+// Rob Dobson 2012-2017
+
+#ifdef RDWEBSERVER_POSIX
+
+#include "RdWebTransportPosix.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+RdWebTransportPosix::RdWebTransportPosix()
+{
+    _listenFd       = -1;
+    _epollFd        = -1;
+    _listenReady    = false;
+    _pConns         = NULL;
+    _maxConnections = 0;
+}
+
+
+RdWebTransportPosix::~RdWebTransportPosix()
+{
+    stop();
+}
+
+
+bool RdWebTransportPosix::isNetworkReady()
+{
+    return true;
+}
+
+
+bool RdWebTransportPosix::begin(int port, int maxConnections)
+{
+    // Check if already started
+    if (_listenFd >= 0)
+    {
+        stop();
+    }
+
+    // Listening socket
+    _listenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (_listenFd < 0)
+    {
+        RDWS_LOG_ERROR("WebTransportPosix socket failed errno %d", errno);
+        return false;
+    }
+    int optVal = 1;
+    setsockopt(_listenFd, SOL_SOCKET, SO_REUSEADDR, &optVal, sizeof(optVal));
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family      = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port        = htons(port);
+    if ((bind(_listenFd, (struct sockaddr *)&addr, sizeof(addr)) < 0) ||
+        (listen(_listenFd, LISTEN_BACKLOG) < 0))
+    {
+        RDWS_LOG_ERROR("WebTransportPosix bind/listen port %d failed errno %d", port, errno);
+        ::close(_listenFd);
+        _listenFd = -1;
+        return false;
+    }
+
+    // Event notification - edge triggered so that a socket which isn't read (e.g. while a
+    // response is being sent) doesn't stop service() from waiting
+    _epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (_epollFd < 0)
+    {
+        RDWS_LOG_ERROR("WebTransportPosix epoll_create1 failed errno %d", errno);
+        ::close(_listenFd);
+        _listenFd = -1;
+        return false;
+    }
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events   = EPOLLIN | EPOLLET;
+    ev.data.u32 = LISTEN_SOCKET_MARKER;
+    epoll_ctl(_epollFd, EPOLL_CTL_ADD, _listenFd, &ev);
+    // Connections may have been queued before the socket was added
+    _listenReady = true;
+
+    // Connections - only allocated once listening (a failed begin() leaves nothing to free)
+    _maxConnections = maxConnections;
+    _pConns         = new PosixConn[_maxConnections];
+    for (int i = 0; i < _maxConnections; i++)
+    {
+        _pConns[i]._fd           = -1;
+        _pConns[i]._peerClosed   = false;
+        _pConns[i]._readable     = false;
+        _pConns[i]._writeBlocked = false;
+    }
+    return true;
+}
+
+
+void RdWebTransportPosix::stop()
+{
+    for (int i = 0; i < _maxConnections; i++)
+    {
+        close(i);
+    }
+    delete [] _pConns;
+    _pConns         = NULL;
+    _maxConnections = 0;
+    if (_epollFd >= 0)
+    {
+        ::close(_epollFd);
+        _epollFd = -1;
+    }
+    if (_listenFd >= 0)
+    {
+        ::close(_listenFd);
+        _listenFd = -1;
+    }
+}
+
+
+void RdWebTransportPosix::service(unsigned long maxWaitMs)
+{
+    if (_epollFd < 0)
+    {
+        return;
+    }
+    // Data which hasn't been read yet isn't reported again - the web server doesn't pass a
+    // wait time when a client is waiting to read it - but a connection which couldn't be
+    // accepted earlier (no free slot) is accepted straight away once a slot is free
+    int timeoutMs = (maxWaitMs > INT_MAX) ? INT_MAX : (int)maxWaitMs;
+    if (_listenReady && (findFreeConn() >= 0))
+    {
+        timeoutMs = 0;
+    }
+    struct epoll_event events[MAX_EPOLL_EVENTS];
+    int numEvents = epoll_wait(_epollFd, events, MAX_EPOLL_EVENTS, timeoutMs);
+    for (int i = 0; i < numEvents; i++)
+    {
+        uint32_t connId = events[i].data.u32;
+        if (connId == LISTEN_SOCKET_MARKER)
+        {
+            _listenReady = true;
+            continue;
+        }
+        if ((int)connId >= _maxConnections)
+        {
+            continue;
+        }
+        // Data to read
+        if (events[i].events & EPOLLIN)
+        {
+            _pConns[connId]._readable = true;
+        }
+        // Record hang-up so that connected() reports it once all data is read
+        if (events[i].events & (EPOLLRDHUP | EPOLLHUP | EPOLLERR))
+        {
+            _pConns[connId]._peerClosed = true;
+            _pConns[connId]._readable   = true;
+        }
+        // Space in the send buffer again
+        if ((events[i].events & EPOLLOUT) && _pConns[connId]._writeBlocked)
+        {
+            _pConns[connId]._writeBlocked = false;
+            setConnEvents(connId, false);
+        }
+    }
+}
+
+
+int RdWebTransportPosix::accept()
+{
+    if ((_listenFd < 0) || !_listenReady)
+    {
+        return -1;
+    }
+    // Find a free slot
+    int connId = findFreeConn();
+    if (connId < 0)
+    {
+        return -1;
+    }
+
+    // Accept
+    struct sockaddr_in addr;
+    socklen_t          addrLen = sizeof(addr);
+    int fd = accept4(_listenFd, (struct sockaddr *)&addr, &addrLen, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (fd < 0)
+    {
+        // Nothing more to accept until epoll reports the socket again
+        if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+        {
+            _listenReady = false;
+        }
+        return -1;
+    }
+    int optVal = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &optVal, sizeof(optVal));
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events   = EPOLLIN | EPOLLRDHUP | EPOLLET;
+    ev.data.u32 = connId;
+    if (epoll_ctl(_epollFd, EPOLL_CTL_ADD, fd, &ev) < 0)
+    {
+        ::close(fd);
+        return -1;
+    }
+    PosixConn& conn = _pConns[connId];
+    conn._fd           = fd;
+    conn._peerClosed   = false;
+    // The request may have arrived before the socket was added
+    conn._readable     = true;
+    conn._writeBlocked = false;
+    inet_ntop(AF_INET, &addr.sin_addr, conn._remoteIPStr, sizeof(conn._remoteIPStr));
+    return connId;
+}
+
+
+bool RdWebTransportPosix::connected(int connId)
+{
+    if (!isValidConn(connId))
+    {
+        return false;
+    }
+    // As with TCPClient a connection closed by the peer is still connected while data remains
+    if (_pConns[connId]._peerClosed)
+    {
+        return available(connId) > 0;
+    }
+    return true;
+}
+
+
+int RdWebTransportPosix::available(int connId)
+{
+    if (!isValidConn(connId))
+    {
+        return 0;
+    }
+    // Only sockets which epoll has reported data on (and which haven't been read to the end
+    // since) are checked
+    if (!_pConns[connId]._readable)
+    {
+        return 0;
+    }
+    int numAvailable = 0;
+    if (ioctl(_pConns[connId]._fd, FIONREAD, &numAvailable) < 0)
+    {
+        return 0;
+    }
+    if (numAvailable <= 0)
+    {
+        _pConns[connId]._readable = false;
+    }
+    return numAvailable;
+}
+
+
+int RdWebTransportPosix::read(int connId, uint8_t *pBuf, int maxLen)
+{
+    if (!isValidConn(connId))
+    {
+        return -1;
+    }
+    ssize_t numRead = recv(_pConns[connId]._fd, pBuf, maxLen, MSG_DONTWAIT);
+    if (numRead == 0)
+    {
+        _pConns[connId]._peerClosed = true;
+        _pConns[connId]._readable   = false;
+        return 0;
+    }
+    if (numRead < 0)
+    {
+        if (errno == EINTR)
+        {
+            return 0;
+        }
+        if ((errno != EAGAIN) && (errno != EWOULDBLOCK))
+        {
+            _pConns[connId]._peerClosed = true;
+        }
+        _pConns[connId]._readable = false;
+        return 0;
+    }
+    // A short read empties the socket
+    if (numRead < maxLen)
+    {
+        _pConns[connId]._readable = false;
+    }
+    return numRead;
+}
+
+
+int RdWebTransportPosix::write(int connId, const uint8_t *pBuf, int len)
+{
+    if (!isValidConn(connId))
+    {
+        return -1;
+    }
+    // Don't retry until epoll reports the socket writable
+    if (_pConns[connId]._writeBlocked)
+    {
+        return 0;
+    }
+    ssize_t numWritten = send(_pConns[connId]._fd, pBuf, len, MSG_DONTWAIT | MSG_NOSIGNAL);
+    if (numWritten < 0)
+    {
+        if (errno == EINTR)
+        {
+            return 0;
+        }
+        if ((errno != EAGAIN) && (errno != EWOULDBLOCK))
+        {
+            _pConns[connId]._peerClosed = true;
+            return -1;
+        }
+        numWritten = 0;
+    }
+    // A short write means the send buffer is full
+    if (numWritten < len)
+    {
+        _pConns[connId]._writeBlocked = true;
+        setConnEvents(connId, true);
+    }
+    return numWritten;
+}
+
+
+int RdWebTransportPosix::writev(int connId, const RdWebTxSegment *pSegs, int numSegs)
+{
+    if (!isValidConn(connId))
+    {
+        return -1;
+    }
+    // Don't retry until epoll reports the socket writable
+    if (_pConns[connId]._writeBlocked)
+    {
+        return 0;
+    }
+    // All segments are passed to the kernel in one call so they are sent in full size
+    // packets (Nagle is disabled on the socket)
+    struct iovec iovs[MAX_WRITEV_SEGMENTS];
+    int          len = 0;
+    if (numSegs > MAX_WRITEV_SEGMENTS)
+    {
+        numSegs = MAX_WRITEV_SEGMENTS;
+    }
+    for (int segIdx = 0; segIdx < numSegs; segIdx++)
+    {
+        iovs[segIdx].iov_base = (void *)pSegs[segIdx]._pData;
+        iovs[segIdx].iov_len  = pSegs[segIdx]._len;
+        len += pSegs[segIdx]._len;
+    }
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov    = iovs;
+    msg.msg_iovlen = numSegs;
+    ssize_t numWritten = sendmsg(_pConns[connId]._fd, &msg, MSG_DONTWAIT | MSG_NOSIGNAL);
+    if (numWritten < 0)
+    {
+        if (errno == EINTR)
+        {
+            return 0;
+        }
+        if ((errno != EAGAIN) && (errno != EWOULDBLOCK))
+        {
+            _pConns[connId]._peerClosed = true;
+            return -1;
+        }
+        numWritten = 0;
+    }
+    // A short write means the send buffer is full
+    if (numWritten < len)
+    {
+        _pConns[connId]._writeBlocked = true;
+        setConnEvents(connId, true);
+    }
+    return numWritten;
+}
+
+
+void RdWebTransportPosix::flush(int /* connId */)
+{
+    // Nothing to do - data is pushed by the kernel
+}
+
+
+void RdWebTransportPosix::close(int connId)
+{
+    if (!isValidConn(connId))
+    {
+        return;
+    }
+    PosixConn& conn = _pConns[connId];
+    epoll_ctl(_epollFd, EPOLL_CTL_DEL, conn._fd, NULL);
+    ::close(conn._fd);
+    conn._fd           = -1;
+    conn._peerClosed   = false;
+    conn._readable     = false;
+    conn._writeBlocked = false;
+}
+
+
+int RdWebTransportPosix::findFreeConn()
+{
+    for (int i = 0; i < _maxConnections; i++)
+    {
+        if (_pConns[i]._fd < 0)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+
+void RdWebTransportPosix::setConnEvents(int connId, bool waitWritable)
+{
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events   = EPOLLIN | EPOLLRDHUP | EPOLLET;
+    if (waitWritable)
+    {
+        ev.events |= EPOLLOUT;
+    }
+    ev.data.u32 = connId;
+    epoll_ctl(_epollFd, EPOLL_CTL_MOD, _pConns[connId]._fd, &ev);
+}
+
+
+void RdWebTransportPosix::getRemoteIPStr(int connId, char *pBuf, int bufLen)
+{
+    if (!isValidConn(connId))
+    {
+        snprintf(pBuf, bufLen, "-");
+        return;
+    }
+    snprintf(pBuf, bufLen, "%s", _pConns[connId]._remoteIPStr);
+}
+
+#endif // RDWEBSERVER_POSIX
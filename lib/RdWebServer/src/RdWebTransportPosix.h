@@ -0,0 +1,80 @@
+// Web server transport using non-blocking BSD sockets and epoll (Linux)
+// Rob Dobson 2012-2017
+
+#pragma once
+
+#ifdef RDWEBSERVER_POSIX
+
+#include "RdWebServerTransport.h"
+
+class RdWebTransportPosix : public RdWebServerTransport
+{
+public:
+    RdWebTransportPosix();
+    virtual ~RdWebTransportPosix();
+
+    virtual bool isNetworkReady();
+    virtual bool begin(int port, int maxConnections);
+    virtual void stop();
+    virtual void service(unsigned long maxWaitMs);
+    virtual int accept();
+    virtual bool connected(int connId);
+    virtual int available(int connId);
+    virtual int read(int connId, uint8_t *pBuf, int maxLen);
+    virtual int write(int connId, const uint8_t *pBuf, int len);
+    virtual int writev(int connId, const RdWebTxSegment *pSegs, int numSegs);
+    virtual bool reportsSendSpace()
+    {
+        return true;
+    }
+    virtual void flush(int connId);
+    virtual void close(int connId);
+    virtual void getRemoteIPStr(int connId, char *pBuf, int bufLen);
+
+private:
+    // Listen backlog
+    static const int LISTEN_BACKLOG = 128;
+
+    // Max events handled in each call to service()
+    static const int MAX_EPOLL_EVENTS = 64;
+
+    // Max segments in a gather write
+    static const int MAX_WRITEV_SEGMENTS = 16;
+
+    // Marker for the listening socket in epoll data
+    static const uint32_t LISTEN_SOCKET_MARKER = 0xffffffff;
+
+    // Connection info
+    struct PosixConn
+    {
+        int  _fd;
+        bool _peerClosed;
+        // Data (or end of stream) reported by epoll and not yet all read
+        bool _readable;
+        // Send buffer full - waiting for a writable event
+        bool _writeBlocked;
+        char _remoteIPStr[48];
+    };
+
+    // Sockets - the listening socket is only accepted from when epoll reports it
+    int  _listenFd;
+    int  _epollFd;
+    bool _listenReady;
+
+    // Connections
+    PosixConn *_pConns;
+    int       _maxConnections;
+
+    // Free connection slot or -1
+    int findFreeConn();
+
+    // Set the events of interest for a connection
+    void setConnEvents(int connId, bool waitWritable);
+
+    bool isValidConn(int connId)
+    {
+        return (connId >= 0) && (connId < _maxConnections) && (_pConns[connId]._fd >= 0);
+    }
+};
+
+#endif // RDWEBSERVER_POSIX
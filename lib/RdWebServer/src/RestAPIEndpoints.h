@@ -4,16 +4,45 @@
 #pragma once
 
 #include <functional>
+#include "RdWebServerPlatform.h"
+#include "RdHttpRequestParser.h"
+
+// Parameter captured from the request path by a pattern endpoint (e.g. id in
+// devices/:id/settings) - the name points into the pattern and the value (decoded) into
+// the request so neither is NUL terminated
+struct RestAPIParam
+{
+    const char* _pName;
+    int _nameLen;
+    const char* _pValue;
+    int _valueLen;
+};
 
 // Information on received API request
 struct RestAPIEndpointMsg
 {
+    // Max parameters captured from the path
+    static const int MAX_PATH_PARAMS = 4;
+
     int _method;
     const char* _pEndpointStr;
     const char* _pArgStr;
     const char* _pMsgHeader;
     unsigned char* _pMsgContent;
     int _msgContentLen;
+    // Streaming endpoints only - position in the response which the callback can use to keep
+    // track of what it has sent (0 on the first call and kept between calls)
+    unsigned long _streamPos;
+    // Upload endpoints only - position in the request body of the content passed to the body
+    // callback and the total length of the body
+    int _contentPos;
+    int _contentTotalLen;
+    // Web client handling the request - bodies of requests on different connections are
+    // passed to upload endpoints interleaved so this tells them apart
+    int _clientIdx;
+    // Pattern endpoints only - parameters captured from the path
+    RestAPIParam _params[MAX_PATH_PARAMS];
+    int _numParams;
     RestAPIEndpointMsg(int method, const char* pEndpointStr, const char* pArgStr, const char* pMsgHeader)
     {
         _method = method;
@@ -22,19 +51,117 @@ struct RestAPIEndpointMsg
         _pMsgHeader = pMsgHeader;
         _pMsgContent = NULL;
         _msgContentLen = 0;
+        _streamPos = 0;
+        _contentPos = 0;
+        _contentTotalLen = 0;
+        _clientIdx = -1;
+        _numParams = 0;
+    }
+    void setParams(const RestAPIParam* pParams, int numParams)
+    {
+        _numParams = (numParams < MAX_PATH_PARAMS) ? numParams : MAX_PATH_PARAMS;
+        memcpy(_params, pParams, _numParams * sizeof(RestAPIParam));
+    }
+    // Get a path parameter by name (NULL if not present)
+    const RestAPIParam* getParam(const char* pName) const
+    {
+        int nameLen = strlen(pName);
+        for (int i = 0; i < _numParams; i++)
+        {
+            if ((_params[i]._nameLen == nameLen) && (strncasecmp(_params[i]._pName, pName, nameLen) == 0))
+            {
+                return &_params[i];
+            }
+        }
+        return NULL;
+    }
+};
+
+// Output for streaming endpoints - a bounded buffer which the server sends as a chunk of
+// the response each time it is filled
+class RestAPIStreamSink
+{
+public:
+    RestAPIStreamSink(uint8_t* pBuf, int maxLen)
+    {
+        _pBuf = pBuf;
+        _maxLen = maxLen;
+        _len = 0;
+    }
+
+    // Space left
+    int spaceLeft()
+    {
+        return _maxLen - _len;
+    }
+
+    // Length written
+    int length()
+    {
+        return _len;
+    }
+
+    // Write data - nothing is written (and false is returned) if there isn't space for all
+    // of it so callers can retry the same data on the next call
+    bool write(const uint8_t* pData, int len)
+    {
+        if (len > _maxLen - _len)
+        {
+            return false;
+        }
+        memcpy(_pBuf + _len, pData, len);
+        _len += len;
+        return true;
+    }
+    bool write(const char* pStr)
+    {
+        return write((const uint8_t*)pStr, strlen(pStr));
     }
+
+private:
+    uint8_t* _pBuf;
+    int _maxLen;
+    int _len;
 };
 
 // Callback function for any endpoint
 //typedef void (*RestAPIEndpointCallbackType)(RestAPIEndpointMsg& restAPIEndpointMsg, String& retStr);
 typedef std::function<void(RestAPIEndpointMsg& restAPIEndpointMsg, String& retStr)> RestAPIEndpointCallbackType;
 
+// Callback function for a streaming endpoint - called repeatedly to fill the sink and
+// returns true while there is more of the response to come
+typedef std::function<bool(RestAPIEndpointMsg& restAPIEndpointMsg, RestAPIStreamSink& sink)> RestAPIEndpointStreamCallbackType;
+
+// Callback function for the body of a request to an upload endpoint - called with each part
+// of the body as it is received (_pMsgContent and _msgContentLen at _contentPos) and returns
+// the number of bytes consumed - any not consumed are passed again on the next call and no
+// more of the body is read until they have been
+typedef std::function<int(RestAPIEndpointMsg& restAPIEndpointMsg)> RestAPIEndpointBodyCallbackType;
+
 // Definition of an endpoint
 class RestAPIEndpointDef
 {
 public:
     static const int ENDPOINT_CALLBACK = 1;
-    RestAPIEndpointDef(const char *pStr, int endpointType, RestAPIEndpointCallbackType callback, const char* pContentType)
+    static const int ENDPOINT_STREAM   = 2;
+    static const int ENDPOINT_UPLOAD   = 3;
+
+    // Methods accepted - a mask with a bit for each RdHttpRequestParser method - endpoints
+    // accepting GET also handle HEAD (the response is sent without its body)
+    static const int METHODS_ANY         = 0;
+    static const int METHOD_MASK_GET     = 1 << RdHttpRequestParser::METHOD_GET;
+    static const int METHOD_MASK_POST    = 1 << RdHttpRequestParser::METHOD_POST;
+    static const int METHOD_MASK_OPTIONS = 1 << RdHttpRequestParser::METHOD_OPTIONS;
+    static const int METHOD_MASK_HEAD    = 1 << RdHttpRequestParser::METHOD_HEAD;
+    static const int METHOD_MASK_PUT     = 1 << RdHttpRequestParser::METHOD_PUT;
+    static const int METHOD_MASK_DELETE  = 1 << RdHttpRequestParser::METHOD_DELETE;
+    static const int METHOD_MASK_PATCH   = 1 << RdHttpRequestParser::METHOD_PATCH;
+    // All recognised methods - requests with other methods (METHOD_OTHER) aren't passed to endpoints
+    static const int METHOD_MASK_ALL     = ((1 << RdHttpRequestParser::NUM_METHODS) - 1) &
+                                           ~(1 << RdHttpRequestParser::METHOD_OTHER);
+
+    RestAPIEndpointDef(const char *pStr, int endpointType, RestAPIEndpointCallbackType callback, const char* pContentType,
+                       int methodMask = METHODS_ANY)
     {
         int stlen = strlen(pStr);
 
@@ -44,6 +171,20 @@ public:
         _callback     = callback;
         _pContentType = new char[strlen(pContentType) + 1];
         strcpy(_pContentType, pContentType);
+        _methodMask      = (methodMask == METHODS_ANY) ? METHOD_MASK_ALL : methodMask;
+        _nextSameNameIdx = -1;
+    };
+    RestAPIEndpointDef(const char *pStr, RestAPIEndpointStreamCallbackType streamCallback, const char* pContentType,
+                       int methodMask = METHODS_ANY)
+        : RestAPIEndpointDef(pStr, ENDPOINT_STREAM, NULL, pContentType, methodMask)
+    {
+        _streamCallback = streamCallback;
+    };
+    RestAPIEndpointDef(const char *pStr, RestAPIEndpointBodyCallbackType bodyCallback, RestAPIEndpointCallbackType callback,
+                       const char* pContentType, int methodMask = METHODS_ANY)
+        : RestAPIEndpointDef(pStr, ENDPOINT_UPLOAD, callback, pContentType, methodMask)
+    {
+        _bodyCallback = bodyCallback;
     };
     ~RestAPIEndpointDef()
     {
@@ -54,6 +195,11 @@ public:
     int   _endpointType;
     char* _pContentType;
     RestAPIEndpointCallbackType _callback;
+    RestAPIEndpointStreamCallbackType _streamCallback;
+    RestAPIEndpointBodyCallbackType _bodyCallback;
+    int   _methodMask;
+    // Next endpoint with the same name (for other methods) or -1
+    int   _nextSameNameIdx;
 };
 
 // Collection of endpoints
@@ -63,9 +209,48 @@ public:
     // Max endpoints we can accommodate
     static const int MAX_WEB_SERVER_ENDPOINTS = 50;
 
+    // Max nodes in the route tree - one for each distinct segment of the pattern endpoints
+    static const int MAX_ROUTE_NODES = 64;
+
+    // Slots in the endpoint hash table - a power of 2 at least twice the max number of
+    // endpoints so probe sequences stay short
+    static const int ENDPOINT_HASH_SLOTS = 128;
+
     RestAPIEndpoints()
     {
         _numEndpoints = 0;
+        for (int i = 0; i < ENDPOINT_HASH_SLOTS; i++)
+        {
+            _slotEndpointIdxs[i] = -1;
+        }
+        // Root of the route tree
+        _routeNodes[0]._pSeg        = NULL;
+        _routeNodes[0]._segLen      = 0;
+        _routeNodes[0]._segType     = ROUTE_SEG_LITERAL;
+        _routeNodes[0]._endpointIdx = -1;
+        _routeNodes[0]._firstChild  = -1;
+        _routeNodes[0]._nextSibling = -1;
+        _numRouteNodes = 1;
+    }
+
+    // Case insensitive FNV-1a hash of an endpoint name - constexpr so a name known at compile
+    // time (e.g. RestAPIEndpoints::hashName("getsettings")) is hashed by the compiler - it
+    // recurses once per character so names only known at run time use hashNameRuntime()
+    static constexpr uint32_t hashName(const char *pStr, uint32_t hash = 2166136261UL)
+    {
+        return (*pStr == 0) ? hash : hashName(pStr + 1, (uint32_t)((hash ^ foldCase(*pStr)) * 16777619UL));
+    }
+
+    // Same hash as hashName() computed with a loop - for names from requests (which may be
+    // long) without using stack for each character
+    static uint32_t hashNameRuntime(const char *pStr)
+    {
+        uint32_t hash = 2166136261UL;
+        for (; *pStr; pStr++)
+        {
+            hash = (uint32_t)((hash ^ foldCase(*pStr)) * 16777619UL);
+        }
+        return hash;
     }
 
     ~RestAPIEndpoints()
@@ -99,8 +284,11 @@ public:
     }
 
 
-    // Add an endpoint
-    void addEndpoint(const char *pEndpointStr, int endpointType, RestAPIEndpointCallbackType callback, const char* pContentType)
+    // Add an endpoint - names containing a / are path patterns with segments which are either
+    // literal, a parameter (e.g. :id) or * (last segment only) which matches the rest of the path
+    // - the same name can be added for different methods (methodMask - default is any method)
+    void addEndpoint(const char *pEndpointStr, int endpointType, RestAPIEndpointCallbackType callback, const char* pContentType,
+                     int methodMask = RestAPIEndpointDef::METHODS_ANY)
     {
         // Check for overflow
         if (_numEndpoints >= MAX_WEB_SERVER_ENDPOINTS)
@@ -109,26 +297,117 @@ public:
         }
 
         // Create new command definition and add
-        RestAPIEndpointDef *pNewEndpointDef = new RestAPIEndpointDef(pEndpointStr, endpointType, callback, pContentType);
+        RestAPIEndpointDef *pNewEndpointDef = new RestAPIEndpointDef(pEndpointStr, endpointType, callback, pContentType, methodMask);
+        addToTable(pNewEndpointDef);
+    }
 
-        _pEndpoints[_numEndpoints] = pNewEndpointDef;
-        _numEndpoints++;
+
+    // Add a streaming endpoint - the response is sent with chunked transfer-encoding as
+    // the callback produces it
+    void addStreamingEndpoint(const char *pEndpointStr, RestAPIEndpointStreamCallbackType streamCallback, const char* pContentType,
+                              int methodMask = RestAPIEndpointDef::METHODS_ANY)
+    {
+        // Check for overflow
+        if (_numEndpoints >= MAX_WEB_SERVER_ENDPOINTS)
+        {
+            return;
+        }
+
+        // Create new command definition and add
+        RestAPIEndpointDef *pNewEndpointDef = new RestAPIEndpointDef(pEndpointStr, streamCallback, pContentType, methodMask);
+        addToTable(pNewEndpointDef);
+    }
+
+
+    // Add an upload endpoint - the request body is passed to the body callback as it is
+    // received (so it isn't limited by the receive buffer size) and the callback is then
+    // called to form the response
+    void addUploadEndpoint(const char *pEndpointStr, RestAPIEndpointBodyCallbackType bodyCallback,
+                           RestAPIEndpointCallbackType callback, const char* pContentType,
+                           int methodMask = RestAPIEndpointDef::METHODS_ANY)
+    {
+        // Check for overflow
+        if (_numEndpoints >= MAX_WEB_SERVER_ENDPOINTS)
+        {
+            return;
+        }
+
+        // Create new command definition and add
+        RestAPIEndpointDef *pNewEndpointDef = new RestAPIEndpointDef(pEndpointStr, bodyCallback, callback, pContentType, methodMask);
+        addToTable(pNewEndpointDef);
     }
 
 
-    // Get the endpoint definition corresponding to a requested endpoint
+    // Get the endpoint definition corresponding to a requested endpoint (case insensitive) -
+    // the first added with the name whatever its methods
     RestAPIEndpointDef *getEndpoint(const char *pEndpointStr)
     {
-        // Look for the command in the registered callbacks
-        for (int endpointIdx = 0; endpointIdx < _numEndpoints; endpointIdx++)
+        int endpointIdx = findEndpointIdx(pEndpointStr, hashNameRuntime(pEndpointStr));
+        return (endpointIdx >= 0) ? _pEndpoints[endpointIdx] : NULL;
+    }
+
+    // Get the endpoint definition with the name's hash already computed - the name is only
+    // compared with endpoints whose hash matches (normally just one)
+    RestAPIEndpointDef *getEndpoint(const char *pEndpointStr, uint32_t hash)
+    {
+        int endpointIdx = findEndpointIdx(pEndpointStr, hash);
+        return (endpointIdx >= 0) ? _pEndpoints[endpointIdx] : NULL;
+    }
+
+    // Get the endpoint definition for a name and method - allowMask is set to the methods
+    // accepted by endpoints with the name (0 if there are none) so, if NULL is returned
+    // with allowMask set, the name was found but the method isn't allowed
+    RestAPIEndpointDef *getEndpoint(const char *pEndpointStr, int method, int& allowMask)
+    {
+        return selectForMethod(findEndpointIdx(pEndpointStr, hashNameRuntime(pEndpointStr)), method, allowMask);
+    }
+
+
+    // Find the pattern endpoint matching a request path - literal segments are matched
+    // before parameters and parameters before * - the values of parameters are views into
+    // the path (not decoded)
+    // The endpoint is chosen for the method as with getEndpoint()
+    RestAPIEndpointDef *matchRoute(const char *pPath, int pathLen, int method, RestAPIParam *pParams, int& numParams,
+                                   int& allowMask)
+    {
+        numParams = 0;
+        allowMask = 0;
+        if (_numRouteNodes <= 1)
         {
-            RestAPIEndpointDef *pEndpoint = _pEndpoints[endpointIdx];
-            if (strcasecmp(pEndpoint->_pEndpointStr, pEndpointStr) == 0)
+            return NULL;
+        }
+        // Ignore leading and trailing slashes
+        if ((pathLen > 0) && (*pPath == '/'))
+        {
+            pPath++;
+            pathLen--;
+        }
+        if ((pathLen > 0) && (pPath[pathLen - 1] == '/'))
+        {
+            pathLen--;
+        }
+        int endpointIdx = matchRouteNode(0, (pathLen > 0) ? pPath : NULL, pPath + pathLen, pParams, numParams);
+        RestAPIEndpointDef *pEndpoint = selectForMethod(endpointIdx, method, allowMask);
+        if (!pEndpoint)
+        {
+            numParams = 0;
+            return NULL;
+        }
+        // Parameter names come from the pattern
+        int        paramIdx = 0;
+        const char *pSeg    = pEndpoint->_pEndpointStr;
+        while (*pSeg && (paramIdx < numParams))
+        {
+            int segLen = strcspn(pSeg, "/");
+            if ((*pSeg == ':') || (*pSeg == '*'))
             {
-                return pEndpoint;
+                pParams[paramIdx]._pName   = (*pSeg == ':') ? pSeg + 1 : pSeg;
+                pParams[paramIdx]._nameLen = (*pSeg == ':') ? segLen - 1 : segLen;
+                paramIdx++;
             }
+            pSeg += (pSeg[segLen] == '/') ? segLen + 1 : segLen;
         }
-        return NULL;
+        return pEndpoint;
     }
 
 
@@ -136,9 +415,9 @@ public:
     void handleApiRequest(const char *requestStr, String& retStr)
     {
         // Get the command
-        static char *emptyStr       = (char *)"";
+        static const char *emptyStr = "";
         String      requestEndpoint = getNthArgStr(requestStr, 0).toUpperCase();
-        char        *argStart       = strstr(requestStr, "/");
+        const char  *argStart       = strstr(requestStr, "/");
         retStr = "";
 
         if (argStart == NULL)
@@ -149,27 +428,39 @@ public:
         {
             argStart++;
         }
-        Log.trace("Endpoint: %s", requestStr);
+        RDWS_LOG_TRACE("Endpoint: %s", requestStr);
         // Check against valid commands
-        int numEndpoints = getNumEndpoints();
-        for (int i = 0; i < numEndpoints; i++)
+        RestAPIEndpointDef *pEndpoint = getEndpoint(requestEndpoint.c_str());
+        if (pEndpoint && (pEndpoint->_endpointType == RestAPIEndpointDef::ENDPOINT_CALLBACK))
         {
-            RestAPIEndpointCallbackType callback;
-            int  endpointType;
-            char *pEndpointStr = getNthEndpointStr(i, endpointType, callback);
-            if (!pEndpointStr)
-            {
-                continue;
-            }
-            if (endpointType != RestAPIEndpointDef::ENDPOINT_CALLBACK)
-            {
-                continue;
-            }
-            if (requestEndpoint.equalsIgnoreCase(pEndpointStr))
-            {
-                RestAPIEndpointMsg endpointMsg(0, NULL, argStart, NULL);
-                callback(endpointMsg, retStr);
-            }
+            RestAPIEndpointMsg endpointMsg(0, NULL, argStart, NULL);
+            pEndpoint->_callback(endpointMsg, retStr);
+        }
+    }
+
+
+    // Decode %XX escapes (and + as a space if plusAsSpace) in place in a single pass - returns
+    // the decoded length - a % not followed by two hex digits is left as it is
+    static int urlDecodeInPlace(char *pBuf, int len, bool plusAsSpace)
+    {
+        int outPos = 0;
+        for (int inPos = 0; inPos < len; )
+        {
+            pBuf[outPos++] = decodeChar(pBuf, len, inPos, plusAsSpace);
+        }
+        return outPos;
+    }
+
+
+    // Form a string from a char buffer with a fixed length decoding %XX escapes (and + as a
+    // space if plusAsSpace)
+    static void formDecodedStringFromCharBuf(String& outStr, const char *pStr, int len, bool plusAsSpace)
+    {
+        outStr = "";
+        outStr.reserve(len + 1);
+        for (int pos = 0; pos < len; )
+        {
+            outStr.concat(decodeChar(pStr, len, pos, plusAsSpace));
         }
     }
 
@@ -194,11 +485,11 @@ public:
         String     oStr;
         const char *pStr = getArgPtrAndLen(argStr, argIdx, argLen);
 
+        // Not decoded here as the args were decoded when the request was received
         if (pStr)
         {
             formStringFromCharBuf(oStr, pStr, argLen);
         }
-        oStr = unencodeHTTPChars(oStr);
         return oStr;
     }
 
@@ -261,39 +552,9 @@ public:
     // Convert encoded URL
     static String unencodeHTTPChars(String& inStr)
     {
-        inStr.replace("+", " ");
-        inStr.replace("%20", " ");
-        inStr.replace("%21", "!");
-        inStr.replace("%22", "\"");
-        inStr.replace("%23", "#");
-        inStr.replace("%24", "$");
-        inStr.replace("%25", "%");
-        inStr.replace("%26", "&");
-        inStr.replace("%27", "^");
-        inStr.replace("%28", "(");
-        inStr.replace("%29", ")");
-        inStr.replace("%2A", "*");
-        inStr.replace("%2B", "+");
-        inStr.replace("%2C", ",");
-        inStr.replace("%2D", "-");
-        inStr.replace("%2E", ".");
-        inStr.replace("%2F", "/");
-        inStr.replace("%3A", ":");
-        inStr.replace("%3B", ";");
-        inStr.replace("%3C", "<");
-        inStr.replace("%3D", "=");
-        inStr.replace("%3E", ">");
-        inStr.replace("%3F", "?");
-        inStr.replace("%5B", "[");
-        inStr.replace("%5C", "\\");
-        inStr.replace("%5D", "]");
-        inStr.replace("%5E", "^");
-        inStr.replace("%5F", "_");
-        inStr.replace("%60", "`");
-        inStr.replace("%7B", "{");
-        inStr.replace("%7C", "|");
-        inStr.replace("%7D", "}");
-        inStr.replace("%7E", "~");
+        String outStr;
+        formDecodedStringFromCharBuf(outStr, inStr.c_str(), inStr.length(), true);
+        inStr = outStr;
         return inStr;
     }
 
@@ -302,4 +563,328 @@ private:
     // Endpoint list
     RestAPIEndpointDef *_pEndpoints[MAX_WEB_SERVER_ENDPOINTS];
     int                _numEndpoints;
+
+    // Hash table of endpoints (open addressing with linear probing) - each slot holds the
+    // hash of the name and the index of the endpoint (or -1 if empty) so probing doesn't
+    // touch the endpoint definitions
+    uint32_t _slotHashes[ENDPOINT_HASH_SLOTS];
+    int8_t   _slotEndpointIdxs[ENDPOINT_HASH_SLOTS];
+
+    // Route tree - a node for each path segment with its children in a list ordered literal
+    // segments first, then a parameter and then *
+    static const int ROUTE_SEG_LITERAL  = 0;
+    static const int ROUTE_SEG_PARAM    = 1;
+    static const int ROUTE_SEG_WILDCARD = 2;
+    struct RouteNode
+    {
+        const char *_pSeg;
+        int16_t    _segLen;
+        int8_t     _segType;
+        int8_t     _endpointIdx;
+        int16_t    _firstChild;
+        int16_t    _nextSibling;
+    };
+    RouteNode _routeNodes[MAX_ROUTE_NODES];
+    int       _numRouteNodes;
+
+    // Decode the character at pos (advancing pos past it)
+    static char decodeChar(const char *pBuf, int len, int& pos, bool plusAsSpace)
+    {
+        char ch = pBuf[pos++];
+        if ((ch == '%') && (pos + 1 < len))
+        {
+            int hi = hexDigitVal(pBuf[pos]);
+            int lo = hexDigitVal(pBuf[pos + 1]);
+            if ((hi >= 0) && (lo >= 0))
+            {
+                pos += 2;
+                return (char)((hi << 4) | lo);
+            }
+        }
+        else if ((ch == '+') && plusAsSpace)
+        {
+            return ' ';
+        }
+        return ch;
+    }
+
+    static int hexDigitVal(char ch)
+    {
+        if ((ch >= '0') && (ch <= '9'))
+            return ch - '0';
+        if ((ch >= 'a') && (ch <= 'f'))
+            return ch - 'a' + 10;
+        if ((ch >= 'A') && (ch <= 'F'))
+            return ch - 'A' + 10;
+        return -1;
+    }
+
+    static constexpr uint8_t foldCase(char ch)
+    {
+        return ((ch >= 'A') && (ch <= 'Z')) ? (uint8_t)(ch + 'a' - 'A') : (uint8_t)ch;
+    }
+
+    // Index of the first endpoint with a name (not a pattern) or -1
+    int findEndpointIdx(const char *pEndpointStr, uint32_t hash)
+    {
+        for (int slotIdx = hash & (ENDPOINT_HASH_SLOTS - 1); _slotEndpointIdxs[slotIdx] >= 0;
+                    slotIdx = (slotIdx + 1) & (ENDPOINT_HASH_SLOTS - 1))
+        {
+            if (_slotHashes[slotIdx] != hash)
+            {
+                continue;
+            }
+            int endpointIdx = _slotEndpointIdxs[slotIdx];
+            if (strcasecmp(_pEndpoints[endpointIdx]->_pEndpointStr, pEndpointStr) == 0)
+            {
+                return endpointIdx;
+            }
+        }
+        return -1;
+    }
+
+    // Choose the endpoint for a method from those with the same name (starting at endpointIdx)
+    // - one added for HEAD is used in preference to one for GET
+    RestAPIEndpointDef *selectForMethod(int endpointIdx, int method, int& allowMask)
+    {
+        RestAPIEndpointDef *pForMethod = NULL;
+        RestAPIEndpointDef *pForGet    = NULL;
+        allowMask = 0;
+        for (; endpointIdx >= 0; endpointIdx = _pEndpoints[endpointIdx]->_nextSameNameIdx)
+        {
+            RestAPIEndpointDef *pEndpoint = _pEndpoints[endpointIdx];
+            allowMask |= pEndpoint->_methodMask;
+            if (!pForMethod && (pEndpoint->_methodMask & (1 << method)))
+            {
+                pForMethod = pEndpoint;
+            }
+            if (!pForGet && (pEndpoint->_methodMask & RestAPIEndpointDef::METHOD_MASK_GET))
+            {
+                pForGet = pEndpoint;
+            }
+        }
+        if (pForGet)
+        {
+            allowMask |= RestAPIEndpointDef::METHOD_MASK_HEAD;
+        }
+        if (!pForMethod && (method == RdHttpRequestParser::METHOD_HEAD))
+        {
+            return pForGet;
+        }
+        return pForMethod;
+    }
+
+    // Add an endpoint to the list and hash table (or route tree) - endpoints with the same
+    // name are linked so they are found by one lookup - if they have a method in common the
+    // one added first is kept
+    void addToTable(RestAPIEndpointDef *pEndpointDef)
+    {
+        int      routeNodeIdx = -1;
+        uint32_t hash         = 0;
+        int      firstIdx     = -1;
+        if (strchr(pEndpointDef->_pEndpointStr, '/'))
+        {
+            routeNodeIdx = addRoute(pEndpointDef->_pEndpointStr);
+            if (routeNodeIdx < 0)
+            {
+                delete pEndpointDef;
+                return;
+            }
+            firstIdx = _routeNodes[routeNodeIdx]._endpointIdx;
+        }
+        else
+        {
+            hash     = hashNameRuntime(pEndpointDef->_pEndpointStr);
+            firstIdx = findEndpointIdx(pEndpointDef->_pEndpointStr, hash);
+        }
+
+        // Link to the end of the endpoints with the same name
+        int lastIdx = -1;
+        for (int endpointIdx = firstIdx; endpointIdx >= 0; endpointIdx = _pEndpoints[endpointIdx]->_nextSameNameIdx)
+        {
+            if (_pEndpoints[endpointIdx]->_methodMask & pEndpointDef->_methodMask)
+            {
+                delete pEndpointDef;
+                return;
+            }
+            lastIdx = endpointIdx;
+        }
+        if (lastIdx >= 0)
+        {
+            _pEndpoints[lastIdx]->_nextSameNameIdx = _numEndpoints;
+        }
+        else if (routeNodeIdx >= 0)
+        {
+            _routeNodes[routeNodeIdx]._endpointIdx = _numEndpoints;
+        }
+        else
+        {
+            int slotIdx = hash & (ENDPOINT_HASH_SLOTS - 1);
+            while (_slotEndpointIdxs[slotIdx] >= 0)
+            {
+                slotIdx = (slotIdx + 1) & (ENDPOINT_HASH_SLOTS - 1);
+            }
+            _slotHashes[slotIdx]       = hash;
+            _slotEndpointIdxs[slotIdx] = _numEndpoints;
+        }
+        _pEndpoints[_numEndpoints] = pEndpointDef;
+        _numEndpoints++;
+    }
+
+    // Add a pattern to the route tree - returns the index of its node or -1 if the pattern
+    // is invalid or there are too many nodes - in that case any nodes added for it are removed
+    // (they point into the pattern which is deleted)
+    int addRoute(const char *pPattern)
+    {
+        int firstNewIdx = _numRouteNodes;
+        int nodeIdx     = addRouteNodes(pPattern);
+        if (nodeIdx < 0)
+        {
+            removeRouteNodes(firstNewIdx);
+        }
+        return nodeIdx;
+    }
+
+    // Add the nodes for a pattern's segments
+    int addRouteNodes(const char *pPattern)
+    {
+        int        nodeIdx   = 0;
+        int        numParams = 0;
+        const char *pSeg     = (*pPattern == '/') ? pPattern + 1 : pPattern;
+        while (*pSeg)
+        {
+            int segLen  = strcspn(pSeg, "/");
+            int segType = ROUTE_SEG_LITERAL;
+            if (*pSeg == ':')
+            {
+                segType = ROUTE_SEG_PARAM;
+            }
+            else if ((segLen == 1) && (*pSeg == '*'))
+            {
+                // Must be the last segment
+                if (pSeg[segLen] != '\0')
+                {
+                    return -1;
+                }
+                segType = ROUTE_SEG_WILDCARD;
+            }
+            if ((segType != ROUTE_SEG_LITERAL) && (++numParams > RestAPIEndpointMsg::MAX_PATH_PARAMS))
+            {
+                return -1;
+            }
+            nodeIdx = getRouteChild(nodeIdx, pSeg, segLen, segType);
+            if (nodeIdx < 0)
+            {
+                return -1;
+            }
+            pSeg += (pSeg[segLen] == '/') ? segLen + 1 : segLen;
+        }
+        return (nodeIdx == 0) ? -1 : nodeIdx;
+    }
+
+    // Remove the nodes from firstNewIdx on - they were added last so only their parent's or
+    // previous sibling's link into them has to be undone
+    void removeRouteNodes(int firstNewIdx)
+    {
+        for (int nodeIdx = 0; nodeIdx < firstNewIdx; nodeIdx++)
+        {
+            RouteNode& node = _routeNodes[nodeIdx];
+            if (node._firstChild >= firstNewIdx)
+            {
+                node._firstChild = _routeNodes[node._firstChild]._nextSibling;
+            }
+            if (node._nextSibling >= firstNewIdx)
+            {
+                node._nextSibling = _routeNodes[node._nextSibling]._nextSibling;
+            }
+        }
+        _numRouteNodes = firstNewIdx;
+    }
+
+    // Get the child of a node for a segment - adding it (in order of segment type) if there
+    // isn't one - parameters share a node whatever their name
+    int getRouteChild(int nodeIdx, const char *pSeg, int segLen, int segType)
+    {
+        int prevIdx  = -1;
+        int childIdx = _routeNodes[nodeIdx]._firstChild;
+        while ((childIdx >= 0) && (_routeNodes[childIdx]._segType <= segType))
+        {
+            RouteNode& child = _routeNodes[childIdx];
+            if ((child._segType == segType) && ((segType != ROUTE_SEG_LITERAL) ||
+                        ((child._segLen == segLen) && (strncasecmp(child._pSeg, pSeg, segLen) == 0))))
+            {
+                return childIdx;
+            }
+            prevIdx  = childIdx;
+            childIdx = child._nextSibling;
+        }
+        if (_numRouteNodes >= MAX_ROUTE_NODES)
+        {
+            return -1;
+        }
+        int       newIdx   = _numRouteNodes++;
+        RouteNode& newNode = _routeNodes[newIdx];
+        newNode._pSeg        = pSeg;
+        newNode._segLen      = segLen;
+        newNode._segType     = segType;
+        newNode._endpointIdx = -1;
+        newNode._firstChild  = -1;
+        newNode._nextSibling = childIdx;
+        if (prevIdx < 0)
+        {
+            _routeNodes[nodeIdx]._firstChild = newIdx;
+        }
+        else
+        {
+            _routeNodes[prevIdx]._nextSibling = newIdx;
+        }
+        return newIdx;
+    }
+
+    // Match the rest of a path (pSeg is NULL when the whole path has been matched) against
+    // the children of a node - returns the endpoint index or -1
+    int matchRouteNode(int nodeIdx, const char *pSeg, const char *pPathEnd, RestAPIParam *pParams, int& numParams)
+    {
+        if (pSeg == NULL)
+        {
+            return _routeNodes[nodeIdx]._endpointIdx;
+        }
+        const char *pSegEnd = (const char *)memchr(pSeg, '/', pPathEnd - pSeg);
+        if (pSegEnd == NULL)
+        {
+            pSegEnd = pPathEnd;
+        }
+        int        segLen = pSegEnd - pSeg;
+        const char *pNext = (pSegEnd < pPathEnd) ? pSegEnd + 1 : NULL;
+        for (int childIdx = _routeNodes[nodeIdx]._firstChild; childIdx >= 0; childIdx = _routeNodes[childIdx]._nextSibling)
+        {
+            RouteNode& child = _routeNodes[childIdx];
+            int endpointIdx = -1;
+            if (child._segType == ROUTE_SEG_LITERAL)
+            {
+                if ((child._segLen == segLen) && (strncasecmp(child._pSeg, pSeg, segLen) == 0))
+                {
+                    endpointIdx = matchRouteNode(childIdx, pNext, pPathEnd, pParams, numParams);
+                }
+            }
+            else if ((segLen > 0) && (numParams < RestAPIEndpointMsg::MAX_PATH_PARAMS))
+            {
+                // Parameter is this segment and * is the rest of the path
+                pParams[numParams]._pValue   = pSeg;
+                pParams[numParams]._valueLen = (child._segType == ROUTE_SEG_PARAM) ? segLen : pPathEnd - pSeg;
+                numParams++;
+                endpointIdx = (child._segType == ROUTE_SEG_PARAM) ?
+                            matchRouteNode(childIdx, pNext, pPathEnd, pParams, numParams) : child._endpointIdx;
+                if (endpointIdx < 0)
+                {
+                    numParams--;
+                }
+            }
+            if (endpointIdx >= 0)
+            {
+                return endpointIdx;
+            }
+        }
+        return -1;
+    }
 };
@@ -24,6 +24,42 @@ static const uint8_t reso_favicon_ico[] {
     0x00,0x00,0xc1,0xf9,0x00,0x00,0xe3,0xf9,0x00,0x00,0xff,0xff,0x00,0x00
     };
 
+static const char reso_favicon_ico_hdr[] = "HTTP/1.1 200 OK\r\n"
+    "Content-Type: image/ico\r\n"
+    "Content-Length: 318\r\n";
+
+static const char reso_favicon_ico_etag[] = "\"bea1035bc1371897\"";
+static const char reso_favicon_ico_cache_hdr[] = "ETag: \"bea1035bc1371897\"\r\n"
+    "Vary: Accept-Encoding\r\n"
+    "Cache-Control: no-cache\r\n";
+
+static const uint8_t reso_favicon_ico_gzip[] {
+    0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xad,0x8e,0xb1,0x0d,0xc2,0x40,
+    0x0c,0x45,0x9f,0x25,0x06,0xb0,0x1b,0x24,0x3a,0xca,0xac,0xc0,0x76,0x89,0x0e,0x89,
+    0x3a,0x5d,0x0a,0x96,0xc9,0x2c,0x4c,0x91,0x2a,0x7c,0x9f,0x89,0x60,0x00,0x7c,0x7a,
+    0xfe,0xa7,0xff,0xed,0xd3,0x81,0xe9,0xb8,0xbb,0xfa,0x89,0xc1,0xe0,0x0c,0x0c,0xc2,
+    0xc5,0x55,0xa4,0x9f,0x35,0xf2,0x2d,0xff,0xb9,0xef,0x77,0xfe,0x56,0xe6,0x84,0x45,
+    0x48,0x2d,0xd5,0xcd,0xc3,0xb3,0xa7,0x57,0xae,0x7f,0x34,0x7b,0x78,0x9f,0x89,0x9a,
+    0xa0,0xab,0xe2,0xcc,0x0f,0x8d,0x88,0x7a,0x55,0x8b,0xa9,0x1a,0xeb,0x7a,0xfc,0x7d,
+    0x2f,0x9e,0x0d,0x96,0x09,0xe6,0x0b,0xb4,0x1b,0x3c,0x44,0x9b,0x61,0x92,0xb7,0xac,
+    0xca,0xb7,0x62,0x14,0xab,0x78,0x6d,0xb5,0xf7,0x06,0x60,0x31,0x9a,0x77,0x3e,0x01,
+    0x00,0x00
+    };
+
+static const char reso_favicon_ico_gzip_hdr[] = "HTTP/1.1 200 OK\r\n"
+    "Content-Type: image/ico\r\n"
+    "Content-Encoding: gzip\r\n"
+    "Content-Length: 146\r\n";
+
+static const char reso_favicon_ico_gzip_etag[] = "\"57eeda11f4aed3d1\"";
+static const char reso_favicon_ico_gzip_cache_hdr[] = "ETag: \"57eeda11f4aed3d1\"\r\n"
+    "Vary: Accept-Encoding\r\n"
+    "Cache-Control: no-cache\r\n";
+
+static const RdWebServerResourceVariant reso_favicon_ico_variants[] = {
+    RdWebServerResourceVariant("gzip", reso_favicon_ico_gzip, sizeof(reso_favicon_ico_gzip), reso_favicon_ico_gzip_hdr, sizeof(reso_favicon_ico_gzip_hdr) - 1, reso_favicon_ico_gzip_cache_hdr, sizeof(reso_favicon_ico_gzip_cache_hdr) - 1, reso_favicon_ico_gzip_etag)
+    };
+
 static const uint8_t reso_index_html[] {
     0x3c,0x21,0x44,0x4f,0x43,0x54,0x59,0x50,0x45,0x20,0x68,0x74,0x6d,0x6c,0x3e,0x0a,
     0x3c,0x68,0x74,0x6d,0x6c,0x3e,0x0a,0x3c,0x68,0x65,0x61,0x64,0x3e,0x0a,0x20,0x20,
@@ -361,6 +397,98 @@ static const uint8_t reso_index_html[] {
     0x6f,0x64,0x79,0x3e,0x0a,0x3c,0x2f,0x68,0x74,0x6d,0x6c,0x3e,0x0a
     };
 
+static const char reso_index_html_hdr[] = "HTTP/1.1 200 OK\r\n"
+    "Content-Type: text/html\r\n"
+    "Content-Length: 5341\r\n";
+
+static const char reso_index_html_etag[] = "\"941ff02bb57626d5\"";
+static const char reso_index_html_cache_hdr[] = "ETag: \"941ff02bb57626d5\"\r\n"
+    "Vary: Accept-Encoding\r\n"
+    "Cache-Control: no-cache\r\n";
+
+static const uint8_t reso_index_html_gzip[] {
+    0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xed,0x58,0xcf,0x8f,0xe2,0x36,
+    0x14,0x3e,0x33,0x7f,0x85,0x27,0x17,0x40,0xa5,0xe1,0x0e,0x81,0xc3,0x6e,0x51,0xbb,
+    0xd5,0x6a,0x67,0x34,0x20,0x6d,0x7b,0x34,0xf8,0x01,0xd9,0x31,0x36,0xb2,0x0d,0x0b,
+    0xaa,0xf8,0xdf,0x6b,0x27,0x78,0x63,0x27,0x4e,0x32,0xc3,0xcc,0x1e,0x2a,0x35,0x07,
+    0xb0,0x9d,0xef,0x7d,0x79,0x7e,0xbf,0xfc,0x92,0xe4,0xfe,0xb7,0x87,0x8f,0x8b,0xbf,
+    0x1f,0x67,0x68,0xab,0x76,0x74,0x7a,0x97,0xd8,0x3f,0xc0,0x64,0x7a,0x87,0xf4,0x95,
+    0xa8,0x54,0x51,0x98,0x7e,0xe2,0x8b,0x0f,0xfc,0x94,0x0c,0xf3,0xd9,0x5d,0x32,0xcc,
+    0x11,0xc9,0x92,0x93,0xf3,0xf4,0x0f,0xa0,0x94,0xa3,0xb5,0xe0,0x3b,0xf4,0x44,0xbe,
+    0xc2,0x72,0x0e,0xe2,0x08,0x22,0x17,0x27,0xe9,0x11,0xa5,0x64,0x12,0x49,0x58,0xa9,
+    0x94,0xb3,0xcf,0x7c,0x93,0xb2,0x28,0xa7,0xb6,0xf7,0x8b,0x59,0xb6,0x42,0xf1,0x12,
+    0xe8,0xf4,0x11,0x4b,0xf9,0x9d,0x0b,0x92,0x0c,0xf3,0xb9,0x8f,0x49,0xd9,0xfe,0xa0,
+    0x90,0x3a,0xef,0x61,0x12,0x29,0x38,0xa9,0x08,0x1d,0x31,0x3d,0x64,0x13,0xa9,0x27,
+    0x0c,0xef,0xf4,0x98,0xef,0x81,0x2d,0xd2,0x1d,0x44,0x99,0x02,0xea,0xa4,0x2c,0xa7,
+    0xfb,0xfc,0xa1,0xa7,0x40,0x40,0x9d,0xe5,0x41,0x29,0xce,0x32,0x8a,0xa5,0xb2,0xfa,
+    0x67,0x7f,0xc9,0x30,0xbf,0x17,0x64,0x73,0x87,0x5b,0x31,0x0d,0x1a,0x63,0x0e,0x4a,
+    0xa5,0x6c,0x23,0x23,0x24,0xd5,0x99,0x6a,0x8d,0x49,0x2a,0xf7,0x14,0x9f,0x47,0x8c,
+    0x33,0x18,0x37,0x5b,0xa9,0xb2,0xe2,0xd8,0xee,0x81,0x12,0xd4,0x68,0xbf,0x66,0x1b,
+    0xd6,0xda,0x4f,0xf3,0x06,0x4c,0x18,0x30,0x63,0xab,0x86,0x5f,0xe0,0xfb,0x4f,0xd1,
+    0x50,0xf3,0xbe,0x59,0x43,0xdf,0xe1,0x1f,0xb7,0x98,0x6d,0xa0,0x20,0xcd,0xe7,0x8e,
+    0xf2,0xe5,0x18,0x08,0x45,0x55,0x69,0x6a,0xe3,0xe1,0x16,0xd7,0xea,0x1d,0x23,0xb3,
+    0xe5,0x77,0xf5,0xab,0x5d,0x78,0x9b,0x53,0x9f,0x60,0x97,0x32,0x02,0xe2,0xad,0xfa,
+    0x89,0x2b,0x8f,0xa7,0xe3,0x93,0xbb,0xf8,0x3e,0xae,0x9d,0xe3,0xa3,0xa6,0x32,0xbf,
+    0x61,0x2f,0x06,0xd3,0x1f,0x13,0x93,0xfd,0xf8,0xd5,0x8e,0xbf,0x0e,0xf3,0xb1,0x5c,
+    0x89,0x74,0xaf,0x90,0x14,0xab,0x49,0x74,0xda,0x8a,0xf8,0x9b,0x8c,0xa6,0xc9,0x30,
+    0x5f,0x9d,0xba,0x90,0x82,0xea,0x88,0x05,0x72,0x6b,0x28,0x9a,0x20,0xc2,0x57,0x87,
+    0x1d,0x30,0x15,0x6f,0x40,0xcd,0x28,0x98,0xe1,0x87,0xf3,0x27,0xd2,0xeb,0xba,0xb8,
+    0x6e,0x7f,0x1c,0xe2,0xb0,0xa5,0xe7,0x05,0x34,0x16,0x5a,0x66,0xb2,0xd5,0xb0,0x89,
+    0xc2,0x62,0x02,0xb2,0xc6,0xee,0x2d,0xa2,0x06,0x12,0x7c,0x2a,0x26,0xad,0x0f,0xc5,
+    0x24,0x20,0xe9,0x27,0x73,0x0b,0x87,0x0f,0x2e,0xb3,0x39,0xc7,0x49,0x13,0x8f,0x03,
+    0x0b,0x30,0x38,0x05,0xb5,0x85,0xc4,0x41,0x06,0x78,0x9c,0xb2,0xd7,0xc2,0xe3,0x20,
+    0x43,0xfa,0x5c,0x0b,0x41,0x9b,0x32,0x57,0x58,0x80,0xc1,0x4d,0xd3,0x16,0x16,0x17,
+    0x6a,0x98,0x7c,0x2a,0xfe,0x0c,0x26,0xb2,0xa2,0xc8,0xb9,0x61,0xa3,0x29,0xc6,0x84,
+    0xcc,0x8e,0x9a,0xeb,0x73,0x2a,0x15,0x30,0x10,0xbd,0xee,0x8a,0xa6,0xab,0xe7,0xee,
+    0x00,0xad,0x0f,0x2c,0x0b,0xda,0x1e,0x1c,0xfb,0xe8,0x1f,0x2f,0x37,0x0d,0xed,0xbe,
+    0xb0,0x92,0xe3,0x99,0x38,0x2b,0x40,0x63,0x0f,0x9d,0xae,0x51,0xaf,0x40,0x1b,0x45,
+    0xca,0x7c,0xe6,0xc2,0x14,0x84,0xea,0x75,0x67,0x4c,0xe9,0xb2,0x87,0x0b,0xfa,0x75,
+    0x2a,0xa4,0x72,0xcd,0x63,0x2f,0x01,0xea,0x20,0x98,0xbf,0x7e,0xb9,0xf3,0xa6,0xf8,
+    0x1b,0x3e,0xf5,0xfc,0x47,0x75,0xa2,0x83,0xa0,0xd1,0x08,0x45,0x7b,0x2e,0x55,0xde,
+    0x82,0x0c,0x4a,0x80,0x1d,0xa8,0x2d,0x27,0x06,0xf3,0xf8,0x30,0x5f,0x54,0x6e,0x13,
+    0xac,0xb0,0xbe,0xf9,0xe7,0xfc,0xe1,0x4b,0x2c,0x95,0xd0,0xf9,0x9c,0xae,0xcf,0xbd,
+    0xea,0x86,0xcc,0x15,0xd9,0x6d,0x68,0x01,0x3b,0xf4,0xe9,0x2e,0xfd,0x41,0x45,0x32,
+    0x32,0x1d,0x21,0x08,0xa9,0x85,0x6a,0x68,0xff,0xfa,0x75,0x61,0xbc,0xaa,0x01,0x99,
+    0x77,0x2b,0xa0,0x8b,0x6f,0x15,0xd7,0x99,0x42,0x70,0x31,0x40,0xa6,0xd9,0x1c,0x68,
+    0x13,0xca,0x3d,0x67,0x12,0xca,0xfe,0xe8,0x18,0x97,0xdd,0x67,0xd0,0x7e,0x8d,0x0a,
+    0x2b,0x2d,0xc7,0x29,0xc4,0x94,0x6f,0x7a,0x86,0x2c,0xe0,0x20,0x1b,0x29,0xc6,0x60,
+    0x3a,0x4a,0x32,0x83,0xed,0xb1,0x90,0xd0,0x24,0x60,0x9e,0x6c,0x04,0xe2,0x3c,0x6c,
+    0xef,0x27,0xe8,0xa0,0x23,0x7b,0x9d,0x32,0x20,0x75,0xaa,0x98,0xcb,0x06,0x79,0x21,
+    0x3a,0xae,0xc5,0xba,0xaa,0x77,0x73,0x41,0xa9,0xcb,0x23,0x19,0xa1,0x2e,0xfa,0x25,
+    0x67,0xea,0xd7,0x4b,0xbb,0x27,0x42,0x9c,0x35,0x9b,0xf1,0xb5,0xd7,0x34,0x39,0x66,
+    0xda,0xcd,0xa8,0x55,0xd8,0x9e,0x03,0x55,0xf9,0x25,0xe5,0xab,0xe7,0x1a,0x82,0x0b,
+    0x02,0x2a,0xa1,0xc1,0x08,0xde,0xc6,0x18,0xbf,0x1a,0x65,0xcd,0xb5,0x05,0xbb,0x35,
+    0x3b,0xba,0x94,0xa2,0xb1,0xe9,0x11,0x1e,0x7d,0x16,0x1c,0x75,0xac,0x2e,0x32,0x8f,
+    0xa2,0x71,0x5b,0x88,0x3a,0x08,0x13,0xae,0x58,0xab,0xd1,0x2f,0xd7,0x2b,0x4c,0x6e,
+    0x2b,0x57,0x59,0x19,0xa8,0x28,0x50,0x93,0x5a,0xd7,0xf2,0xa0,0xab,0xec,0x8f,0x77,
+    0x8a,0x41,0x18,0x59,0xd4,0x89,0xdf,0x67,0x8b,0x3a,0x50,0x5b,0x2a,0xbf,0x28,0x9d,
+    0xab,0xf6,0xca,0xed,0x54,0x59,0xaa,0x4d,0xf3,0xba,0xdc,0x69,0x4f,0xf4,0x9b,0xb2,
+    0x38,0x4b,0xc9,0xe2,0x74,0xcb,0x4f,0x05,0x9b,0x9e,0xb6,0x69,0x6e,0x14,0x75,0x8f,
+    0x34,0x5f,0xdc,0xed,0x69,0xc7,0x2f,0x35,0x95,0xb7,0xd2,0x1e,0x6b,0xa6,0x5d,0xba,
+    0xfd,0x68,0xe4,0xc5,0xd9,0x5f,0x31,0xc2,0xb8,0x82,0x16,0xfe,0x39,0x1f,0xdc,0xfb,
+    0xf8,0x55,0xc7,0x5a,0x4d,0xe0,0xbe,0xcb,0xc9,0xd6,0xe9,0x14,0x2f,0x3d,0xa3,0x1f,
+    0x3b,0xad,0x09,0x7e,0xef,0xf5,0x63,0xe4,0xed,0xf4,0xbf,0x7d,0x0a,0x76,0x3a,0x2d,
+    0xe7,0x5f,0xe7,0xd5,0xe5,0xcd,0xef,0x91,0xdf,0x10,0x7c,0x5e,0x23,0xec,0xf7,0xbb,
+    0x75,0x21,0xc8,0xbc,0xa6,0xd7,0xef,0x6d,0x6f,0x09,0xc0,0xd2,0x9b,0xfe,0x4f,0x0a,
+    0x43,0xe7,0x13,0xca,0xc8,0xdd,0x76,0x4d,0x30,0x3a,0x9b,0xd4,0x78,0x67,0xf6,0x7f,
+    0x28,0x5e,0x97,0x8a,0xf7,0x66,0xfd,0x4a,0x6e,0xbe,0x46,0x9a,0x8f,0x93,0xd9,0x57,
+    0xcc,0x7f,0x01,0x7c,0x7c,0xf5,0x09,0xdd,0x14,0x00,0x00
+    };
+
+static const char reso_index_html_gzip_hdr[] = "HTTP/1.1 200 OK\r\n"
+    "Content-Type: text/html\r\n"
+    "Content-Encoding: gzip\r\n"
+    "Content-Length: 1051\r\n";
+
+static const char reso_index_html_gzip_etag[] = "\"5a69e0535590ea23\"";
+static const char reso_index_html_gzip_cache_hdr[] = "ETag: \"5a69e0535590ea23\"\r\n"
+    "Vary: Accept-Encoding\r\n"
+    "Cache-Control: no-cache\r\n";
+
+static const RdWebServerResourceVariant reso_index_html_variants[] = {
+    RdWebServerResourceVariant("gzip", reso_index_html_gzip, sizeof(reso_index_html_gzip), reso_index_html_gzip_hdr, sizeof(reso_index_html_gzip_hdr) - 1, reso_index_html_gzip_cache_hdr, sizeof(reso_index_html_gzip_cache_hdr) - 1, reso_index_html_gzip_etag)
+    };
+
 static const uint8_t reso_xhr_js[] {
     0x2f,0x2a,0x0a,0x43,0x6f,0x70,0x79,0x72,0x69,0x67,0x68,0x74,0x20,0x28,0x63,0x29,
     0x20,0x32,0x30,0x31,0x37,0x20,0x45,0x74,0x68,0x61,0x6e,0x20,0x44,0x61,0x76,0x69,
@@ -499,12 +627,117 @@ static const uint8_t reso_xhr_js[] {
     0x2c,0x20,0x6e,0x75,0x6c,0x6c,0x29,0x3b,0x0a,0x09,0x7d,0x0a,0x7d,0x3b,0x0a
     };
 
+static const char reso_xhr_js_hdr[] = "HTTP/1.1 200 OK\r\n"
+    "Content-Type: text/plain\r\n"
+    "Content-Length: 2159\r\n";
+
+static const char reso_xhr_js_etag[] = "\"dad7397f1e009d1e\"";
+static const char reso_xhr_js_cache_hdr[] = "ETag: \"dad7397f1e009d1e\"\r\n"
+    "Vary: Accept-Encoding\r\n"
+    "Cache-Control: no-cache\r\n";
+
+static const uint8_t reso_xhr_js_gzip[] {
+    0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x6d,0x55,0x5d,0x6f,0xe3,0x36,
+    0x10,0x7c,0x8e,0x7f,0xc5,0x56,0x2f,0x95,0xef,0x04,0x25,0x2d,0x0a,0x14,0x48,0x1a,
+    0x14,0x8a,0x2d,0xc7,0x42,0x65,0xc9,0x90,0xe4,0x7c,0xe0,0x70,0x0f,0xb2,0x44,0x5b,
+    0xbc,0xca,0xa2,0x4b,0x52,0xf1,0x19,0x77,0xf9,0xef,0xdd,0xa5,0xe4,0xd8,0x0e,0x02,
+    0x24,0x71,0xc8,0x9d,0x9d,0x99,0x5d,0x2e,0xe9,0xcb,0x4f,0x83,0x91,0xd8,0xee,0x25,
+    0x5f,0x57,0x1a,0xec,0x62,0x08,0xbf,0x5f,0xfd,0xf6,0x27,0xf8,0xba,0xca,0x1b,0x18,
+    0xe7,0x2f,0x5c,0x0d,0x06,0x73,0x26,0x37,0x5c,0x29,0x2e,0x1a,0xe0,0x0a,0x2a,0x26,
+    0xd9,0x72,0x0f,0x6b,0x99,0x37,0x9a,0x95,0x0e,0xac,0x24,0x63,0x20,0x56,0x50,0x54,
+    0xb9,0x5c,0x33,0x07,0xb4,0x80,0xbc,0xd9,0xc3,0x96,0x49,0x85,0x09,0x62,0xa9,0x73,
+    0xde,0xf0,0x66,0x0d,0x39,0x14,0xa8,0x43,0x48,0x5d,0x21,0x8d,0x12,0x2b,0xbd,0xcb,
+    0x25,0x43,0x70,0x09,0xb9,0x52,0xa2,0xe0,0x39,0xf2,0x41,0x29,0x8a,0x76,0xc3,0x1a,
+    0x9d,0x6b,0xd2,0x5b,0xf1,0x9a,0x29,0xb0,0x75,0xc5,0xc0,0x4a,0xfb,0x0c,0x6b,0x68,
+    0x44,0x4a,0x96,0xd7,0xc0,0x1b,0xa0,0xd8,0x21,0x04,0x3b,0xae,0x2b,0xd1,0x6a,0x90,
+    0x4c,0x69,0xc9,0x0b,0xe2,0x70,0x10,0x54,0xd4,0x6d,0x49,0x1e,0x0e,0xe1,0x9a,0x6f,
+    0x78,0xaf,0x40,0xe9,0xa6,0x78,0x45,0xa4,0xad,0xc2,0x0a,0xc8,0xa7,0x03,0x1b,0x51,
+    0xf2,0x15,0x7d,0x32,0x53,0xd6,0xb6,0x5d,0xd6,0x5c,0x55,0x0e,0x94,0x9c,0xa8,0x97,
+    0xad,0xc6,0x4d,0x45,0x9b,0x05,0x6b,0x28,0x0b,0xeb,0xb8,0x14,0x12,0x14,0xab,0x6b,
+    0x62,0xe0,0xe8,0xdb,0xd4,0x7a,0x74,0x67,0x30,0xa4,0xb2,0xa5,0x86,0xea,0xbe,0x45,
+    0x46,0x77,0x57,0x89,0xcd,0x79,0x25,0xd8,0xa2,0x55,0x2b,0x1b,0x94,0x64,0x26,0xa7,
+    0x14,0xd8,0x32,0xa3,0xf8,0x8d,0x15,0x9a,0x76,0x08,0xbe,0x12,0x75,0x2d,0x76,0x54,
+    0x5a,0x21,0x9a,0x92,0x53,0x45,0xea,0x7a,0x30,0xc8,0x30,0x94,0x2f,0xc5,0x0b,0x33,
+    0xb5,0x74,0x67,0xdb,0x08,0x8d,0x56,0x3b,0x0b,0x74,0x00,0xdb,0xe3,0xa9,0xf6,0x21,
+    0x55,0xe5,0xe8,0x7d,0xc9,0xfa,0x86,0xa1,0x2e,0xb6,0x37,0x3f,0x29,0x47,0x92,0xbc,
+    0xd2,0x78,0xf0,0x1c,0x7b,0xbf,0x15,0xd2,0xe8,0xbd,0x2f,0xd3,0x45,0xfd,0xa9,0x0f,
+    0x69,0x3c,0xc9,0x1e,0xbd,0xc4,0x87,0x20,0x85,0x79,0x12,0x3f,0x04,0x63,0x7f,0x0c,
+    0x96,0x97,0xe2,0xda,0x72,0xe0,0x31,0xc8,0xa6,0xf1,0x22,0x03,0x44,0x24,0x5e,0x94,
+    0x3d,0x43,0x3c,0x01,0x2f,0x7a,0x86,0x7f,0x82,0x68,0xec,0x80,0xff,0x34,0x4f,0xfc,
+    0x34,0x85,0x38,0x81,0x60,0x36,0x0f,0x03,0x1f,0xf7,0x82,0x68,0x14,0x2e,0xc6,0x41,
+    0x74,0x0f,0x77,0x98,0x17,0xc5,0x19,0x84,0xc1,0x2c,0xc8,0x90,0x34,0x8b,0x81,0x04,
+    0x7b,0xaa,0xc0,0x4f,0x89,0x6c,0xe6,0x27,0xa3,0x29,0x2e,0xbd,0xbb,0x20,0x0c,0xb2,
+    0x67,0x07,0x26,0x41,0x16,0x11,0xe7,0x04,0x49,0x3d,0x98,0x7b,0x49,0x16,0x8c,0x16,
+    0xa1,0x97,0xc0,0x7c,0x91,0xcc,0xe3,0xd4,0x47,0xf9,0x31,0xd2,0x46,0x41,0x34,0x49,
+    0x50,0xc5,0x9f,0xf9,0x51,0xe6,0xa2,0x2a,0xee,0x81,0xff,0x80,0x0b,0x48,0xa7,0x5e,
+    0x18,0x1a,0x29,0x6f,0x81,0xee,0x13,0xe3,0x6f,0x14,0xcf,0x9f,0x93,0xe0,0x7e,0x9a,
+    0xc1,0x34,0x0e,0xc7,0x3e,0x6e,0xde,0xf9,0xe8,0xcc,0xbb,0x0b,0xfd,0x4e,0x0a,0x8b,
+    0x1a,0x85,0x5e,0x30,0x73,0x60,0xec,0xcd,0xbc,0x7b,0xdf,0x64,0xc5,0xc8,0x92,0x18,
+    0x58,0xef,0xee,0x71,0xea,0x9b,0x2d,0xd4,0xf3,0xf0,0x67,0x94,0x05,0x71,0x44,0x65,
+    0x8c,0xe2,0x28,0x4b,0x70,0xe9,0x60,0x95,0x49,0xf6,0x96,0xfa,0x18,0xa4,0xbe,0x03,
+    0x5e,0x12,0xa4,0xd4,0x90,0x49,0x12,0x23,0x3d,0xb5,0x13,0x33,0x62,0x43,0x82,0x79,
+    0x91,0xdf,0xb1,0x50,0xab,0xe1,0xec,0x44,0x10,0x42,0xeb,0x45,0xea,0x1f,0xbd,0x8c,
+    0x7d,0x2f,0x44,0xae,0x94,0x92,0x4f,0xc1,0xee,0xe0,0xd3,0xe5,0x60,0x70,0x79,0x09,
+    0x16,0xde,0x0d,0xe8,0x6e,0x95,0x75,0x03,0x21,0xd3,0xbf,0x2a,0x1a,0x1c,0xba,0x32,
+    0xdd,0x40,0xe1,0xb0,0x6c,0xa5,0x28,0x5b,0x73,0xeb,0x40,0x71,0xcd,0x94,0xeb,0xe2,
+    0x30,0xbc,0xe4,0x12,0xf2,0x6f,0xf9,0x77,0xb8,0xc5,0x89,0x6e,0x4c,0xd4,0x2e,0xd9,
+    0x8a,0x37,0xac,0x8c,0xb7,0x66,0x82,0xf0,0xca,0x2d,0x87,0xf0,0x63,0x70,0xa1,0xe5,
+    0x9e,0x3e,0x2e,0x50,0xee,0x21,0xaf,0x79,0x89,0x2f,0x02,0xd2,0x6e,0x5b,0xad,0x70,
+    0x93,0xaf,0xc0,0xfe,0xe5,0x3c,0xd1,0xad,0x72,0x15,0xef,0x9a,0xb9,0x14,0x38,0xcd,
+    0x7a,0x6f,0x5b,0xad,0xac,0xad,0xe1,0x10,0xfd,0x48,0xb1,0x03,0x6b,0x46,0xf3,0x8d,
+    0x77,0x43,0xb2,0xff,0x5a,0x2e,0x71,0x9e,0x85,0x49,0xbb,0x06,0x82,0xdd,0x0c,0x90,
+    0x93,0xbc,0x75,0x9b,0x0a,0xed,0x91,0xf4,0x85,0xb5,0x61,0xf8,0x48,0x94,0xd6,0x35,
+    0xbc,0x73,0xe9,0x76,0x01,0xf8,0xf9,0x13,0xac,0x7b,0x3f,0xc3,0x67,0xc8,0xc0,0x89,
+    0xeb,0x1a,0xde,0x41,0x71,0xb3,0x8b,0x62,0x09,0xf9,0x07,0x54,0xb4,0x4d,0x44,0x4d,
+    0x5b,0xd7,0x3d,0x4f,0xc5,0xf2,0x12,0x1f,0x84,0x0f,0xc0,0x7d,0x84,0xf0,0x3f,0x5e,
+    0x87,0x08,0x7e,0x7d,0xf3,0x4e,0x95,0xe1,0x53,0x87,0xde,0x1b,0xb6,0xb3,0x9f,0x66,
+    0xe1,0x54,0xeb,0x6d,0xd2,0x6f,0x22,0xde,0xc3,0x76,0xbf,0xb0,0xa7,0xd8,0x3c,0x1a,
+    0x43,0x1b,0x3b,0x52,0x48,0x41,0x4f,0xaf,0x4b,0xd8,0x2c,0x9b,0x5b,0xc3,0x1b,0xa4,
+    0xea,0x69,0x5c,0x6c,0x63,0x63,0x8b,0xb3,0x72,0x9d,0x43,0x7f,0x4c,0x4d,0xa0,0x65,
+    0xcb,0x86,0x46,0x1e,0xcf,0x28,0x65,0xfa,0xcd,0x41,0x6f,0xb2,0xf7,0xd5,0xad,0xa2,
+    0x7c,0xc3,0xa8,0xaf,0x9d,0xbc,0xfb,0x2f,0xdb,0xab,0x37,0xf6,0x1e,0x6f,0xe4,0x57,
+    0xf8,0xb2,0xd8,0x94,0xc6,0x11,0x7c,0x75,0x83,0x1f,0x7f,0x9d,0x32,0xb8,0x35,0x6b,
+    0xd6,0xba,0xc2,0xfd,0xcf,0x9f,0x87,0xdd,0x21,0x1d,0x0c,0x2b,0xa6,0xfb,0x6a,0xa7,
+    0x06,0x6f,0x9f,0xa4,0x7d,0xe1,0x5f,0x8f,0xe6,0x7b,0xb9,0x2f,0xe7,0xf1,0xaf,0x46,
+    0xfe,0x75,0x70,0xda,0x82,0x46,0x22,0x64,0x8f,0xaf,0x9c,0x66,0xf8,0x95,0xd6,0xac,
+    0xd9,0xe9,0xdc,0xf6,0xf2,0x34,0x8a,0x87,0x04,0x03,0x4f,0x09,0x0e,0xb7,0xb7,0xb7,
+    0xf0,0x47,0x0f,0x39,0xc3,0x10,0x5b,0xab,0x4c,0xfc,0xea,0x10,0xbf,0x28,0x96,0xb6,
+    0xe5,0x4b,0x69,0xbe,0x33,0x9a,0xf2,0x30,0xa7,0x04,0x87,0xb4,0xc3,0x5f,0xb9,0xf8,
+    0x52,0xd2,0x88,0x38,0x87,0x90,0xf1,0x4b,0x8e,0xe9,0x2f,0xab,0xf1,0xea,0x1d,0xc9,
+    0xce,0x80,0x68,0x4b,0x6d,0xb1,0x70,0x96,0xb1,0xef,0xfa,0xc3,0xf4,0xd7,0x41,0xf7,
+    0x7b,0x6c,0x65,0x53,0xda,0x6f,0xc7,0x63,0x06,0xf4,0x6f,0x38,0x5d,0xba,0x5a,0xa4,
+    0x78,0xfd,0x9b,0x35,0x76,0xe1,0xba,0x9b,0x5c,0xe2,0x43,0x8e,0x22,0xd7,0x45,0x05,
+    0x36,0x93,0xb2,0x2b,0x0e,0xcd,0xe0,0xff,0x07,0xeb,0x06,0x69,0x80,0x38,0xb7,0xff,
+    0x03,0x94,0x70,0x20,0xa5,0x6f,0x08,0x00,0x00
+    };
+
+static const char reso_xhr_js_gzip_hdr[] = "HTTP/1.1 200 OK\r\n"
+    "Content-Type: text/plain\r\n"
+    "Content-Encoding: gzip\r\n"
+    "Content-Length: 1145\r\n";
+
+static const char reso_xhr_js_gzip_etag[] = "\"2757f7b239b69023\"";
+static const char reso_xhr_js_gzip_cache_hdr[] = "ETag: \"2757f7b239b69023\"\r\n"
+    "Vary: Accept-Encoding\r\n"
+    "Cache-Control: no-cache\r\n";
+
+static const RdWebServerResourceVariant reso_xhr_js_variants[] = {
+    RdWebServerResourceVariant("gzip", reso_xhr_js_gzip, sizeof(reso_xhr_js_gzip), reso_xhr_js_gzip_hdr, sizeof(reso_xhr_js_gzip_hdr) - 1, reso_xhr_js_gzip_cache_hdr, sizeof(reso_xhr_js_gzip_cache_hdr) - 1, reso_xhr_js_gzip_etag)
+    };
+
 // Resource descriptions
 static RdWebServerResourceDescr genResources[] = {
-    RdWebServerResourceDescr("favicon.ico", "image/ico", reso_favicon_ico, sizeof(reso_favicon_ico)),
-    RdWebServerResourceDescr("index.html", "text/html", reso_index_html, sizeof(reso_index_html)),
-    RdWebServerResourceDescr("xhr.js", "text/plain", reso_xhr_js, sizeof(reso_xhr_js))
+    RdWebServerResourceDescr("favicon.ico", "image/ico", reso_favicon_ico, sizeof(reso_favicon_ico), reso_favicon_ico_hdr, sizeof(reso_favicon_ico_hdr) - 1, reso_favicon_ico_cache_hdr, sizeof(reso_favicon_ico_cache_hdr) - 1, reso_favicon_ico_etag, reso_favicon_ico_variants, 1),
+    RdWebServerResourceDescr("index.html", "text/html", reso_index_html, sizeof(reso_index_html), reso_index_html_hdr, sizeof(reso_index_html_hdr) - 1, reso_index_html_cache_hdr, sizeof(reso_index_html_cache_hdr) - 1, reso_index_html_etag, reso_index_html_variants, 1),
+    RdWebServerResourceDescr("xhr.js", "text/plain", reso_xhr_js, sizeof(reso_xhr_js), reso_xhr_js_hdr, sizeof(reso_xhr_js_hdr) - 1, reso_xhr_js_cache_hdr, sizeof(reso_xhr_js_cache_hdr) - 1, reso_xhr_js_etag, reso_xhr_js_variants, 1)
     };
 
 static int genResourcesCount = sizeof(genResources) / sizeof(RdWebServerResourceDescr);
 
+// Resource index (perfect hash of lowercased names)
+static const int16_t genResourcesIndexSlots[] = {
+    -1, 2, -1, 0, -1, 1
+    };
+
+static const RdWebServerResourceIndex genResourcesIndex(3UL, 6, genResourcesIndexSlots);
+
@@ -1,12 +1,15 @@
 #include "Particle.h"
 #include "LocalServer.h"
 #include "RestAPIEndpoints.h"
-#include "RdJson.h"
 #include <functional>
 
-LocalServer::LocalServer() {
+LocalServer::LocalServer() : _postDoc(_postTokens, MAX_POST_TOKENS) {
     _token = "";
     _tokenTime = 0;
+    _openTime = "7:15";
+    _reminderTime = "20:15";
+    _settingsClientIdx = -1;
+    _settingsLastRxMs = 0;
 }
 
 void LocalServer::setup() {
@@ -20,10 +23,16 @@ void LocalServer::setup() {
     }
 
     // Add endpoint
-    _restAPIEndpoints.addEndpoint("postLogin", RestAPIEndpointDef::ENDPOINT_CALLBACK, std::bind(&LocalServer::restAPI_PostLogin, this, _1, _2), "");
-    _restAPIEndpoints.addEndpoint("postChangePassword", RestAPIEndpointDef::ENDPOINT_CALLBACK, std::bind(&LocalServer::restAPI_PostChangePassword, this, _1, _2), "");
-    _restAPIEndpoints.addEndpoint("postSettings", RestAPIEndpointDef::ENDPOINT_CALLBACK, std::bind(&LocalServer::restAPI_PostSettings, this, _1, _2), "");
-    _restAPIEndpoints.addEndpoint("getSettings", RestAPIEndpointDef::ENDPOINT_CALLBACK, std::bind(&LocalServer::restAPI_GetSettings, this, _1, _2), "");
+    _restAPIEndpoints.addEndpoint("postLogin", RestAPIEndpointDef::ENDPOINT_CALLBACK, std::bind(&LocalServer::restAPI_PostLogin, this, _1, _2), "",
+                                  RestAPIEndpointDef::METHOD_MASK_POST);
+    _restAPIEndpoints.addEndpoint("postChangePassword", RestAPIEndpointDef::ENDPOINT_CALLBACK, std::bind(&LocalServer::restAPI_PostChangePassword, this, _1, _2), "",
+                                  RestAPIEndpointDef::METHOD_MASK_POST);
+    _restAPIEndpoints.addUploadEndpoint("postSettings", std::bind(&LocalServer::restAPI_PostSettingsBody, this, _1),
+                                        std::bind(&LocalServer::restAPI_PostSettings, this, _1, _2), "",
+                                        RestAPIEndpointDef::METHOD_MASK_POST);
+    _settingsParser.setCallback(std::bind(&LocalServer::_onSettingsValue, this, _1, _2, _3, _4, _5));
+    _restAPIEndpoints.addEndpoint("getSettings", RestAPIEndpointDef::ENDPOINT_CALLBACK, std::bind(&LocalServer::restAPI_GetSettings, this, _1, _2), "",
+                                  RestAPIEndpointDef::METHOD_MASK_GET);
 
     // Construct server
     _webServer = new RdWebServer();
@@ -31,10 +40,11 @@ void LocalServer::setup() {
     // Configure web server
     if (_webServer) {
         // Add resources to web server
-        _webServer->addStaticResources(genResources, genResourcesCount);
+        _webServer->addStaticResources(genResources, genResourcesCount, &genResourcesIndex);
 
         // Endpoints
         _webServer->addRestAPIEndpoints(&_restAPIEndpoints);
+        _webServer->enableMetricsEndpoint("metrics");
 
         // Start the web server
         _webServer->start(80);
@@ -48,12 +58,14 @@ void LocalServer::service() {
 }
 
 void LocalServer::restAPI_PostLogin(RestAPIEndpointMsg& apiMsg, String& retStr) {
-    String postStr = (const char *)apiMsg._pMsgContent;
-    String passwordString = RdJson::getString("password", "", postStr.c_str());
+    // Fields are unescaped into buffers here rather than copied to Strings
+    char passwordStr[MAX_POSTED_FIELD_LEN];
+    _postDoc.parse((const char *)apiMsg._pMsgContent, apiMsg._msgContentLen);
+    bool passwordValid = _postDoc.getUnescaped("password", passwordStr, sizeof(passwordStr)) >= 0;
     String localPassword = _getPassword();
-    Serial.print("passwordString: ");Serial.println(passwordString);
+    Serial.print("passwordString: ");Serial.println(passwordValid ? passwordStr : "");
     Serial.print("localPassword: ");Serial.println(localPassword);
-    if (passwordString == localPassword) {
+    if (passwordValid && (localPassword == passwordStr)) {
         // authorized
         _token = _generateToken();
         _tokenTime = millis();
@@ -70,16 +82,17 @@ void LocalServer::restAPI_PostChangePassword(RestAPIEndpointMsg& apiMsg, String&
         return;
     }
 
-    String postStr = (const char *)apiMsg._pMsgContent;
-
-    String oldPasswordString = RdJson::getString("oldPassword", "", postStr.c_str());
-    String newPasswordString = RdJson::getString("newPassword", "", postStr.c_str());
+    char oldPasswordStr[MAX_POSTED_FIELD_LEN];
+    char newPasswordStr[MAX_POSTED_FIELD_LEN];
+    _postDoc.parse((const char *)apiMsg._pMsgContent, apiMsg._msgContentLen);
+    bool passwordsValid = (_postDoc.getUnescaped("oldPassword", oldPasswordStr, sizeof(oldPasswordStr)) >= 0) &&
+                          (_postDoc.getUnescaped("newPassword", newPasswordStr, sizeof(newPasswordStr)) >= 0);
     String localPassword = _getPassword();
-    Serial.print("oldPasswordString: ");Serial.println(oldPasswordString);
-    Serial.print("newPasswordString: ");Serial.println(newPasswordString);
+    Serial.print("oldPasswordString: ");Serial.println(passwordsValid ? oldPasswordStr : "");
+    Serial.print("newPasswordString: ");Serial.println(passwordsValid ? newPasswordStr : "");
     Serial.print("localPassword: ");Serial.println(localPassword);
-    if (oldPasswordString == localPassword) {
-        _savePassword(newPasswordString);
+    if (passwordsValid && (localPassword == oldPasswordStr)) {
+        _savePassword(newPasswordStr);
         _tokenTime = millis();
 
         retStr = "{\"status\":\"ok\"}";
@@ -88,12 +101,66 @@ void LocalServer::restAPI_PostChangePassword(RestAPIEndpointMsg& apiMsg, String&
     }
 }
 
+// Each part of the posted settings is parsed as it is received so the settings don't need
+// to fit in the receive buffer - bodies from other connections arrive interleaved so only
+// the authorised request which started first is parsed and others are discarded
+int LocalServer::restAPI_PostSettingsBody(RestAPIEndpointMsg& apiMsg) {
+    if (apiMsg._contentPos == 0) {
+        // A new request on the owner's client means the owner's request has gone
+        if ((_settingsClientIdx == apiMsg._clientIdx) || (millis() - _settingsLastRxMs > SETTINGS_BODY_TIMEOUT_MS)) {
+            _settingsClientIdx = -1;
+        }
+        if ((_settingsClientIdx < 0) && _isTokenExistedAndValid((char*)apiMsg._pMsgHeader)) {
+            _settingsClientIdx = apiMsg._clientIdx;
+            _settingsParser.reset();
+            _pendingOpenTime = _openTime;
+            _pendingReminderTime = _reminderTime;
+        }
+    }
+    if ((_settingsClientIdx >= 0) && (_settingsClientIdx == apiMsg._clientIdx)) {
+        _settingsLastRxMs = millis();
+        _settingsParser.feed((const char *)apiMsg._pMsgContent, apiMsg._msgContentLen);
+    }
+    return apiMsg._msgContentLen;
+}
+
+bool LocalServer::_onSettingsValue(RdJsonStreamParser::Event event, const char* pPath, jsmnrtype_t type,
+                                   const char* pValue, int valueLen) {
+    if ((event != RdJsonStreamParser::EVENT_VALUE) || (type != JSMNR_STRING)) {
+        return true;
+    }
+    if (strcmp(pPath, "openTime") == 0) {
+        _pendingOpenTime = pValue;
+    } else if (strcmp(pPath, "reminderTime") == 0) {
+        _pendingReminderTime = pValue;
+    }
+    return true;
+}
+
 void LocalServer::restAPI_PostSettings(RestAPIEndpointMsg& apiMsg, String& retStr) {
     Serial.println(apiMsg._pMsgHeader);
+    // Only the request which owns the parser finishes it and releases it
+    bool ownsSettings = (_settingsClientIdx >= 0) && (_settingsClientIdx == apiMsg._clientIdx);
+    bool settingsValid = ownsSettings && _settingsParser.finish();
+    if (ownsSettings) {
+        _settingsParser.reset();
+        _settingsClientIdx = -1;
+    }
     if (!_isTokenExistedAndValid((char*)apiMsg._pMsgHeader)) {
         retStr = "{\"status\":\"unauthorized\"}";
         return;
     }
+    // Another request's settings are being received
+    if (!ownsSettings && (_settingsClientIdx >= 0)) {
+        retStr = "{\"status\":\"busy\"}";
+        return;
+    }
+    if (!settingsValid) {
+        retStr = "{\"status\":\"invalid\"}";
+        return;
+    }
+    _openTime = _pendingOpenTime;
+    _reminderTime = _pendingReminderTime;
 
     _tokenTime = millis();
     retStr = "{\"status\":\"ok\"}";
@@ -108,8 +175,11 @@ void LocalServer::restAPI_GetSettings(RestAPIEndpointMsg& apiMsg, String& retStr
     }
 
     _tokenTime = millis();
-    String configStr = "{\"openTime\":\"7:15\", \"reminderTime\":\"20:15\"}";
-    retStr = configStr;
+    String openTime = _openTime;
+    String reminderTime = _reminderTime;
+    RdJson::escapeString(openTime);
+    RdJson::escapeString(reminderTime);
+    retStr = "{\"openTime\":\"" + openTime + "\", \"reminderTime\":\"" + reminderTime + "\"}";
 }
 
 String LocalServer::_generateToken() {
@@ -156,19 +226,21 @@ void LocalServer::_savePassword(String passwordString) {
     EEPROM.put(0, password);
 }
 
+// The header isn't modified as it is checked more than once for a request (when its body
+// starts and when it is complete)
 String LocalServer::_getTokenFromHeader(char* headerString) {
-    char* line = strtok(headerString, "\n");
-    while (line != 0) {
-        char* separator = strchr(line, ':');
-        if (separator != 0) {
-            *separator = 0;
-
-            if (strcmp(line, "X-Token") == 0) {
-                ++separator;
-                return String(separator).trim();
-            }
+    const char* tokenName = "X-Token:";
+    int tokenNameLen = strlen(tokenName);
+    const char* line = headerString;
+    while (*line) {
+        const char* lineEnd = strchr(line, '\n');
+        if (lineEnd == 0) {
+            lineEnd = line + strlen(line);
+        }
+        if (strncmp(line, tokenName, tokenNameLen) == 0) {
+            return String(line).substring(tokenNameLen, lineEnd - line).trim();
         }
-        line = strtok(0, "\n");
+        line = (*lineEnd == '\n') ? lineEnd + 1 : lineEnd;
     }
 
     return "";
@@ -2,6 +2,8 @@
 
 #include "RdWebServer.h"
 #include "GenResources.h"
+#include "RdJsonDocument.h"
+#include "RdJsonStreamParser.h"
 
 class LocalServer {
 
@@ -17,6 +19,28 @@ class LocalServer {
         String _token;
         unsigned long _tokenTime;
 
+        // Posted JSON is parsed once into this arena (declared before the document using it)
+        static const int MAX_POST_TOKENS = 16;
+        jsmnrtok_t _postTokens[MAX_POST_TOKENS];
+        RdJsonDocument _postDoc;
+
+        // Longest field (including the terminator) read from posted JSON
+        static const int MAX_POSTED_FIELD_LEN = 64;
+
+        // Settings - posted settings are parsed as they arrive and applied when complete - one
+        // authorised request at a time (the web client it is on, or -1) owns the parser
+        String _openTime;
+        String _reminderTime;
+        RdJsonStreamParser _settingsParser;
+        String _pendingOpenTime;
+        String _pendingReminderTime;
+        int _settingsClientIdx;
+        unsigned long _settingsLastRxMs;
+        // The owner is released if its body stops arriving (e.g. the connection dropped)
+        static const unsigned long SETTINGS_BODY_TIMEOUT_MS = 10000;
+        bool _onSettingsValue(RdJsonStreamParser::Event event, const char* pPath, jsmnrtype_t type,
+                              const char* pValue, int valueLen);
+
         String _generateToken();
         bool _isTokenValid(String token);
         bool _isTokenExpired();
@@ -25,6 +49,7 @@ class LocalServer {
 
         void restAPI_PostLogin(RestAPIEndpointMsg& apiMsg, String& retStr);
         void restAPI_PostChangePassword(RestAPIEndpointMsg& apiMsg, String& retStr);
+        int restAPI_PostSettingsBody(RestAPIEndpointMsg& apiMsg);
         void restAPI_PostSettings(RestAPIEndpointMsg& apiMsg, String& retStr);
         void restAPI_GetSettings(RestAPIEndpointMsg& apiMsg, String& retStr);
 